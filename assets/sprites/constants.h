@@ -0,0 +1,9 @@
+#ifndef SPRITES_CONSTANTS_H
+#define SPRITES_CONSTANTS_H
+
+#define SPRITE_DEFAULT_SCALE 0.5f
+#define SPRITE_NEAR_PLANE 1.0f
+// Extra angle past the FOV edge so wide sprites are not culled too early
+#define SPRITE_CULL_MARGIN_DEG 15.0f
+
+#endif
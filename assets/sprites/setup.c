@@ -0,0 +1,237 @@
+#include "./setup.h"
+
+static bool reserve_sprite_draw_list(Sprite_Draw_List *draw_list,
+                                     size_t            capacity);
+
+extern Sprite_Entities_Container *create_sprite_entities_from_grid(
+    const Jagged_Grid             *grid,
+    const World_Objects_Container *world_objects_container) {
+  Sprite_Entities_Container *container =
+      calloc(1, sizeof(Sprite_Entities_Container));
+  if (!container) {
+    return NULL;
+  }
+
+  // A level without an entity layer simply has no sprites
+  if (!grid || !world_objects_container) {
+    return container;
+  }
+
+  for (size_t y = 0; y < grid->length; y++) {
+    const Jagged_Row *row = &grid->rows[y];
+    for (size_t x = 0; x < row->length; x++) {
+      Material_Id material =
+          find_material_id(world_objects_container, row->world_object_names[x]);
+      if (material == MATERIAL_ID_EMPTY) {
+        continue;
+      }
+
+      Sprite_Entity entity = {
+          .position.x     = (x + 0.5f) * GRID_CELL_SIZE,
+          .position.y     = (y + 0.5f) * GRID_CELL_SIZE,
+          .material       = material,
+          .scale          = SPRITE_DEFAULT_SCALE,
+          .spatial_handle = SPATIAL_HASH_NONE,
+      };
+      if (!add_sprite_entity(container, entity)) {
+        free_sprite_entities(container);
+        return NULL;
+      }
+    }
+  }
+
+  return container;
+}
+
+extern bool add_sprite_entity(Sprite_Entities_Container *container,
+                              Sprite_Entity              entity) {
+  if (container->length == container->capacity) {
+    size_t capacity = container->capacity ? container->capacity * 2 : 16;
+    Sprite_Entity *data =
+        realloc(container->data, capacity * sizeof(Sprite_Entity));
+    if (!data) {
+      return false;
+    }
+    container->data     = data;
+    container->capacity = capacity;
+  }
+
+  container->data[container->length++] = entity;
+  return true;
+}
+
+extern void free_sprite_entities(Sprite_Entities_Container *container) {
+  if (!container) {
+    return;
+  }
+
+  free(container->data);
+  free(container);
+}
+
+// Registers every sprite in the spatial hash, keyed by its container index
+extern bool index_sprite_entities(Spatial_Hash              *spatial_hash,
+                                  Sprite_Entities_Container *container) {
+  for (size_t i = 0; i < container->length; i++) {
+    Sprite_Entity *entity  = &container->data[i];
+    entity->spatial_handle = insert_spatial_entry(
+        spatial_hash, (uint32_t)i, entity->position,
+        entity->scale * GRID_CELL_SIZE / 2);
+    if (entity->spatial_handle == SPATIAL_HASH_NONE) {
+      return false;
+    }
+  }
+  return true;
+}
+
+extern Sprite_Draw_List *create_sprite_draw_list(void) {
+  return calloc(1, sizeof(Sprite_Draw_List));
+}
+
+/*
+ * Culls sprites against the view cone (only those within view_distance of the
+ * eye when a spatial hash is given, and only in cells the PVS marks visible),
+ * projects the survivors into the view and radix sorts them by perpendicular
+ * distance, nearest first. Perpendicular distance matches the wall perp_distance so it
+ * can be compared against the per column Z-buffer.
+ */
+extern size_t build_sprite_draw_list(Sprite_Draw_List                *draw_list,
+                                     const Sprite_Entities_Container *container,
+                                     const Spatial_Hash *spatial_hash,
+                                     const Potentially_Visible_Set *pvs,
+                                     Scalar view_distance, Point_2D eye,
+                                     Degrees view_angle) {
+  draw_list->length = 0;
+  if (!container || container->length == 0 ||
+      !reserve_sprite_draw_list(draw_list, container->length)) {
+    return 0;
+  }
+
+  Radians     view_rads = convert_deg_to_rads(view_angle);
+  Vector_1D   view_x    = cosf(view_rads);
+  Vector_1D   view_y    = sinf(view_rads);
+  const float half_fov  = PLAYER_FOV_DEG / 2.0f;
+  const float cull_cos =
+      cosf(convert_deg_to_rads(half_fov + SPRITE_CULL_MARGIN_DEG));
+  IPoint_1D eye_grid_x = floorf(eye.x / GRID_CELL_SIZE);
+  IPoint_1D eye_grid_y = floorf(eye.y / GRID_CELL_SIZE);
+
+  size_t candidate_length = container->length;
+  if (spatial_hash) {
+    candidate_length =
+        query_spatial_radius(spatial_hash, eye, view_distance,
+                             draw_list->candidates, container->length);
+    candidate_length = candidate_length < container->length
+                           ? candidate_length
+                           : container->length;
+  }
+
+  size_t visible_length = 0;
+  for (size_t c = 0; c < candidate_length; c++) {
+    size_t i = spatial_hash ? draw_list->candidates[c] : c;
+    const Sprite_Entity *entity = &container->data[i];
+    if (!is_cell_potentially_visible(
+            pvs, eye_grid_x, eye_grid_y,
+            floorf(entity->position.x / GRID_CELL_SIZE),
+            floorf(entity->position.y / GRID_CELL_SIZE))) {
+      continue;
+    }
+
+    Vector_1D dx = entity->position.x - eye.x;
+    Vector_1D dy = entity->position.y - eye.y;
+
+    Scalar forward = dx * view_x + dy * view_y;
+    if (forward < SPRITE_NEAR_PLANE) {
+      continue;
+    }
+    Scalar distance = sqrtf(dx * dx + dy * dy);
+    if (forward < distance * cull_cos) {
+      continue;
+    }
+
+    Scalar side         = dy * view_x - dx * view_y;
+    float  angle_offset = atan2f(side, forward) * (180.0f / M_PI);
+
+    Sprite_Projection *projection = &draw_list->unsorted[visible_length];
+    projection->entity_index      = (uint32_t)i;
+    projection->perp_distance     = forward;
+    projection->view_x            = (angle_offset + half_fov) / PLAYER_FOV_DEG;
+
+    draw_list->keys[visible_length]  = convert_float_to_sort_key(forward);
+    draw_list->order[visible_length] = (uint32_t)visible_length;
+    visible_length++;
+  }
+
+  radix_sort_by_key(draw_list->keys, draw_list->order, draw_list->tmp_keys,
+                    draw_list->tmp_order, visible_length);
+
+  for (size_t i = 0; i < visible_length; i++) {
+    draw_list->data[i] = draw_list->unsorted[draw_list->order[i]];
+  }
+  draw_list->length = visible_length;
+
+  return visible_length;
+}
+
+static bool reserve_sprite_draw_list(Sprite_Draw_List *draw_list,
+                                     size_t            capacity) {
+  if (capacity <= draw_list->capacity) {
+    return true;
+  }
+
+  Sprite_Projection *data =
+      realloc(draw_list->data, capacity * sizeof(Sprite_Projection));
+  if (data) {
+    draw_list->data = data;
+  }
+  Sprite_Projection *unsorted =
+      realloc(draw_list->unsorted, capacity * sizeof(Sprite_Projection));
+  if (unsorted) {
+    draw_list->unsorted = unsorted;
+  }
+  uint32_t *candidates =
+      realloc(draw_list->candidates, capacity * sizeof(uint32_t));
+  if (candidates) {
+    draw_list->candidates = candidates;
+  }
+  uint32_t *keys = realloc(draw_list->keys, capacity * sizeof(uint32_t));
+  if (keys) {
+    draw_list->keys = keys;
+  }
+  uint32_t *order = realloc(draw_list->order, capacity * sizeof(uint32_t));
+  if (order) {
+    draw_list->order = order;
+  }
+  uint32_t *tmp_keys =
+      realloc(draw_list->tmp_keys, capacity * sizeof(uint32_t));
+  if (tmp_keys) {
+    draw_list->tmp_keys = tmp_keys;
+  }
+  uint32_t *tmp_order =
+      realloc(draw_list->tmp_order, capacity * sizeof(uint32_t));
+  if (tmp_order) {
+    draw_list->tmp_order = tmp_order;
+  }
+
+  if (!data || !unsorted || !candidates || !keys || !order || !tmp_keys || !tmp_order) {
+    return false;
+  }
+
+  draw_list->capacity = capacity;
+  return true;
+}
+
+extern void free_sprite_draw_list(Sprite_Draw_List *draw_list) {
+  if (!draw_list) {
+    return;
+  }
+
+  free(draw_list->data);
+  free(draw_list->unsorted);
+  free(draw_list->candidates);
+  free(draw_list->keys);
+  free(draw_list->order);
+  free(draw_list->tmp_keys);
+  free(draw_list->tmp_order);
+  free(draw_list);
+}
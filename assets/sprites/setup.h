@@ -0,0 +1,27 @@
+#ifndef SPRITES_SETUP_H
+#define SPRITES_SETUP_H
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "../../config/constants.h"
+#include "../../data/grid/constants.h"
+#include "../../data/grid/pvs.h"
+#include "../../data/grid/tile-map.h"
+#include "../../data/spatial/spatial-hash.h"
+#include "../../objects/player/constants.h"
+#include "../../utils/math-utils.h"
+#include "../../utils/radix-sort.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Sprite_Entities_Container *create_sprite_entities_from_grid(const Jagged_Grid *grid, const World_Objects_Container *world_objects_container);
+extern bool add_sprite_entity(Sprite_Entities_Container *container, Sprite_Entity entity);
+extern void free_sprite_entities(Sprite_Entities_Container *container);
+extern bool index_sprite_entities(Spatial_Hash *spatial_hash, Sprite_Entities_Container *container);
+
+extern Sprite_Draw_List *create_sprite_draw_list(void);
+extern size_t build_sprite_draw_list(Sprite_Draw_List *draw_list, const Sprite_Entities_Container *container, const Spatial_Hash *spatial_hash, const Potentially_Visible_Set *pvs, Scalar view_distance, Point_2D eye, Degrees view_angle);
+extern void free_sprite_draw_list(Sprite_Draw_List *draw_list);
+
+#endif
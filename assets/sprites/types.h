@@ -1,4 +1,54 @@
 #ifndef SPRITES_TYPES_H
 #define SPRITES_TYPES_H
 
-#endif
\ No newline at end of file
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../data/grid/types.h"
+#include "../../data/spatial/types.h"
+#include "../../types/algebraic-types.h"
+
+/*
+ * A billboarded world sprite. Frames and animation come from the world object
+ * named by material, so sprites share the texture animation clocks.
+ */
+typedef struct Sprite_Entity {
+  Point_2D       position; // centre of the sprite's footprint on the floor
+  Material_Id    material;
+  Scalar         scale; // 1.0 = one grid cell tall
+  Spatial_Handle spatial_handle;
+} Sprite_Entity;
+
+typedef struct Sprite_Entities_Container {
+  Sprite_Entity *data;
+  size_t         length;
+  size_t         capacity;
+} Sprite_Entities_Container;
+
+/*
+ * Resolution independent projection, view_x runs from 0 at the left edge of
+ * the FOV to 1 at the right edge. Renderers map it to their own columns.
+ */
+typedef struct Sprite_Projection {
+  uint32_t entity_index;
+  Scalar   perp_distance;
+  Scalar   view_x; // centre
+} Sprite_Projection;
+
+/*
+ * Per frame list of visible sprites sorted nearest first. Buffers are kept
+ * between frames and only grow.
+ */
+typedef struct Sprite_Draw_List {
+  Sprite_Projection *data;
+  size_t             length;
+  size_t             capacity;
+  Sprite_Projection *unsorted;
+  uint32_t          *candidates;
+  uint32_t          *keys;
+  uint32_t          *order;
+  uint32_t          *tmp_keys;
+  uint32_t          *tmp_order;
+} Sprite_Draw_List;
+
+#endif
@@ -0,0 +1,122 @@
+#include "./animation.h"
+
+static int find_or_add_clock(Animation_Clocks *clocks, float frame_duration,
+                             int frame_count, bool is_looping);
+
+/*
+ * Every animated material with the same (frame_duration, frame_count,
+ * is_looping) shares one clock, so e.g. all water tiles stay in lockstep and
+ * the per-frame cost only depends on the number of distinct clocks.
+ */
+extern Animation_Clocks *
+create_animation_clocks(World_Objects_Container *world_objects_container) {
+  if (!world_objects_container || !world_objects_container->data) {
+    return NULL;
+  }
+
+  Animation_Clocks *clocks = calloc(1, sizeof(Animation_Clocks));
+  if (!clocks) {
+    return NULL;
+  }
+
+  size_t max_length = world_objects_container->length;
+  clocks->frame_rates            = malloc(max_length * sizeof(float));
+  clocks->frame_counts           = malloc(max_length * sizeof(int));
+  clocks->is_looping             = malloc(max_length * sizeof(int));
+  clocks->current_frame_indexes  = malloc(max_length * sizeof(int));
+  clocks->animated_objects       = malloc(max_length * sizeof(World_Object *));
+  clocks->animated_clock_indexes = malloc(max_length * sizeof(int));
+  if (!clocks->frame_rates || !clocks->frame_counts || !clocks->is_looping ||
+      !clocks->current_frame_indexes || !clocks->animated_objects ||
+      !clocks->animated_clock_indexes) {
+    free_animation_clocks(clocks);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    World_Object *world_object = world_objects_container->data[i];
+    int frame_count = (int)world_object->textures.length;
+
+    world_object->animation_state.current_frame_index = 0;
+    if (!world_object->animation_state.is_animated || frame_count <= 1 ||
+        world_object->animation_state.frame_duration <= 0) {
+      continue;
+    }
+
+    int clock_index = find_or_add_clock(
+        clocks, world_object->animation_state.frame_duration, frame_count,
+        world_object->animation_state.is_looping);
+
+    clocks->animated_objects[clocks->animated_length]       = world_object;
+    clocks->animated_clock_indexes[clocks->animated_length] = clock_index;
+    clocks->animated_length++;
+  }
+
+  return clocks;
+}
+
+static int find_or_add_clock(Animation_Clocks *clocks, float frame_duration,
+                             int frame_count, bool is_looping) {
+  float frame_rate = 1.0f / frame_duration;
+  for (size_t i = 0; i < clocks->length; i++) {
+    if (clocks->frame_rates[i] == frame_rate &&
+        clocks->frame_counts[i] == frame_count &&
+        clocks->is_looping[i] == is_looping) {
+      return (int)i;
+    }
+  }
+
+  clocks->frame_rates[clocks->length]           = frame_rate;
+  clocks->frame_counts[clocks->length]          = frame_count;
+  clocks->is_looping[clocks->length]            = is_looping;
+  clocks->current_frame_indexes[clocks->length] = 0;
+  return (int)clocks->length++;
+}
+
+/*
+ * frame = floor(t / duration) % count, derived from the absolute elapsed time
+ * rather than accumulated per frame, so there is no remainder to lose and no
+ * drift. Non looping clocks hold their last frame.
+ */
+extern void advance_animation_clocks(Animation_Clocks *clocks,
+                                     float             delta_time) {
+  if (!clocks) {
+    return;
+  }
+
+  clocks->elapsed_time += delta_time;
+
+  const double elapsed_time          = clocks->elapsed_time;
+  const float *frame_rates           = clocks->frame_rates;
+  const int   *frame_counts          = clocks->frame_counts;
+  const int   *is_looping            = clocks->is_looping;
+  int         *current_frame_indexes = clocks->current_frame_indexes;
+
+  // Branch free so the compiler can vectorize it
+  for (size_t i = 0; i < clocks->length; i++) {
+    int64_t frame      = (int64_t)(elapsed_time * frame_rates[i]);
+    int     looped     = (int)(frame % frame_counts[i]);
+    int     last_frame = frame_counts[i] - 1;
+    int     clamped    = frame < last_frame ? (int)frame : last_frame;
+    current_frame_indexes[i] = is_looping[i] ? looped : clamped;
+  }
+
+  for (size_t i = 0; i < clocks->animated_length; i++) {
+    clocks->animated_objects[i]->animation_state.current_frame_index =
+        current_frame_indexes[clocks->animated_clock_indexes[i]];
+  }
+}
+
+extern void free_animation_clocks(Animation_Clocks *clocks) {
+  if (!clocks) {
+    return;
+  }
+
+  free(clocks->frame_rates);
+  free(clocks->frame_counts);
+  free(clocks->is_looping);
+  free(clocks->current_frame_indexes);
+  free(clocks->animated_objects);
+  free(clocks->animated_clock_indexes);
+  free(clocks);
+}
@@ -0,0 +1,14 @@
+#ifndef TEXTURES_ANIMATION_H
+#define TEXTURES_ANIMATION_H
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "./types.h"
+
+extern Animation_Clocks *create_animation_clocks(World_Objects_Container *world_objects_container);
+extern void advance_animation_clocks(Animation_Clocks *clocks, float delta_time);
+extern void free_animation_clocks(Animation_Clocks *clocks);
+
+#endif
@@ -5,4 +5,9 @@
 #define TEXTURE_PIXEL_W 64
 #define TEXTURE_PIXEL_H 64
 
+// Manifest surface_type / collision_mode bits
+#define COLLISION_MODE_FLOOR (1 << 0)
+#define COLLISION_MODE_WALL (1 << 1)
+#define COLLISION_MODE_CEILING (1 << 2)
+
 #endif
\ No newline at end of file
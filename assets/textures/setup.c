@@ -1,5 +1,6 @@
 #include "./setup.h"
 
+// Pass a NULL renderer to load only the surfaces, without a GPU or window
 extern World_Objects_Container *
 setup_engine_textures(SDL_Renderer *renderer, char *root_manifest_file) {
   const char *manifest_json_string =
@@ -125,10 +126,18 @@ bool parse_frame_src_files(World_Object *world_object,
   }
   world_object->textures.length = frame_count;
 
+  // Allocate array of SDL_Surface pointers
+  world_object->surfaces.data = malloc(frame_count * sizeof(SDL_Surface *));
+  if (!world_object->surfaces.data) {
+    return false;
+  }
+  world_object->surfaces.length = frame_count;
+
   // Initialize all pointers to NULL for safe cleanup
   for (int i = 0; i < frame_count; i++) {
     world_object->frame_src_files.data[i] = NULL;
     world_object->textures.data[i]        = NULL;
+    world_object->surfaces.data[i]        = NULL;
   }
 
   // Parse each frame source file
@@ -154,9 +163,12 @@ bool parse_frame_src_files(World_Object *world_object,
 
 bool parse_texture_fields(World_Object *world_object,
                           const cJSON  *json_object) {
-  world_object->name          = NULL;
-  world_object->src_directory = NULL;
-  world_object->category      = NULL;
+  world_object->name                 = NULL;
+  world_object->src_directory        = NULL;
+  world_object->category             = NULL;
+  world_object->frame_src_files.data = NULL;
+  world_object->textures.data        = NULL;
+  world_object->surfaces.data        = NULL;
 
   // Parse name
   cJSON *name = cJSON_GetObjectItemCaseSensitive(json_object, "name");
@@ -254,20 +266,30 @@ bool parse_texture_fields(World_Object *world_object,
   }
   world_object->use_scale_mode_nearest = cJSON_IsTrue(scale_mode);
 
+  // Optional, translucent / alpha keyed walls let rays continue through them
+  cJSON *is_translucent =
+      cJSON_GetObjectItemCaseSensitive(json_object, "is_translucent");
+  if (is_translucent && !cJSON_IsBool(is_translucent)) {
+    return false;
+  }
+  world_object->is_translucent = cJSON_IsTrue(is_translucent);
+
   // Initialize other fields
   world_object->animation_state.current_frame_index = 0;
-  world_object->animation_state.frame_elapsed_time  = 0;
   world_object->animation_state.max_frame_index =
       world_object->textures.length - 1;
 
   return true;
 }
 
+/*
+ * Loads every frame as an RGBA32 surface, which is all the CPU renderers need.
+ * With a renderer the GPU textures are created as well, NULL stays headless.
+ */
 bool process_world_objects(
     SDL_Renderer            *renderer,
     World_Objects_Container *out_world_objects_container) {
-  if (!renderer || !out_world_objects_container ||
-      !out_world_objects_container->data) {
+  if (!out_world_objects_container || !out_world_objects_container->data) {
     return false;
   }
 
@@ -292,20 +314,61 @@ bool process_world_objects(
         return false;
       }
 
-      SDL_Texture *temp_texture =
-          SDL_CreateTextureFromSurface(renderer, temp_surface);
+      // Any size renders, but the CPU path only has fast kernels for some
+      if (temp_surface->w !=
+              out_world_objects_container->data[i]->expected_pixel_width ||
+          temp_surface->h !=
+              out_world_objects_container->data[i]->expected_pixel_height) {
+        fprintf(stderr, "Warning: %s is %dx%d, manifest expects %dx%d\n",
+                temp_path, temp_surface->w, temp_surface->h,
+                out_world_objects_container->data[i]->expected_pixel_width,
+                out_world_objects_container->data[i]->expected_pixel_height);
+      }
+
+      SDL_Surface *rgba_surface =
+          SDL_ConvertSurface(temp_surface, SDL_PIXELFORMAT_RGBA32);
       SDL_DestroySurface(temp_surface);
 
-      if (!temp_texture) {
-        fprintf(stderr, "Failed to create texture from %s: %s\n", temp_path,
+      if (!rgba_surface) {
+        fprintf(stderr, "Failed to convert %s to RGBA32: %s\n", temp_path,
                 SDL_GetError());
         return false;
       }
+      out_world_objects_container->data[i]->surfaces.data[j] = rgba_surface;
+    }
+  }
+
+  return !renderer || create_world_object_textures(
+                          renderer, out_world_objects_container);
+}
+
+// GPU textures from the loaded surfaces, for the SDL_Renderer draw path
+bool create_world_object_textures(
+    SDL_Renderer            *renderer,
+    World_Objects_Container *world_objects_container) {
+  if (!renderer || !world_objects_container ||
+      !world_objects_container->data) {
+    return false;
+  }
+
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    World_Object *world_object = world_objects_container->data[i];
+    for (size_t j = 0; j < world_object->surfaces.length; j++) {
+      if (world_object->textures.data[j]) {
+        continue;
+      }
+
+      SDL_Texture *temp_texture = SDL_CreateTextureFromSurface(
+          renderer, world_object->surfaces.data[j]);
+      if (!temp_texture) {
+        fprintf(stderr, "Failed to create texture for %s: %s\n",
+                world_object->name, SDL_GetError());
+        return false;
+      }
 
-      SDL_ScaleMode scale_mode =
-          out_world_objects_container->data[i]->use_scale_mode_nearest
-              ? SDL_SCALEMODE_NEAREST
-              : SDL_SCALEMODE_LINEAR;
+      SDL_ScaleMode scale_mode = world_object->use_scale_mode_nearest
+                                     ? SDL_SCALEMODE_NEAREST
+                                     : SDL_SCALEMODE_LINEAR;
 
       if (!SDL_SetTextureScaleMode(temp_texture, scale_mode)) {
         fprintf(stderr, "Failed to set texture scale mode: %s\n",
@@ -314,7 +377,7 @@ bool process_world_objects(
         return false;
       }
 
-      out_world_objects_container->data[i]->textures.data[j] = temp_texture;
+      world_object->textures.data[j] = temp_texture;
     }
   }
 
@@ -347,6 +410,7 @@ void cleanup_world_object(World_Object *world_object) {
   // Clean up frame source files using the container cleanup
   cleanup_frame_src_container(&world_object->frame_src_files);
   cleanup_textures(&world_object->textures);
+  cleanup_surfaces(&world_object->surfaces);
 
   free(world_object);
 }
@@ -369,8 +433,25 @@ void cleanup_textures(Texture_Src_Container *container) {
     return;
   }
 
+  // Headless containers never created their textures
+  for (size_t i = 0; i < container->length; i++) {
+    if (container->data[i]) {
+      SDL_DestroyTexture(container->data[i]);
+    }
+  }
+
+  free(container->data);
+  container->data   = NULL;
+  container->length = 0;
+}
+
+void cleanup_surfaces(Surface_Src_Container *container) {
+  if (!container || !container->data) {
+    return;
+  }
+
   for (size_t i = 0; i < container->length; i++) {
-    SDL_DestroyTexture(container->data[i]);
+    SDL_DestroySurface(container->data[i]);
   }
 
   free(container->data);
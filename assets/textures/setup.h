@@ -18,9 +18,11 @@ bool parse_asset_manifest_json_string(World_Objects_Container *out_world_objects
 bool parse_texture_fields(World_Object *world_object, const cJSON *json_object);
 bool parse_frame_src_files(World_Object *world_object, cJSON *frame_src_files_array);
 bool process_world_objects(SDL_Renderer *renderer, World_Objects_Container *out_world_objects_container);
+bool create_world_object_textures(SDL_Renderer *renderer, World_Objects_Container *world_objects_container);
 void cleanup_world_objects(World_Objects_Container *container);
 void cleanup_world_object(World_Object *world_object);
 void cleanup_frame_src_container(Frame_Src_Container *container);
 void cleanup_textures(Texture_Src_Container *container);
+void cleanup_surfaces(Surface_Src_Container *container);
 
 #endif
\ No newline at end of file
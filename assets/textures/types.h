@@ -6,6 +6,7 @@
 
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_stdinc.h>
+#include <SDL3/SDL_surface.h>
 
 typedef struct Frame_Src_Container {
   char **data;
@@ -17,12 +18,17 @@ typedef struct Texture_Src_Container {
   size_t        length;
 } Texture_Src_Container;
 
+// CPU side RGBA32 copies of each frame, used by the software renderers
+typedef struct Surface_Src_Container {
+  SDL_Surface **data;
+  size_t        length;
+} Surface_Src_Container;
+
 typedef struct Animation_State {
   bool  is_animated;
   bool  is_looping;
   int   current_frame_index;
   int   max_frame_index;
-  float frame_elapsed_time;
   float frame_duration;
 } Animation_State;
 
@@ -32,12 +38,14 @@ typedef struct World_Object {
   char                 *src_directory;
   Frame_Src_Container   frame_src_files;
   Texture_Src_Container textures;
+  Surface_Src_Container surfaces;
   Animation_State       animation_state;
   Uint8                 surface_type;
   Uint8                 collision_mode;
   int                   expected_pixel_width;
   int                   expected_pixel_height;
   bool                  use_scale_mode_nearest;
+  bool                  is_translucent;
 } World_Object;
 
 typedef struct World_Objects_Container {
@@ -45,4 +53,22 @@ typedef struct World_Objects_Container {
   size_t         length;
 } World_Objects_Container;
 
+/*
+ * Shared animation clocks, one per distinct (frame_duration, frame_count,
+ * is_looping). Clock data is stored as parallel arrays so the per frame update
+ * is a single pass over contiguous memory.
+ */
+typedef struct Animation_Clocks {
+  double elapsed_time;
+  size_t length;
+  float *frame_rates; // 1 / frame_duration
+  int   *frame_counts;
+  int   *is_looping;
+  int   *current_frame_indexes;
+  // Compact list of animated world objects and the clock driving each one
+  size_t         animated_length;
+  World_Object **animated_objects;
+  int           *animated_clock_indexes;
+} Animation_Clocks;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,323 @@
+#include "./audio.h"
+
+static const char *const SOUND_PATHS[SOUND_COUNT] = {
+#define SOUND_PATH_ENTRY(id, path) [id] = path,
+    SOUND_FILES(SOUND_PATH_ENTRY)
+#undef SOUND_PATH_ENTRY
+};
+
+static bool load_sound(const char *path, Sound *out_sound);
+static Voice_Id push_play_command(Audio_Engine *audio_engine, Sound_Id sound_id,
+                                  Point_2D position, float volume,
+                                  bool is_positional);
+static void push_command(Audio_Engine *audio_engine, const Audio_Command *command);
+static void SDLCALL mix_audio(void *userdata, SDL_AudioStream *stream,
+                              int additional_amount, int total_amount);
+static void apply_audio_commands(Audio_Engine *audio_engine);
+static void start_voice(Audio_Engine *audio_engine, const Audio_Command *command);
+static Voice *find_voice(Audio_Engine *audio_engine, Voice_Id voice_id);
+static void update_voice_gains(const Audio_Listener *listener, Voice *voice);
+static void mix_voices(Audio_Engine *audio_engine, int frame_count);
+
+/*
+ * Decodes every sound up front and opens the default playback device. Mixing
+ * happens in SDL's audio stream callback, on SDL's audio thread. Returns NULL
+ * when there is no audio, the game runs silent.
+ */
+extern Audio_Engine *create_audio_engine(void) {
+  if (!SDL_InitSubSystem(SDL_INIT_AUDIO)) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Couldn't initialize SDL_INIT_AUDIO: %s", SDL_GetError());
+    return NULL;
+  }
+
+  Audio_Engine *audio_engine = calloc(1, sizeof(Audio_Engine));
+  if (!audio_engine) {
+    SDL_QuitSubSystem(SDL_INIT_AUDIO);
+    return NULL;
+  }
+  init_audio_command_queue(&audio_engine->queue);
+
+  // A sound that fails to load stays empty and plays as silence
+  for (int i = 0; i < SOUND_COUNT; i++) {
+    if (!load_sound(SOUND_PATHS[i], &audio_engine->sounds[i])) {
+      SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't load sound %s: %s",
+                   SOUND_PATHS[i], SDL_GetError());
+    }
+  }
+
+  SDL_AudioSpec spec = {
+      .format   = SDL_AUDIO_F32,
+      .channels = AUDIO_OUTPUT_CHANNELS,
+      .freq     = AUDIO_SAMPLE_RATE,
+  };
+  audio_engine->stream = SDL_OpenAudioDeviceStream(
+      SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &spec, mix_audio, audio_engine);
+  if (!audio_engine->stream) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
+                 "Couldn't open audio device: %s", SDL_GetError());
+    free_audio_engine(audio_engine);
+    return NULL;
+  }
+  SDL_ResumeAudioStreamDevice(audio_engine->stream);
+  return audio_engine;
+}
+
+// Plays at full pan, unaffected by the listener
+extern Voice_Id play_sound(Audio_Engine *audio_engine, Sound_Id sound_id,
+                           float volume) {
+  return push_play_command(audio_engine, sound_id, (Point_2D){0}, volume, false);
+}
+
+extern Voice_Id play_sound_at(Audio_Engine *audio_engine, Sound_Id sound_id,
+                              Point_2D position, float volume) {
+  return push_play_command(audio_engine, sound_id, position, volume, true);
+}
+
+extern void move_voice(Audio_Engine *audio_engine, Voice_Id voice_id,
+                       Point_2D position) {
+  push_command(audio_engine, &(Audio_Command){
+                                 .type     = AUDIO_COMMAND_MOVE,
+                                 .voice_id = voice_id,
+                                 .position = position,
+                             });
+}
+
+extern void stop_voice(Audio_Engine *audio_engine, Voice_Id voice_id) {
+  push_command(audio_engine, &(Audio_Command){
+                                 .type     = AUDIO_COMMAND_STOP,
+                                 .voice_id = voice_id,
+                             });
+}
+
+// Once per frame, from the player pose
+extern void set_audio_listener(Audio_Engine *audio_engine, Point_2D position,
+                               Degrees angle) {
+  push_command(audio_engine, &(Audio_Command){
+                                 .type     = AUDIO_COMMAND_SET_LISTENER,
+                                 .position = position,
+                                 .angle    = angle,
+                             });
+}
+
+extern void free_audio_engine(Audio_Engine *audio_engine) {
+  if (!audio_engine) {
+    return;
+  }
+  // Destroying the stream stops the callback before the sounds go away
+  if (audio_engine->stream) {
+    SDL_DestroyAudioStream(audio_engine->stream);
+  }
+  for (int i = 0; i < SOUND_COUNT; i++) {
+    SDL_free(audio_engine->sounds[i].samples);
+  }
+  free(audio_engine);
+  SDL_QuitSubSystem(SDL_INIT_AUDIO);
+}
+
+static bool load_sound(const char *path, Sound *out_sound) {
+  SDL_AudioSpec wav_spec;
+  Uint8        *wav_data;
+  Uint32        wav_length;
+  if (!SDL_LoadWAV(path, &wav_spec, &wav_data, &wav_length)) {
+    return false;
+  }
+
+  SDL_AudioSpec mono_spec = {
+      .format   = SDL_AUDIO_F32,
+      .channels = 1,
+      .freq     = AUDIO_SAMPLE_RATE,
+  };
+  Uint8 *samples;
+  int    samples_length;
+  bool   is_converted = SDL_ConvertAudioSamples(&wav_spec, wav_data, wav_length,
+                                                &mono_spec, &samples,
+                                                &samples_length);
+  SDL_free(wav_data);
+  if (!is_converted) {
+    return false;
+  }
+  out_sound->samples     = (float *)samples;
+  out_sound->frame_count = samples_length / sizeof(float);
+  return true;
+}
+
+static Voice_Id push_play_command(Audio_Engine *audio_engine, Sound_Id sound_id,
+                                  Point_2D position, float volume,
+                                  bool is_positional) {
+  if (!audio_engine) {
+    return 0;
+  }
+  Voice_Id voice_id = ++audio_engine->next_voice_id;
+  if (voice_id == 0) {
+    voice_id = ++audio_engine->next_voice_id;
+  }
+  push_command(audio_engine, &(Audio_Command){
+                                 .type          = AUDIO_COMMAND_PLAY,
+                                 .voice_id      = voice_id,
+                                 .sound_id      = sound_id,
+                                 .position      = position,
+                                 .volume        = volume,
+                                 .is_positional = is_positional,
+                             });
+  return voice_id;
+}
+
+static void push_command(Audio_Engine        *audio_engine,
+                         const Audio_Command *command) {
+  if (audio_engine && !push_audio_command(&audio_engine->queue, command)) {
+    audio_engine->dropped_command_count++;
+  }
+}
+
+/*
+ * Audio thread. Drains the command ring, then mixes what the device asked for
+ * in AUDIO_MIX_FRAMES chunks. Nothing here locks or allocates.
+ */
+static void SDLCALL mix_audio(void *userdata, SDL_AudioStream *stream,
+                              int additional_amount, int total_amount) {
+  (void)total_amount;
+  Audio_Engine *audio_engine = userdata;
+  apply_audio_commands(audio_engine);
+
+  int frame_size = sizeof(float) * AUDIO_OUTPUT_CHANNELS;
+  int frames_left = additional_amount / frame_size;
+  while (frames_left > 0) {
+    int frame_count = frames_left < AUDIO_MIX_FRAMES ? frames_left
+                                                     : AUDIO_MIX_FRAMES;
+    mix_voices(audio_engine, frame_count);
+    SDL_PutAudioStreamData(stream, audio_engine->mix_buffer,
+                           frame_count * frame_size);
+    frames_left -= frame_count;
+  }
+}
+
+static void apply_audio_commands(Audio_Engine *audio_engine) {
+  Audio_Command command;
+  while (pop_audio_command(&audio_engine->queue, &command)) {
+    Voice *voice;
+    switch (command.type) {
+    case AUDIO_COMMAND_PLAY:
+      start_voice(audio_engine, &command);
+      break;
+    case AUDIO_COMMAND_STOP:
+      if ((voice = find_voice(audio_engine, command.voice_id))) {
+        voice->id = 0;
+      }
+      break;
+    case AUDIO_COMMAND_MOVE:
+      if ((voice = find_voice(audio_engine, command.voice_id))) {
+        voice->position = command.position;
+      }
+      break;
+    case AUDIO_COMMAND_SET_LISTENER:
+      audio_engine->listener.position = command.position;
+      audio_engine->listener.angle    = command.angle;
+      break;
+    }
+  }
+
+  for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+    if (audio_engine->voices[i].id) {
+      update_voice_gains(&audio_engine->listener, &audio_engine->voices[i]);
+    }
+  }
+}
+
+/*
+ * Voice limiting: a free voice if there is one, otherwise the quietest voice
+ * is stolen, unless the new sound would be quieter still.
+ */
+static void start_voice(Audio_Engine *audio_engine, const Audio_Command *command) {
+  Voice voice = {
+      .id            = command->voice_id,
+      .sound_id      = command->sound_id,
+      .position      = command->position,
+      .volume        = command->volume,
+      .is_positional = command->is_positional,
+  };
+  update_voice_gains(&audio_engine->listener, &voice);
+  float loudness = fmaxf(voice.gain_left, voice.gain_right);
+  if (loudness <= 0.0f || !audio_engine->sounds[voice.sound_id].samples) {
+    return;
+  }
+
+  Voice *quietest          = NULL;
+  float  quietest_loudness = loudness;
+  for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+    Voice *candidate = &audio_engine->voices[i];
+    if (!candidate->id) {
+      *candidate = voice;
+      return;
+    }
+    float candidate_loudness = fmaxf(candidate->gain_left, candidate->gain_right);
+    if (candidate_loudness < quietest_loudness) {
+      quietest          = candidate;
+      quietest_loudness = candidate_loudness;
+    }
+  }
+  if (quietest) {
+    *quietest = voice;
+  }
+}
+
+static Voice *find_voice(Audio_Engine *audio_engine, Voice_Id voice_id) {
+  for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+    if (audio_engine->voices[i].id == voice_id) {
+      return &audio_engine->voices[i];
+    }
+  }
+  return NULL;
+}
+
+/*
+ * Inverse distance attenuation and equal power panning. Pan comes from how
+ * far the source is to the listener's right, (-sin, cos) of the view angle
+ * with y pointing down the screen.
+ */
+static void update_voice_gains(const Audio_Listener *listener, Voice *voice) {
+  float gain = voice->volume * AUDIO_MASTER_GAIN;
+  float pan  = 0.0f;
+  if (voice->is_positional) {
+    float dx       = voice->position.x - listener->position.x;
+    float dy       = voice->position.y - listener->position.y;
+    float distance = sqrtf(dx * dx + dy * dy);
+    if (distance >= AUDIO_MAX_DISTANCE) {
+      gain = 0.0f;
+    } else if (distance > AUDIO_REFERENCE_DISTANCE) {
+      gain *= AUDIO_REFERENCE_DISTANCE / distance;
+    }
+    if (distance > 0.0f) {
+      Radians angle = convert_deg_to_rads(listener->angle);
+      pan = (dx * -sinf(angle) + dy * cosf(angle)) / distance;
+    }
+  }
+  float pan_angle   = (pan + 1.0f) * (float)M_PI / 4;
+  voice->gain_left  = gain * cosf(pan_angle);
+  voice->gain_right = gain * sinf(pan_angle);
+}
+
+static void mix_voices(Audio_Engine *audio_engine, int frame_count) {
+  float *out = audio_engine->mix_buffer;
+  memset(out, 0, frame_count * AUDIO_OUTPUT_CHANNELS * sizeof(float));
+
+  for (int i = 0; i < AUDIO_MAX_VOICES; i++) {
+    Voice *voice = &audio_engine->voices[i];
+    if (!voice->id) {
+      continue;
+    }
+    const Sound *sound = &audio_engine->sounds[voice->sound_id];
+    size_t       remaining = sound->frame_count - voice->cursor;
+    int          length    = remaining < (size_t)frame_count ? (int)remaining
+                                                             : frame_count;
+    const float *samples   = &sound->samples[voice->cursor];
+    for (int frame = 0; frame < length; frame++) {
+      out[frame * 2]     += samples[frame] * voice->gain_left;
+      out[frame * 2 + 1] += samples[frame] * voice->gain_right;
+    }
+    voice->cursor += length;
+    if (voice->cursor >= sound->frame_count) {
+      voice->id = 0;
+    }
+  }
+}
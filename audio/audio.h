@@ -0,0 +1,30 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_audio.h>
+
+#include "../types/algebraic-types.h"
+#include "../utils/math-utils.h"
+#include "./command-queue.h"
+#include "./constants.h"
+#include "./types.h"
+
+/*
+ * Every call below only pushes a command for the audio thread and returns, a
+ * NULL engine (no audio device) makes them no-ops.
+ */
+extern Audio_Engine *create_audio_engine(void);
+extern Voice_Id play_sound(Audio_Engine *audio_engine, Sound_Id sound_id, float volume);
+extern Voice_Id play_sound_at(Audio_Engine *audio_engine, Sound_Id sound_id, Point_2D position, float volume);
+extern void move_voice(Audio_Engine *audio_engine, Voice_Id voice_id, Point_2D position);
+extern void stop_voice(Audio_Engine *audio_engine, Voice_Id voice_id);
+extern void set_audio_listener(Audio_Engine *audio_engine, Point_2D position, Degrees angle);
+extern void free_audio_engine(Audio_Engine *audio_engine);
+
+#endif
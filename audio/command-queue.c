@@ -0,0 +1,35 @@
+#include "./command-queue.h"
+
+extern void init_audio_command_queue(Audio_Command_Queue *queue) {
+  atomic_init(&queue->head, 0);
+  atomic_init(&queue->tail, 0);
+}
+
+/*
+ * Game thread. Returns false without waiting when the ring is full, the
+ * command is dropped.
+ */
+extern bool push_audio_command(Audio_Command_Queue *queue,
+                               const Audio_Command *command) {
+  size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed);
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire);
+  if (head - tail == AUDIO_COMMAND_QUEUE_SIZE) {
+    return false;
+  }
+  queue->commands[head & (AUDIO_COMMAND_QUEUE_SIZE - 1)] = *command;
+  atomic_store_explicit(&queue->head, head + 1, memory_order_release);
+  return true;
+}
+
+// Audio thread. Returns false when the ring is empty
+extern bool pop_audio_command(Audio_Command_Queue *queue,
+                              Audio_Command       *out_command) {
+  size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed);
+  size_t head = atomic_load_explicit(&queue->head, memory_order_acquire);
+  if (tail == head) {
+    return false;
+  }
+  *out_command = queue->commands[tail & (AUDIO_COMMAND_QUEUE_SIZE - 1)];
+  atomic_store_explicit(&queue->tail, tail + 1, memory_order_release);
+  return true;
+}
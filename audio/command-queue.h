@@ -0,0 +1,14 @@
+#ifndef AUDIO_COMMAND_QUEUE_H
+#define AUDIO_COMMAND_QUEUE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+
+#include "./constants.h"
+#include "./types.h"
+
+extern void init_audio_command_queue(Audio_Command_Queue *queue);
+extern bool push_audio_command(Audio_Command_Queue *queue, const Audio_Command *command);
+extern bool pop_audio_command(Audio_Command_Queue *queue, Audio_Command *out_command);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef AUDIO_CONSTANTS_H
+#define AUDIO_CONSTANTS_H
+
+#include "../data/grid/constants.h"
+
+// Output format, every sound is converted to mono at this rate on load
+#define AUDIO_SAMPLE_RATE 48000
+#define AUDIO_OUTPUT_CHANNELS 2
+#define AUDIO_MIX_FRAMES 256 // per chunk on the audio thread
+
+#define AUDIO_MAX_VOICES 16
+#define AUDIO_COMMAND_QUEUE_SIZE 256 // power of two
+#define AUDIO_MASTER_GAIN 0.5f
+
+// Full volume inside the reference distance, 1 / distance past it, silent past the max
+#define AUDIO_REFERENCE_DISTANCE (GRID_CELL_SIZE * 2)
+#define AUDIO_MAX_DISTANCE (GRID_CELL_SIZE * 24)
+
+#define SOUND_FILES(X)                                                         \
+  X(SOUND_RANDOM, "./assets/sounds/random.wav")                                \
+  X(SOUND_UNLOCK, "./assets/sounds/unlock.wav")
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef AUDIO_TYPES_H
+#define AUDIO_TYPES_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <SDL3/SDL_audio.h>
+
+#include "../types/algebraic-types.h"
+#include "../utils/math-utils.h"
+#include "./constants.h"
+
+#define SOUND_ID_ENTRY(id, path) id,
+typedef enum Sound_Id {
+  SOUND_FILES(SOUND_ID_ENTRY)
+  SOUND_COUNT,
+} Sound_Id;
+#undef SOUND_ID_ENTRY
+
+// Handed out by the game thread, 0 is never a voice
+typedef uint32_t Voice_Id;
+
+// Mono F32 at AUDIO_SAMPLE_RATE, decoded once at load
+typedef struct Sound {
+  float  *samples;
+  size_t  frame_count;
+} Sound;
+
+typedef enum Audio_Command_Type {
+  AUDIO_COMMAND_PLAY,
+  AUDIO_COMMAND_STOP,
+  AUDIO_COMMAND_MOVE,
+  AUDIO_COMMAND_SET_LISTENER,
+} Audio_Command_Type;
+
+typedef struct Audio_Command {
+  Audio_Command_Type type;
+  Voice_Id           voice_id;
+  Sound_Id           sound_id;
+  Point_2D           position; // of the voice, or the listener
+  Degrees            angle;    // listener only
+  float              volume;
+  bool               is_positional;
+} Audio_Command;
+
+/*
+ * Single producer (game thread), single consumer (audio thread) ring. Each
+ * side only writes its own index, so neither ever waits on the other.
+ */
+typedef struct Audio_Command_Queue {
+  Audio_Command  commands[AUDIO_COMMAND_QUEUE_SIZE];
+  _Atomic size_t head; // next write
+  _Atomic size_t tail; // next read
+} Audio_Command_Queue;
+
+typedef struct Voice {
+  Voice_Id id; // 0 when free
+  Sound_Id sound_id;
+  size_t   cursor; // next frame
+  Point_2D position;
+  float    volume;
+  bool     is_positional;
+  float    gain_left;
+  float    gain_right;
+} Voice;
+
+typedef struct Audio_Listener {
+  Point_2D position;
+  Degrees  angle;
+} Audio_Listener;
+
+typedef struct Audio_Engine {
+  SDL_AudioStream    *stream;
+  Sound               sounds[SOUND_COUNT];
+  Audio_Command_Queue queue;
+  // Audio thread only
+  Voice               voices[AUDIO_MAX_VOICES];
+  Audio_Listener      listener;
+  float               mix_buffer[AUDIO_MIX_FRAMES * AUDIO_OUTPUT_CHANNELS];
+  // Game thread only
+  Voice_Id            next_voice_id;
+  uint32_t            dropped_command_count; // queue was full
+} Audio_Engine;
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef BENCH_CONSTANTS_H
+#define BENCH_CONSTANTS_H
+
+// Map sizes double from the min to the max side length, in cells
+#define BENCH_MIN_SIDE_DEFAULT 64
+#define BENCH_MAX_SIDE_DEFAULT 8192
+#define BENCH_WALL_DENSITY_DEFAULT 0.2f
+#define BENCH_MATERIAL_COUNT_DEFAULT 8
+#define BENCH_FRAME_COUNT_DEFAULT 100
+#define BENCH_SEED_DEFAULT 1
+#define BENCH_OUT_DIR_DEFAULT "bench/results"
+
+// CSV levels cost a heap string per cell, so the CSV load stops at 2048x2048
+#define BENCH_CSV_MAX_CELLS_DEFAULT (2048 * 2048)
+
+// One frame of the software view
+#define BENCH_VIEW_W 800
+#define BENCH_VIEW_H 400
+#define BENCH_COLLISION_BODIES 1024
+
+#define SYNTH_MATERIAL_NAME_LENGTH 40 // "synth-floor-" and any size_t
+#define SYNTH_MATERIAL_CATEGORY "synth"
+
+// Procgen sides double from the min to the max, best of the repetitions
+#define PROCGEN_BENCH_MIN_SIDE_DEFAULT 256
+#define PROCGEN_BENCH_MAX_SIDE_DEFAULT 4096
+#define PROCGEN_BENCH_REPETITIONS 3
+
+// Microbenchmark harness
+#define BENCH_WARMUP_DEFAULT 5
+#define BENCH_REPETITIONS_DEFAULT 30
+#define BENCH_MIN_REPETITION_SECONDS 0.002
+#define BENCH_MAX_CALLS_PER_REPETITION (1 << 24)
+#define BENCH_CPU_DEFAULT 0
+
+#endif
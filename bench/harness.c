@@ -0,0 +1,100 @@
+#define _GNU_SOURCE // sched_setaffinity
+#include "./harness.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+static int compare_doubles(const void *a, const void *b);
+
+extern double get_bench_seconds(void) {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Keeps the scheduler from migrating the run between cores, Linux only
+extern bool pin_bench_thread(int cpu) {
+#ifdef __linux__
+  if (cpu < 0) {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+    fprintf(stderr, "Could not pin to CPU %d\n", cpu);
+    return false;
+  }
+  return true;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+/*
+ * Doubles the calls per repetition until one lasts min_repetition_seconds,
+ * so the clock's resolution is noise, then runs the warmup repetitions and
+ * times the rest. Each sample is the repetition's time per op.
+ */
+extern Bench_Stats run_bench_kernel(const Bench_Config *config,
+                                    Bench_Kernel kernel, void *context,
+                                    size_t ops_per_call) {
+  size_t calls = 1;
+  while (calls < BENCH_MAX_CALLS_PER_REPETITION) {
+    double start = get_bench_seconds();
+    for (size_t i = 0; i < calls; i++) {
+      kernel(context);
+    }
+    if (get_bench_seconds() - start >= config->min_repetition_seconds) {
+      break;
+    }
+    calls *= 2;
+  }
+
+  for (size_t repetition = 0; repetition < config->warmup_repetitions;
+       repetition++) {
+    for (size_t i = 0; i < calls; i++) {
+      kernel(context);
+    }
+  }
+
+  Bench_Stats stats       = {.calls_per_repetition = calls};
+  size_t      repetitions = config->repetitions ? config->repetitions : 1;
+  double     *samples     = malloc(repetitions * sizeof(double));
+  if (!samples) {
+    return stats;
+  }
+  double ops = (double)calls * (ops_per_call ? ops_per_call : 1);
+  for (size_t repetition = 0; repetition < repetitions; repetition++) {
+    double start = get_bench_seconds();
+    for (size_t i = 0; i < calls; i++) {
+      kernel(context);
+    }
+    samples[repetition] = (get_bench_seconds() - start) * 1e9 / ops;
+  }
+
+  qsort(samples, repetitions, sizeof(double), compare_doubles);
+  double sum = 0;
+  for (size_t i = 0; i < repetitions; i++) {
+    sum += samples[i];
+  }
+  stats.mean_ns = sum / repetitions;
+  double variance = 0;
+  for (size_t i = 0; i < repetitions; i++) {
+    variance += (samples[i] - stats.mean_ns) * (samples[i] - stats.mean_ns);
+  }
+  stats.stddev_ns = sqrt(variance / repetitions);
+  stats.min_ns    = samples[0];
+  stats.median_ns = samples[repetitions / 2];
+  stats.p95_ns    = samples[(size_t)((repetitions - 1) * 0.95)];
+  free(samples);
+  return stats;
+}
+
+static int compare_doubles(const void *a, const void *b) {
+  double lhs = *(const double *)a;
+  double rhs = *(const double *)b;
+  return (lhs > rhs) - (lhs < rhs);
+}
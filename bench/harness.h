@@ -0,0 +1,19 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "./constants.h"
+#include "./types.h"
+
+extern double get_bench_seconds(void);
+extern bool pin_bench_thread(int cpu);
+extern Bench_Stats run_bench_kernel(const Bench_Config *config, Bench_Kernel kernel, void *context, size_t ops_per_call);
+
+#endif
@@ -0,0 +1,537 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "../assets/textures/animation.h"
+#include "../assets/textures/setup.h"
+#include "../config/constants.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/lightmap.h"
+#include "../data/grid/tile-map.h"
+#include "../data/procgen/procgen.h"
+#include "../io/level-io.h"
+#include "../io/read-manifest.h"
+#include "../objects/collision/collision.h"
+#include "../objects/collision/raycast.h"
+#include "../objects/player/constants.h"
+#include "../render/constants.h"
+#include "../render/fixed-caster.h"
+#include "../render/fog.h"
+#include "../render/indexed-renderer.h"
+#include "../render/kernels.h"
+#include "../utils/math-utils.h"
+#include "./constants.h"
+#include "./harness.h"
+#include "./types.h"
+
+/*
+ * Hot kernels in isolation, each against the real manifest and levels 3
+ * and 4, so optimizations compare like for like. Traversal and floor entries
+ * call the software renderer's own trace_*_ray and draw_*_floor, float and
+ * 16.16, with the engine's default fog; tile-raycast is the gameplay query
+ * module. Every kernel is batched by
+ * the harness until a repetition is long enough to time, warmed up, then
+ * repeated; the table is in ns per op, the op being named in the unit column.
+ *
+ *   ./bench/microbench [--filter name] [--reps n] [--warmup n] [--cpu n]
+ *                      [--csv path]
+ */
+
+#define MANIFEST_PATH "./manifests/texture_manifest.json"
+#define BENCH_LEVEL_COUNT 2
+#define BENCH_MOVE_DIRECTIONS 64
+
+static const int BENCH_LEVELS[BENCH_LEVEL_COUNT] = {3, 4};
+
+typedef struct Bench_World {
+  World_Objects_Container *world_objects_container;
+  Animation_Clocks        *animation_clocks;
+  Indexed_Renderer        *indexed_renderer;
+  char                    *manifest_json;
+
+  // The level being measured
+  char         wall_path[MAX_PATH_LENGTH];
+  Jagged_Grid *wall_grid;
+  Tile_Map    *tile_map;
+  Lightmap    *lightmap;
+  Render_Scene scene;
+  Camera       camera;
+  Fixed_View   fixed_view;
+
+  Raycast_Query          queries[SOFTWARE_RENDER_W];
+  Raycast_Hit            hits[SOFTWARE_RENDER_W];
+  Vector_1D              ray_x_dirs[SOFTWARE_RENDER_W];
+  Vector_1D              ray_y_dirs[SOFTWARE_RENDER_W];
+  Scalar                 max_ray_distances[SOFTWARE_RENDER_W]; // in cells
+  Vector_1D              floor_x_dirs[SOFTWARE_RENDER_W]; // ray over cos
+  Vector_1D              floor_y_dirs[SOFTWARE_RENDER_W];
+  Fixed                  fixed_ray_x_dirs[SOFTWARE_RENDER_W];
+  Fixed                  fixed_ray_y_dirs[SOFTWARE_RENDER_W];
+  int64_t                fixed_max_ray_distances[SOFTWARE_RENDER_W];
+  Fixed                  fixed_floor_x_dirs[SOFTWARE_RENDER_W];
+  Fixed                  fixed_floor_y_dirs[SOFTWARE_RENDER_W];
+  Indexed_Ray_Hit        ray_hits[MAX_RAY_HITS];
+  Fixed_Ray_Hit          fixed_ray_hits[MAX_RAY_HITS];
+  int                    floor_start_y;
+  const Indexed_Texture *wall_texture;
+  Vector_2D              moves[BENCH_MOVE_DIRECTIONS];
+  size_t                 move_index;
+  uint64_t               sink;
+} Bench_World;
+
+typedef struct Bench_Entry {
+  const char  *name;
+  const char  *unit;
+  Bench_Kernel kernel;
+  size_t (*get_ops)(const Bench_World *world);
+} Bench_Entry;
+
+typedef struct Microbench_Options {
+  Bench_Config config;
+  const char  *filter;
+  const char  *csv_path;
+} Microbench_Options;
+
+static bool parse_microbench_options(int argc, char **argv,
+                                     Microbench_Options *out_options);
+static bool setup_bench_world(Bench_World *world);
+static bool load_bench_level(Bench_World *world, int level);
+static void unload_bench_level(Bench_World *world);
+static void free_bench_world(Bench_World *world);
+
+static void bench_dda_traversal(void *context);
+static void bench_dda_traversal_fixed(void *context);
+static void bench_tile_raycast(void *context);
+static void bench_tile_raycast_batch(void *context);
+static void bench_floor_columns(void *context);
+static void bench_floor_columns_fixed(void *context);
+static void bench_wall_column(void *context);
+static void bench_material_lookup(void *context);
+static void bench_texture_animations(void *context);
+static void bench_player_collision(void *context);
+static void bench_csv_parse(void *context);
+static void bench_manifest_parse(void *context);
+
+static size_t get_one_op(const Bench_World *world);
+static size_t get_view_w_ops(const Bench_World *world);
+static size_t get_view_h_ops(const Bench_World *world);
+static size_t get_floor_pixel_ops(const Bench_World *world);
+static size_t get_wall_cell_ops(const Bench_World *world);
+
+static const Bench_Entry BENCH_ENTRIES[] = {
+    {"dda-traversal", "ray", bench_dda_traversal, get_view_w_ops},
+    {"dda-traversal-fixed", "ray", bench_dda_traversal_fixed, get_view_w_ops},
+    {"tile-raycast", "ray", bench_tile_raycast, get_view_w_ops},
+    {"tile-raycast-batch", "ray", bench_tile_raycast_batch, get_view_w_ops},
+    {"floor-columns", "pixel", bench_floor_columns, get_floor_pixel_ops},
+    {"floor-columns-fixed", "pixel", bench_floor_columns_fixed,
+     get_floor_pixel_ops},
+    {"wall-column", "pixel", bench_wall_column, get_view_h_ops},
+    {"material-lookup", "cell", bench_material_lookup, get_wall_cell_ops},
+    {"texture-animations", "frame", bench_texture_animations, get_one_op},
+    {"player-collision", "move", bench_player_collision, get_one_op},
+    {"csv-parse", "file", bench_csv_parse, get_one_op},
+    {"manifest-parse", "file", bench_manifest_parse, get_one_op},
+};
+
+#define BENCH_ENTRY_COUNT (sizeof(BENCH_ENTRIES) / sizeof(BENCH_ENTRIES[0]))
+
+int main(int argc, char **argv) {
+  Microbench_Options options;
+  if (!parse_microbench_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+  bool is_pinned = pin_bench_thread(options.config.cpu);
+
+  Bench_World world = {0};
+  if (!setup_bench_world(&world)) {
+    free_bench_world(&world);
+    return EXIT_FAILURE;
+  }
+
+  FILE *csv_file = options.csv_path ? fopen(options.csv_path, "w") : NULL;
+  if (options.csv_path && !csv_file) {
+    fprintf(stderr, "Could not open %s\n", options.csv_path);
+  }
+  if (csv_file) {
+    fprintf(csv_file, "level,kernel,unit,min_ns,median_ns,p95_ns,mean_ns,"
+                      "stddev_ns,calls_per_repetition\n");
+  }
+
+  printf("cpu %s, %zu warmup, %zu repetitions\n",
+         is_pinned ? "pinned" : "unpinned", options.config.warmup_repetitions,
+         options.config.repetitions);
+  printf("%5s %-20s %-6s %12s %12s %12s %12s %10s\n", "level", "kernel",
+         "unit", "min ns", "median ns", "p95 ns", "mean ns", "stddev %");
+  for (int i = 0; i < BENCH_LEVEL_COUNT; i++) {
+    if (!load_bench_level(&world, BENCH_LEVELS[i])) {
+      continue;
+    }
+    for (size_t j = 0; j < BENCH_ENTRY_COUNT; j++) {
+      const Bench_Entry *entry = &BENCH_ENTRIES[j];
+      if (options.filter && !strstr(entry->name, options.filter)) {
+        continue;
+      }
+      Bench_Stats stats = run_bench_kernel(&options.config, entry->kernel,
+                                           &world, entry->get_ops(&world));
+      printf("%5d %-20s %-6s %12.2f %12.2f %12.2f %12.2f %10.1f\n",
+             BENCH_LEVELS[i], entry->name, entry->unit, stats.min_ns,
+             stats.median_ns, stats.p95_ns, stats.mean_ns,
+             stats.mean_ns > 0 ? stats.stddev_ns * 100.0 / stats.mean_ns : 0);
+      if (csv_file) {
+        fprintf(csv_file, "%d,%s,%s,%.3f,%.3f,%.3f,%.3f,%.3f,%zu\n",
+                BENCH_LEVELS[i], entry->name, entry->unit, stats.min_ns,
+                stats.median_ns, stats.p95_ns, stats.mean_ns,
+                stats.stddev_ns, stats.calls_per_repetition);
+      }
+    }
+    unload_bench_level(&world);
+  }
+
+  if (csv_file) {
+    fclose(csv_file);
+  }
+  free_bench_world(&world);
+  return EXIT_SUCCESS;
+}
+
+static bool parse_microbench_options(int argc, char **argv,
+                                     Microbench_Options *out_options) {
+  *out_options = (Microbench_Options){
+      .config = {
+          .warmup_repetitions     = BENCH_WARMUP_DEFAULT,
+          .repetitions            = BENCH_REPETITIONS_DEFAULT,
+          .min_repetition_seconds = BENCH_MIN_REPETITION_SECONDS,
+          .cpu                    = BENCH_CPU_DEFAULT,
+      },
+  };
+  for (int i = 1; i < argc; i++) {
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return false;
+    }
+    if (strcmp(argv[i], "--filter") == 0) {
+      out_options->filter = value;
+    } else if (strcmp(argv[i], "--reps") == 0) {
+      out_options->config.repetitions = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--warmup") == 0) {
+      out_options->config.warmup_repetitions = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--cpu") == 0) {
+      out_options->config.cpu = atoi(value);
+    } else if (strcmp(argv[i], "--csv") == 0) {
+      out_options->csv_path = value;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--filter name] [--reps n] [--warmup n] [--cpu n, "
+              "-1 unpinned] [--csv path]\n",
+              argv[0]);
+      return false;
+    }
+    i++;
+  }
+  return out_options->config.repetitions > 0;
+}
+
+// The manifest and textures are loaded the way the engine loads them, headless
+static bool setup_bench_world(Bench_World *world) {
+  world->world_objects_container =
+      setup_engine_textures(NULL, MANIFEST_PATH);
+  world->manifest_json = read_asset_manifest_file(MANIFEST_PATH);
+  if (!world->world_objects_container || !world->manifest_json) {
+    return false;
+  }
+  world->animation_clocks =
+      create_animation_clocks(world->world_objects_container);
+  world->indexed_renderer =
+      create_indexed_renderer(world->world_objects_container,
+                              SOFTWARE_RENDER_W, SOFTWARE_RENDER_H);
+  if (!world->animation_clocks || !world->indexed_renderer) {
+    return false;
+  }
+
+  // The first opaque wall texture stands in for every wall column
+  for (size_t i = 0; i < world->world_objects_container->length; i++) {
+    const World_Object *world_object = world->world_objects_container->data[i];
+    if ((world_object->surface_type & COLLISION_MODE_WALL) &&
+        !world_object->is_translucent) {
+      world->wall_texture = get_material_texture(
+          world->indexed_renderer, world->world_objects_container,
+          (Material_Id)i);
+      break;
+    }
+  }
+  if (!world->wall_texture) {
+    fprintf(stderr, "No wall texture in %s\n", MANIFEST_PATH);
+    return false;
+  }
+
+  for (int i = 0; i < BENCH_MOVE_DIRECTIONS; i++) {
+    Radians radians = convert_deg_to_rads(i * 360.0 / BENCH_MOVE_DIRECTIONS);
+    world->moves[i] = (Vector_2D){
+        .x = cosf(radians) * PLAYER_SPEED / 60.0f,
+        .y = sinf(radians) * PLAYER_SPEED / 60.0f,
+    };
+  }
+  return true;
+}
+
+// The eye sits in the first open cell from the middle of the level
+static bool load_bench_level(Bench_World *world, int level) {
+  char floor_path[MAX_PATH_LENGTH];
+  snprintf(world->wall_path, sizeof(world->wall_path),
+           "./assets/levels/%d/w.csv", level);
+  snprintf(floor_path, sizeof(floor_path), "./assets/levels/%d/f.csv", level);
+
+  Jagged_Grid *floor_grid = read_grid_csv_file(floor_path);
+  world->wall_grid        = read_grid_csv_file(world->wall_path);
+  world->tile_map         = create_tile_map(floor_grid, world->wall_grid,
+                                            world->world_objects_container);
+  free_jagged_grid(floor_grid);
+
+  IPoint_2D cell;
+  if (!world->tile_map || !find_procgen_spawn(world->tile_map, &cell)) {
+    fprintf(stderr, "Skipping level %d\n", level);
+    unload_bench_level(world);
+    return false;
+  }
+  // A baked lightmap without sources, so every light lookup is still paid
+  Jagged_Grid no_lights = {0};
+  world->lightmap       = create_lightmap(world->tile_map, &no_lights);
+  if (!world->lightmap) {
+    unload_bench_level(world);
+    return false;
+  }
+  world->camera = (Camera){
+      .position = {.x = (cell.x + 0.5f) * GRID_CELL_SIZE,
+                   .y = (cell.y + 0.5f) * GRID_CELL_SIZE},
+      .angle    = 0,
+  };
+  world->scene = (Render_Scene){
+      .tile_map                = world->tile_map,
+      .world_objects_container = world->world_objects_container,
+      .lightmap                = world->lightmap,
+      .fog                     = create_fog(VIEW_DISTANCE_DEFAULT),
+  };
+  world->fixed_view    = create_fixed_view(&world->scene, world->camera);
+  world->floor_start_y = SOFTWARE_RENDER_H / 2 + 1;
+
+  // The per column setup render_indexed_column and render_fixed_column do
+  const Fixed_Caster_Tables *tables = &world->indexed_renderer->fixed_tables;
+  for (int x = 0; x < SOFTWARE_RENDER_W; x++) {
+    float   offset  = ((float)x / SOFTWARE_RENDER_W - 0.5f) * PLAYER_FOV_DEG;
+    Radians radians = convert_deg_to_rads(world->camera.angle + offset);
+    Scalar  cos_theta = cosf(convert_deg_to_rads(offset));
+    world->ray_x_dirs[x] = cosf(radians);
+    world->ray_y_dirs[x] = sinf(radians);
+    world->max_ray_distances[x] =
+        world->scene.fog.max_distance / (GRID_CELL_SIZE * cos_theta);
+    world->floor_x_dirs[x] = world->ray_x_dirs[x] / cos_theta;
+    world->floor_y_dirs[x] = world->ray_y_dirs[x] / cos_theta;
+
+    Fixed_Angle angle = world->fixed_view.angle + tables->column_angles[x];
+    world->fixed_ray_x_dirs[x] = fixed_cos(angle);
+    world->fixed_ray_y_dirs[x] = fixed_sin(angle);
+    world->fixed_max_ray_distances[x] =
+        ((int64_t)world->fixed_view.fog_max * tables->column_inv_cos[x]) >>
+        FIXED_SHIFT;
+    world->fixed_floor_x_dirs[x] =
+        fixed_mul(world->fixed_ray_x_dirs[x], tables->column_inv_cos[x]);
+    world->fixed_floor_y_dirs[x] =
+        fixed_mul(world->fixed_ray_y_dirs[x], tables->column_inv_cos[x]);
+
+    world->queries[x] = (Raycast_Query){
+        .origin         = world->camera.position,
+        .direction      = {.x = world->ray_x_dirs[x],
+                           .y = world->ray_y_dirs[x]},
+        .max_distance   = world->scene.fog.max_distance,
+        .collision_mask = COLLISION_MODE_WALL,
+    };
+  }
+  return true;
+}
+
+static void unload_bench_level(Bench_World *world) {
+  free_lightmap(world->lightmap);
+  free_tile_map(world->tile_map);
+  free_jagged_grid(world->wall_grid);
+  world->lightmap  = NULL;
+  world->tile_map  = NULL;
+  world->wall_grid = NULL;
+}
+
+static void free_bench_world(Bench_World *world) {
+  unload_bench_level(world);
+  free(world->manifest_json);
+  free_indexed_renderer(world->indexed_renderer);
+  free_animation_clocks(world->animation_clocks);
+  if (world->world_objects_container) {
+    cleanup_world_objects(world->world_objects_container);
+    free(world->world_objects_container);
+  }
+  SDL_Quit();
+}
+
+// One ray per column of the software view, out to the default view distance
+static void bench_dda_traversal(void *context) {
+  Bench_World *world = context;
+  bool         is_wall_hit;
+  for (int x = 0; x < SOFTWARE_RENDER_W; x++) {
+    world->sink += trace_indexed_ray(
+        &world->scene, world->camera.position, world->ray_x_dirs[x],
+        world->ray_y_dirs[x], world->max_ray_distances[x], world->ray_hits,
+        &is_wall_hit);
+  }
+}
+
+static void bench_dda_traversal_fixed(void *context) {
+  Bench_World *world = context;
+  bool         is_wall_hit;
+  for (int x = 0; x < SOFTWARE_RENDER_W; x++) {
+    world->sink += trace_fixed_ray(
+        &world->scene, &world->fixed_view, world->fixed_ray_x_dirs[x],
+        world->fixed_ray_y_dirs[x], world->fixed_max_ray_distances[x],
+        world->fixed_ray_hits, &is_wall_hit);
+  }
+}
+
+static void bench_tile_raycast(void *context) {
+  Bench_World *world = context;
+  for (int x = 0; x < SOFTWARE_RENDER_W; x++) {
+    cast_tile_ray(world->tile_map, &world->queries[x], &world->hits[x]);
+  }
+  world->sink += world->hits[0].cell.x;
+}
+
+static void bench_tile_raycast_batch(void *context) {
+  Bench_World *world = context;
+  cast_tile_rays(world->tile_map, world->queries, world->hits,
+                 SOFTWARE_RENDER_W);
+  world->sink += world->hits[0].cell.x;
+}
+
+// Every floor column from the horizon down, as if no wall covered any of it
+static void bench_floor_columns(void *context) {
+  Bench_World *world = context;
+  for (int x = 0; x < SOFTWARE_RENDER_W; x++) {
+    draw_indexed_floor(world->indexed_renderer, &world->scene, world->camera,
+                       x, world->floor_x_dirs[x], world->floor_y_dirs[x],
+                       world->floor_start_y);
+  }
+  world->sink += world->indexed_renderer->framebuffer[SOFTWARE_RENDER_W *
+                                                      (SOFTWARE_RENDER_H - 1)];
+}
+
+static void bench_floor_columns_fixed(void *context) {
+  Bench_World *world = context;
+  for (int x = 0; x < SOFTWARE_RENDER_W; x++) {
+    draw_fixed_floor(world->indexed_renderer, &world->scene, &world->fixed_view,
+                     x, world->fixed_floor_x_dirs[x],
+                     world->fixed_floor_y_dirs[x], world->floor_start_y);
+  }
+  world->sink += world->indexed_renderer->framebuffer[SOFTWARE_RENDER_W *
+                                                      (SOFTWARE_RENDER_H - 1)];
+}
+
+// A wall a cell away, stretched over the whole column
+static void bench_wall_column(void *context) {
+  Bench_World           *world   = context;
+  const Indexed_Texture *texture = world->wall_texture;
+  Indexed_Renderer      *indexed_renderer = world->indexed_renderer;
+  int                    h                = indexed_renderer->h;
+  texture->draw_wall_column(indexed_renderer->framebuffer,
+                            indexed_renderer->w, h,
+                            &texture->columns[(texture->w / 2) * texture->h],
+                            texture->h, 0,
+                            (Fixed)((float)texture->h / h * FIXED_ONE),
+                            indexed_renderer->colormaps);
+  world->sink += indexed_renderer->framebuffer[0];
+}
+
+// The name to id resolve create_tile_map does for every cell
+static void bench_material_lookup(void *context) {
+  Bench_World       *world     = context;
+  const Jagged_Grid *wall_grid = world->wall_grid;
+  for (size_t y = 0; y < wall_grid->length; y++) {
+    const Jagged_Row *row = &wall_grid->rows[y];
+    for (size_t x = 0; x < row->length; x++) {
+      world->sink += find_material_id(world->world_objects_container,
+                                      row->world_object_names[x]);
+    }
+  }
+}
+
+// What process_texture_animations() does each frame
+static void bench_texture_animations(void *context) {
+  Bench_World *world = context;
+  advance_animation_clocks(world->animation_clocks, 1.0f / 60.0f);
+}
+
+/*
+ * The sweep move_player() does for one 60 Hz step from the spawn, with the
+ * same padded hit box and mask, cycling through directions.
+ */
+static void bench_player_collision(void *context) {
+  Bench_World   *world = context;
+  Collision_Body body  = {
+      .position       = {.x = world->camera.position.x - PLAYER_W / 2 -
+                              PLAYER_INTERACTION_DISTANCE,
+                         .y = world->camera.position.y - PLAYER_H / 2 -
+                              PLAYER_INTERACTION_DISTANCE},
+      .size           = {.x = PLAYER_W + PLAYER_INTERACTION_DISTANCE * 2,
+                         .y = PLAYER_H + PLAYER_INTERACTION_DISTANCE * 2},
+      .displacement   = world->moves[world->move_index],
+      .collision_mask = COLLISION_MODE_FLOOR | COLLISION_MODE_WALL,
+  };
+  world->move_index = (world->move_index + 1) % BENCH_MOVE_DIRECTIONS;
+  sweep_collision_body(world->tile_map, &body);
+  world->sink += body.is_hit_x;
+}
+
+static void bench_csv_parse(void *context) {
+  Bench_World *world = context;
+  Jagged_Grid *grid  = read_grid_csv_file(world->wall_path);
+  world->sink       += grid ? grid->length : 0;
+  free_jagged_grid(grid);
+}
+
+// The JSON and field parsing of setup_engine_textures, without the images
+static void bench_manifest_parse(void *context) {
+  Bench_World            *world     = context;
+  World_Objects_Container container = {0};
+  if (parse_asset_manifest_json_string(&container, world->manifest_json)) {
+    world->sink += container.length;
+    cleanup_world_objects(&container);
+  }
+}
+
+static size_t get_one_op(const Bench_World *world) {
+  (void)world;
+  return 1;
+}
+
+static size_t get_view_w_ops(const Bench_World *world) {
+  (void)world;
+  return SOFTWARE_RENDER_W;
+}
+
+static size_t get_view_h_ops(const Bench_World *world) {
+  return world->indexed_renderer->h;
+}
+
+// Rows past the view distance are counted even though neither path shades them
+static size_t get_floor_pixel_ops(const Bench_World *world) {
+  return (size_t)SOFTWARE_RENDER_W * (SOFTWARE_RENDER_H - world->floor_start_y);
+}
+
+static size_t get_wall_cell_ops(const Bench_World *world) {
+  size_t cell_count = 0;
+  for (size_t y = 0; y < world->wall_grid->length; y++) {
+    cell_count += world->wall_grid->rows[y].length;
+  }
+  return cell_count;
+}
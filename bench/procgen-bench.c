@@ -0,0 +1,276 @@
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include <SDL3/SDL.h>
+
+#include "../data/grid/tile-map.h"
+#include "../data/procgen/procgen.h"
+#include "../utils/fnv-hash.h"
+#include "../utils/worker-pool.h"
+#include "./constants.h"
+#include "./harness.h"
+#include "./synth-level.h"
+#include "./types.h"
+
+/*
+ * How long generate_tile_map takes for every side from --min to --max
+ * (doubling), rooms and caves, on the worker pool and on the calling thread
+ * alone. Each map is also checked for determinism: the same seed has to hash
+ * the same on the pool, alone, and chunk by chunk in reverse order through
+ * generate_tile_map_chunk, the streaming entry point. Any mismatch fails the
+ * run. Results go to stdout and to procgen.csv in --out-dir.
+ *
+ *   ./bench/procgen-bench [--min cells] [--max cells] [--seed n]
+ *                         [--threads n] [--out-dir dir]
+ */
+
+typedef struct Procgen_Bench_Options {
+  size_t      min_side;
+  size_t      max_side;
+  uint64_t    seed;
+  size_t      thread_count;
+  const char *out_dir;
+} Procgen_Bench_Options;
+
+static const char *const PROCGEN_ALGORITHM_NAMES[PROCGEN_ALGORITHM_COUNT] = {
+    [PROCGEN_ALGORITHM_ROOMS] = "rooms",
+    [PROCGEN_ALGORITHM_CAVES] = "caves",
+};
+
+static bool parse_procgen_bench_options(int argc, char **argv,
+                                        Procgen_Bench_Options *out_options);
+static bool run_procgen_size(const Procgen_Generator       *generator,
+                             const World_Objects_Container *world_objects_container,
+                             Worker_Pool *pool, size_t side,
+                             Procgen_Bench_Result *out_result);
+static Tile_Map *generate_tile_map_by_chunk(const Procgen_Generator *generator,
+                                            size_t side,
+                                            const World_Objects_Container *world_objects_container);
+static uint64_t hash_tile_map(const Tile_Map *tile_map);
+static bool write_procgen_csv(const char *path, size_t thread_count,
+                              const Procgen_Bench_Result *results,
+                              size_t length);
+
+int main(int argc, char **argv) {
+  Procgen_Bench_Options options;
+  if (!parse_procgen_bench_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+  if (mkdir(options.out_dir, 0755) != 0 && errno != EEXIST) {
+    fprintf(stderr, "Could not create %s\n", options.out_dir);
+    return EXIT_FAILURE;
+  }
+
+  World_Objects_Container *world_objects_container =
+      create_synth_materials(BENCH_MATERIAL_COUNT_DEFAULT);
+  Worker_Pool *pool = create_worker_pool(options.thread_count);
+  size_t       capacity = 0;
+  for (size_t side = options.min_side; side <= options.max_side; side *= 2) {
+    capacity += PROCGEN_ALGORITHM_COUNT;
+  }
+  Procgen_Bench_Result *results =
+      calloc(capacity, sizeof(Procgen_Bench_Result));
+  size_t length = 0;
+  bool   is_ok  = world_objects_container && pool && results;
+
+  if (is_ok) {
+    printf("%zu worker threads and the calling thread\n", pool->thread_count);
+    printf("%6s %8s %10s %10s %8s %6s %16s %s\n", "side", "algo", "pool ms",
+           "single ms", "speedup", "open", "hash", "deterministic");
+  }
+  for (int algorithm = 0; is_ok && algorithm < PROCGEN_ALGORITHM_COUNT;
+       algorithm++) {
+    Procgen_Params params = {
+        .seed           = options.seed,
+        .algorithm      = algorithm,
+        .wall_category  = SYNTH_MATERIAL_CATEGORY,
+        .floor_category = SYNTH_MATERIAL_CATEGORY,
+        .cave_threshold = PROCGEN_CAVE_THRESHOLD_DEFAULT,
+    };
+    Procgen_Generator *generator =
+        create_procgen_generator(&params, world_objects_container);
+    is_ok = generator != NULL;
+    for (size_t side = options.min_side; is_ok && side <= options.max_side;
+         side *= 2) {
+      Procgen_Bench_Result *result = &results[length];
+      result->algorithm            = PROCGEN_ALGORITHM_NAMES[algorithm];
+      is_ok = run_procgen_size(generator, world_objects_container, pool, side,
+                               result);
+      if (!is_ok) {
+        fprintf(stderr, "Stopped at %zux%zu\n", side, side);
+        break;
+      }
+      printf("%6zu %8s %10.2f %10.2f %7.2fx %6.2f %016llx %s\n", result->side,
+             result->algorithm, result->pool_ms, result->single_ms,
+             result->single_ms / result->pool_ms, result->open_fraction,
+             (unsigned long long)result->hash,
+             result->is_deterministic ? "yes" : "NO");
+      length++;
+    }
+    free_procgen_generator(generator);
+  }
+
+  size_t mismatch_count = 0;
+  for (size_t i = 0; i < length; i++) {
+    mismatch_count += !results[i].is_deterministic;
+  }
+  if (mismatch_count > 0) {
+    fprintf(stderr, "%zu maps were not deterministic\n", mismatch_count);
+  }
+
+  char path[MAX_PATH_LENGTH];
+  snprintf(path, sizeof(path), "%s/procgen.csv", options.out_dir);
+  is_ok = is_ok && write_procgen_csv(path, pool->thread_count, results, length);
+
+  free(results);
+  free_worker_pool(pool);
+  free_synth_materials(world_objects_container);
+  SDL_Quit();
+  return is_ok && mismatch_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool parse_procgen_bench_options(int argc, char **argv,
+                                        Procgen_Bench_Options *out_options) {
+  *out_options = (Procgen_Bench_Options){
+      .min_side     = PROCGEN_BENCH_MIN_SIDE_DEFAULT,
+      .max_side     = PROCGEN_BENCH_MAX_SIDE_DEFAULT,
+      .seed         = BENCH_SEED_DEFAULT,
+      .thread_count = get_default_worker_count(),
+      .out_dir      = BENCH_OUT_DIR_DEFAULT,
+  };
+
+  for (int i = 1; i < argc; i++) {
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return false;
+    }
+    if (strcmp(argv[i], "--min") == 0) {
+      out_options->min_side = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--max") == 0) {
+      out_options->max_side = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--seed") == 0) {
+      out_options->seed = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      out_options->thread_count = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--out-dir") == 0) {
+      out_options->out_dir = value;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--min cells] [--max cells] [--seed n] "
+              "[--threads n] [--out-dir dir]\n",
+              argv[0]);
+      return false;
+    }
+    i++;
+  }
+
+  if (out_options->min_side < 4 ||
+      out_options->max_side < out_options->min_side) {
+    fprintf(stderr, "Invalid procgen options\n");
+    return false;
+  }
+  return true;
+}
+
+// Maps are compared by hash, so only one is alive at a time
+static bool run_procgen_size(const Procgen_Generator       *generator,
+                             const World_Objects_Container *world_objects_container,
+                             Worker_Pool *pool, size_t side,
+                             Procgen_Bench_Result *out_result) {
+  out_result->side    = side;
+  out_result->pool_ms = -1;
+
+  Tile_Map *tile_map = NULL;
+  for (int i = 0; i < PROCGEN_BENCH_REPETITIONS; i++) {
+    free_tile_map(tile_map);
+    double start = get_bench_seconds();
+    tile_map =
+        generate_tile_map(generator, side, side, world_objects_container, pool);
+    double ms = (get_bench_seconds() - start) * 1000.0;
+    if (!tile_map) {
+      return false;
+    }
+    out_result->pool_ms =
+        out_result->pool_ms < 0 || ms < out_result->pool_ms ? ms
+                                                            : out_result->pool_ms;
+  }
+  out_result->hash = hash_tile_map(tile_map);
+
+  size_t open_count = 0;
+  for (size_t i = 0; i < side * side; i++) {
+    open_count += tile_map->collision_bits[i] == 0;
+  }
+  out_result->open_fraction = (double)open_count / (side * side);
+  free_tile_map(tile_map);
+
+  double start = get_bench_seconds();
+  tile_map =
+      generate_tile_map(generator, side, side, world_objects_container, NULL);
+  out_result->single_ms = (get_bench_seconds() - start) * 1000.0;
+  if (!tile_map) {
+    return false;
+  }
+  bool is_single_same = hash_tile_map(tile_map) == out_result->hash;
+  free_tile_map(tile_map);
+
+  tile_map = generate_tile_map_by_chunk(generator, side,
+                                        world_objects_container);
+  if (!tile_map) {
+    return false;
+  }
+  out_result->is_deterministic =
+      is_single_same && hash_tile_map(tile_map) == out_result->hash;
+  free_tile_map(tile_map);
+  return true;
+}
+
+// Last chunk first, the way a streamer would fill chunks out of order
+static Tile_Map *generate_tile_map_by_chunk(const Procgen_Generator *generator,
+                                            size_t side,
+                                            const World_Objects_Container *world_objects_container) {
+  Tile_Map *tile_map =
+      create_blank_tile_map(side, side, world_objects_container);
+  if (!tile_map) {
+    return NULL;
+  }
+  size_t chunk_count = (side + PROCGEN_CHUNK_SIZE - 1) / PROCGEN_CHUNK_SIZE;
+  for (size_t i = chunk_count * chunk_count; i-- > 0;) {
+    generate_tile_map_chunk(generator, tile_map, i % chunk_count,
+                            i / chunk_count);
+  }
+  return tile_map;
+}
+
+static uint64_t hash_tile_map(const Tile_Map *tile_map) {
+  size_t   cell_count = tile_map->width * tile_map->height;
+  uint64_t hash       = FNV_OFFSET_BASIS;
+  hash = hash_fnv1a(hash, tile_map->wall_ids, cell_count * sizeof(Material_Id));
+  hash = hash_fnv1a(hash, tile_map->floor_ids,
+                    cell_count * sizeof(Material_Id));
+  return hash_fnv1a(hash, tile_map->collision_bits, cell_count);
+}
+
+static bool write_procgen_csv(const char *path, size_t thread_count,
+                              const Procgen_Bench_Result *results,
+                              size_t length) {
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not open %s\n", path);
+    return false;
+  }
+  fprintf(file, "side,cells,algorithm,threads,pool_ms,single_ms,"
+                "open_fraction,hash,deterministic\n");
+  for (size_t i = 0; i < length; i++) {
+    const Procgen_Bench_Result *result = &results[i];
+    fprintf(file, "%zu,%zu,%s,%zu,%.3f,%.3f,%.4f,%016llx,%d\n", result->side,
+            result->side * result->side, result->algorithm, thread_count,
+            result->pool_ms, result->single_ms, result->open_fraction,
+            (unsigned long long)result->hash, result->is_deterministic);
+  }
+  return fclose(file) == 0;
+}
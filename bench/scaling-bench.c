@@ -0,0 +1,513 @@
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#include "../data/grid/constants.h"
+#include "../data/grid/tile-map.h"
+#include "../io/level-io.h"
+#include "../io/tile-map-io.h"
+#include "../objects/collision/collision.h"
+#include "../objects/collision/raycast.h"
+#include "../objects/player/constants.h"
+#include "../render/fog.h"
+#include "../utils/math-utils.h"
+#include "./constants.h"
+#include "./harness.h"
+#include "./synth-level.h"
+#include "./types.h"
+
+/*
+ * How load time, memory and per frame costs grow with map size. For every
+ * side length from --min to --max (doubling) a synthetic level is built,
+ * loaded from CSV (up to --csv-max-cells) and from the binary tile map
+ * format, then a fixed number of frames of traversal, floor casting and
+ * collision are timed from random open cells. Results go to stdout and to
+ * scaling.csv and scaling.json in --out-dir.
+ *
+ * Traversal and floor casting replay the tile map reads of the renderers
+ * without shading, texture sampling costs the same on any map size.
+ */
+
+typedef struct Scaling_Options {
+  size_t      min_side;
+  size_t      max_side;
+  float       wall_density;
+  size_t      material_count;
+  size_t      frame_count;
+  size_t      csv_max_cells;
+  uint64_t    seed;
+  const char *out_dir;
+} Scaling_Options;
+
+typedef struct Bench_Camera {
+  Point_2D position;
+  Degrees  angle;
+} Bench_Camera;
+
+static void reset_peak_rss(void);
+static bool parse_scaling_options(int argc, char **argv,
+                                  Scaling_Options *out_options);
+static bool run_scaling_size(const Scaling_Options         *options,
+                             const World_Objects_Container *world_objects_container,
+                             size_t side, Scaling_Result *out_result);
+static void measure_frames(const Scaling_Options *options,
+                           const Tile_Map *tile_map,
+                           Scaling_Result *out_result);
+static void place_bench_cameras(const Tile_Map *tile_map, uint64_t seed,
+                                Bench_Camera *cameras, size_t length);
+static double time_traversal(const Tile_Map *tile_map,
+                             const Bench_Camera *cameras, size_t frame_count,
+                             Scalar max_distance);
+static double time_floor_cast(const Tile_Map *tile_map,
+                              const Bench_Camera *cameras, size_t frame_count);
+static double time_collision(const Tile_Map *tile_map,
+                             const Bench_Camera *cameras, size_t frame_count);
+static void print_scaling_result(const Scaling_Result *result);
+static bool write_scaling_csv(const char *path, const Scaling_Result *results,
+                              size_t length);
+static bool write_scaling_json(const char *path, const Scaling_Options *options,
+                               const Scaling_Result *results, size_t length);
+static void print_json_number(FILE *file, double value);
+
+static volatile uint64_t bench_sink; // keeps the timed loops from being elided
+
+int main(int argc, char **argv) {
+  Scaling_Options options;
+  if (!parse_scaling_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+  if (mkdir(options.out_dir, 0755) != 0 && errno != EEXIST) {
+    fprintf(stderr, "Could not create %s\n", options.out_dir);
+    return EXIT_FAILURE;
+  }
+
+  World_Objects_Container *world_objects_container =
+      create_synth_materials(options.material_count);
+  if (!world_objects_container) {
+    return EXIT_FAILURE;
+  }
+
+  size_t          capacity = 0;
+  for (size_t side = options.min_side; side <= options.max_side; side *= 2) {
+    capacity++;
+  }
+  Scaling_Result *results = calloc(capacity ? capacity : 1,
+                                   sizeof(Scaling_Result));
+  size_t          length  = 0;
+  if (!results) {
+    free_synth_materials(world_objects_container);
+    return EXIT_FAILURE;
+  }
+
+  printf("%6s %10s %10s %10s %10s %10s %10s %10s %10s %10s\n", "side",
+         "csv ms", "bin ms", "map MB", "rss MB", "trav ms", "far ms",
+         "floor ms", "coll ms", "open");
+  for (size_t side = options.min_side; side <= options.max_side; side *= 2) {
+    if (!run_scaling_size(&options, world_objects_container, side,
+                          &results[length])) {
+      fprintf(stderr, "Stopped at %zux%zu\n", side, side);
+      break;
+    }
+    print_scaling_result(&results[length]);
+    length++;
+  }
+
+  char path[MAX_PATH_LENGTH];
+  snprintf(path, sizeof(path), "%s/scaling.csv", options.out_dir);
+  bool is_ok = write_scaling_csv(path, results, length);
+  snprintf(path, sizeof(path), "%s/scaling.json", options.out_dir);
+  is_ok = write_scaling_json(path, &options, results, length) && is_ok;
+
+  free(results);
+  free_synth_materials(world_objects_container);
+  return is_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/*
+ * Linux only: restarts the high water mark getrusage reports, so each size's
+ * peak is its own and not the largest one before it. Elsewhere peaks carry
+ * over from earlier sizes.
+ */
+static void reset_peak_rss(void) {
+  FILE *file = fopen("/proc/self/clear_refs", "w");
+  if (file) {
+    fputs("5", file);
+    fclose(file);
+  }
+}
+
+static bool parse_scaling_options(int argc, char **argv,
+                                  Scaling_Options *out_options) {
+  *out_options = (Scaling_Options){
+      .min_side       = BENCH_MIN_SIDE_DEFAULT,
+      .max_side       = BENCH_MAX_SIDE_DEFAULT,
+      .wall_density   = BENCH_WALL_DENSITY_DEFAULT,
+      .material_count = BENCH_MATERIAL_COUNT_DEFAULT,
+      .frame_count    = BENCH_FRAME_COUNT_DEFAULT,
+      .csv_max_cells  = BENCH_CSV_MAX_CELLS_DEFAULT,
+      .seed           = BENCH_SEED_DEFAULT,
+      .out_dir        = BENCH_OUT_DIR_DEFAULT,
+  };
+
+  for (int i = 1; i < argc; i++) {
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return false;
+    }
+    if (strcmp(argv[i], "--min") == 0) {
+      out_options->min_side = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--max") == 0) {
+      out_options->max_side = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--density") == 0) {
+      out_options->wall_density = strtof(value, NULL);
+    } else if (strcmp(argv[i], "--materials") == 0) {
+      out_options->material_count = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--frames") == 0) {
+      out_options->frame_count = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--csv-max-cells") == 0) {
+      out_options->csv_max_cells = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--seed") == 0) {
+      out_options->seed = strtoull(value, NULL, 10);
+    } else if (strcmp(argv[i], "--out-dir") == 0) {
+      out_options->out_dir = value;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--min cells] [--max cells] [--density 0..1] "
+              "[--materials n] [--frames n] [--csv-max-cells n] [--seed n] "
+              "[--out-dir dir]\n",
+              argv[0]);
+      return false;
+    }
+    i++;
+  }
+
+  if (out_options->min_side < 4 ||
+      out_options->max_side < out_options->min_side ||
+      out_options->material_count == 0 ||
+      out_options->material_count * 2 >= MATERIAL_ID_EMPTY ||
+      out_options->frame_count == 0 || out_options->wall_density < 0 ||
+      out_options->wall_density > 1) {
+    fprintf(stderr, "Invalid scaling options\n");
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Only one map is alive at a time, so the peak RSS of a size is bounded by
+ * its own map plus, below --csv-max-cells, the CSV grids.
+ */
+static bool run_scaling_size(const Scaling_Options         *options,
+                             const World_Objects_Container *world_objects_container,
+                             size_t side, Scaling_Result *out_result) {
+  Synth_Level_Params params = {
+      .width          = side,
+      .height         = side,
+      .seed           = options->seed,
+      .wall_density   = options->wall_density,
+      .material_count = options->material_count,
+  };
+  *out_result = (Scaling_Result){
+      .side           = side,
+      .cell_count     = side * side,
+      .csv_load_ms    = -1,
+      .tile_map_bytes = side * side * (2 * sizeof(Material_Id) + 1),
+  };
+
+  char wall_path[MAX_PATH_LENGTH];
+  char floor_path[MAX_PATH_LENGTH];
+  char binary_path[MAX_PATH_LENGTH];
+  snprintf(wall_path, sizeof(wall_path), "%s/w-%zu.csv", options->out_dir,
+           side);
+  snprintf(floor_path, sizeof(floor_path), "%s/f-%zu.csv", options->out_dir,
+           side);
+  snprintf(binary_path, sizeof(binary_path), "%s/level-%zu.tmap",
+           options->out_dir, side);
+
+  reset_peak_rss();
+  Tile_Map *tile_map = NULL;
+  if (out_result->cell_count <= options->csv_max_cells) {
+    if (!write_synth_level_csv(&params, wall_path, floor_path)) {
+      return false;
+    }
+    double       start      = get_bench_seconds();
+    Jagged_Grid *wall_grid  = read_grid_csv_file(wall_path);
+    Jagged_Grid *floor_grid = read_grid_csv_file(floor_path);
+    tile_map = create_tile_map(floor_grid, wall_grid, world_objects_container);
+    free_jagged_grid(wall_grid);
+    free_jagged_grid(floor_grid);
+    out_result->csv_load_ms = (get_bench_seconds() - start) * 1000.0;
+    remove(wall_path);
+    remove(floor_path);
+  } else {
+    tile_map = create_synth_tile_map(&params, world_objects_container);
+  }
+  if (!tile_map ||
+      !write_tile_map_file(binary_path, tile_map, world_objects_container)) {
+    free_tile_map(tile_map);
+    return false;
+  }
+  free_tile_map(tile_map);
+
+  double start = get_bench_seconds();
+  tile_map     = read_tile_map_file(binary_path, world_objects_container);
+  out_result->binary_load_ms = (get_bench_seconds() - start) * 1000.0;
+  remove(binary_path);
+  if (!tile_map) {
+    return false;
+  }
+
+  measure_frames(options, tile_map, out_result);
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  out_result->peak_rss_kb = usage.ru_maxrss;
+  free_tile_map(tile_map);
+  return true;
+}
+
+static void measure_frames(const Scaling_Options *options,
+                           const Tile_Map *tile_map,
+                           Scaling_Result *out_result) {
+  size_t open_count = 0;
+  size_t cell_count = tile_map->width * tile_map->height;
+  for (size_t i = 0; i < cell_count; i++) {
+    open_count += tile_map->collision_bits[i] == 0;
+  }
+  out_result->open_fraction = (double)open_count / cell_count;
+
+  Bench_Camera *cameras = malloc(options->frame_count * sizeof(Bench_Camera));
+  if (!cameras) {
+    return;
+  }
+  place_bench_cameras(tile_map, options->seed, cameras, options->frame_count);
+
+  double per_frame = 1000.0 / options->frame_count;
+  out_result->traversal_ms =
+      time_traversal(tile_map, cameras, options->frame_count,
+                     VIEW_DISTANCE_DEFAULT) *
+      per_frame;
+  out_result->traversal_far_ms =
+      time_traversal(tile_map, cameras, options->frame_count,
+                     (tile_map->width + tile_map->height) * GRID_CELL_SIZE) *
+      per_frame;
+  out_result->floor_cast_ms =
+      time_floor_cast(tile_map, cameras, options->frame_count) * per_frame;
+  out_result->collision_ms =
+      time_collision(tile_map, cameras, options->frame_count) * per_frame;
+  free(cameras);
+}
+
+// Random open cells spread over the whole map, the same for every run
+static void place_bench_cameras(const Tile_Map *tile_map, uint64_t seed,
+                                Bench_Camera *cameras, size_t length) {
+  uint64_t state = seed * 0x9E3779B97F4A7C15ull + 1;
+  for (size_t i = 0; i < length; i++) {
+    size_t x = tile_map->width / 2;
+    size_t y = tile_map->height / 2;
+    for (int attempt = 0; attempt < 64; attempt++) {
+      state ^= state << 13;
+      state ^= state >> 7;
+      state ^= state << 17;
+      size_t try_x = (state & 0xFFFFFFFF) % tile_map->width;
+      size_t try_y = (state >> 32) % tile_map->height;
+      if (tile_map->collision_bits[try_y * tile_map->width + try_x] == 0) {
+        x = try_x;
+        y = try_y;
+        break;
+      }
+    }
+    cameras[i] = (Bench_Camera){
+        .position = {
+            .x = (x + 0.5f) * GRID_CELL_SIZE,
+            .y = (y + 0.5f) * GRID_CELL_SIZE,
+        },
+        .angle = (state >> 16) % 360,
+    };
+  }
+}
+
+// A BENCH_VIEW_W column fan of rays per frame, seconds for all frames
+static double time_traversal(const Tile_Map *tile_map,
+                             const Bench_Camera *cameras, size_t frame_count,
+                             Scalar max_distance) {
+  Raycast_Query queries[BENCH_VIEW_W];
+  Raycast_Hit   hits[BENCH_VIEW_W];
+  uint64_t      sink  = 0;
+  double        start = get_bench_seconds();
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    for (int x = 0; x < BENCH_VIEW_W; x++) {
+      float   offset  = ((float)x / BENCH_VIEW_W - 0.5f) * PLAYER_FOV_DEG;
+      Radians radians = convert_deg_to_rads(cameras[frame].angle + offset);
+      queries[x]      = (Raycast_Query){
+          .origin         = cameras[frame].position,
+          .direction      = {.x = cosf(radians), .y = sinf(radians)},
+          .max_distance   = max_distance,
+          .collision_mask = COLLISION_MODE_WALL,
+      };
+    }
+    cast_tile_rays(tile_map, queries, hits, BENCH_VIEW_W);
+    sink += hits[frame % BENCH_VIEW_W].cell.x;
+  }
+  bench_sink = sink;
+  return get_bench_seconds() - start;
+}
+
+/*
+ * The floor reads of draw_indexed_floor: every row below the horizon out to
+ * the view distance, one floor id per pixel.
+ */
+static double time_floor_cast(const Tile_Map *tile_map,
+                              const Bench_Camera *cameras,
+                              size_t              frame_count) {
+  Fog      fog         = create_fog(VIEW_DISTANCE_DEFAULT);
+  int      h           = BENCH_VIEW_H;
+  int      fog_start_y = get_fog_floor_start_y(&fog, h);
+  uint64_t sink        = 0;
+  double   start       = get_bench_seconds();
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    Point_2D position = cameras[frame].position;
+    for (int x = 0; x < BENCH_VIEW_W; x++) {
+      float   offset    = ((float)x / BENCH_VIEW_W - 0.5f) * PLAYER_FOV_DEG;
+      Radians radians   = convert_deg_to_rads(cameras[frame].angle + offset);
+      Scalar  cos_theta = cosf(convert_deg_to_rads(offset));
+      Vector_1D x_dir   = cosf(radians) / cos_theta;
+      Vector_1D y_dir   = sinf(radians) / cos_theta;
+      for (int y = fog_start_y; y < h; y++) {
+        Scalar   distance = ((h / 2.0f) / (y - h / 2.0f)) * GRID_CELL_SIZE;
+        Point_1D world_x  = position.x + x_dir * distance;
+        Point_1D world_y  = position.y + y_dir * distance;
+        if (world_x < 0 || world_y < 0) {
+          continue;
+        }
+        size_t grid_x = (size_t)(world_x / GRID_CELL_SIZE);
+        size_t grid_y = (size_t)(world_y / GRID_CELL_SIZE);
+        if (grid_x >= tile_map->width || grid_y >= tile_map->height) {
+          continue;
+        }
+        sink += tile_map->floor_ids[grid_y * tile_map->width + grid_x];
+      }
+    }
+  }
+  bench_sink = sink;
+  return get_bench_seconds() - start;
+}
+
+// BENCH_COLLISION_BODIES player sized bodies moving up to a cell a frame
+static double time_collision(const Tile_Map *tile_map,
+                             const Bench_Camera *cameras,
+                             size_t              frame_count) {
+  Collision_Body bodies[BENCH_COLLISION_BODIES];
+  double         seconds = 0;
+  for (size_t frame = 0; frame < frame_count; frame++) {
+    for (size_t i = 0; i < BENCH_COLLISION_BODIES; i++) {
+      const Bench_Camera *camera = &cameras[(frame + i) % frame_count];
+      Radians radians = convert_deg_to_rads(camera->angle + i);
+      bodies[i]       = (Collision_Body){
+          .position       = camera->position,
+          .size           = {.x = PLAYER_W, .y = PLAYER_H},
+          .displacement   = {
+              .x = cosf(radians) * GRID_CELL_SIZE,
+              .y = sinf(radians) * GRID_CELL_SIZE,
+          },
+          .collision_mask = COLLISION_MODE_WALL,
+      };
+    }
+    double start = get_bench_seconds();
+    sweep_collision_bodies(tile_map, bodies, BENCH_COLLISION_BODIES);
+    seconds += get_bench_seconds() - start;
+  }
+  bench_sink = (uint64_t)bodies[0].position.x;
+  return seconds;
+}
+
+static void print_scaling_result(const Scaling_Result *result) {
+  printf("%6zu ", result->side);
+  if (result->csv_load_ms >= 0) {
+    printf("%10.2f ", result->csv_load_ms);
+  } else {
+    printf("%10s ", "-");
+  }
+  printf("%10.2f %10.1f %10.1f %10.3f %10.3f %10.3f %10.3f %10.2f\n",
+         result->binary_load_ms,
+         result->tile_map_bytes / (1024.0 * 1024.0),
+         result->peak_rss_kb / 1024.0, result->traversal_ms,
+         result->traversal_far_ms, result->floor_cast_ms,
+         result->collision_ms, result->open_fraction);
+}
+
+static bool write_scaling_csv(const char *path, const Scaling_Result *results,
+                              size_t length) {
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not open %s\n", path);
+    return false;
+  }
+  fprintf(file, "side,cells,csv_load_ms,binary_load_ms,tile_map_bytes,"
+                "peak_rss_kb,traversal_ms,traversal_far_ms,floor_cast_ms,"
+                "collision_ms,open_fraction\n");
+  for (size_t i = 0; i < length; i++) {
+    const Scaling_Result *result = &results[i];
+    fprintf(file, "%zu,%zu,", result->side, result->cell_count);
+    if (result->csv_load_ms >= 0) {
+      fprintf(file, "%.3f", result->csv_load_ms);
+    }
+    fprintf(file, ",%.3f,%zu,%ld,%.4f,%.4f,%.4f,%.4f,%.4f\n",
+            result->binary_load_ms, result->tile_map_bytes,
+            result->peak_rss_kb, result->traversal_ms,
+            result->traversal_far_ms, result->floor_cast_ms,
+            result->collision_ms, result->open_fraction);
+  }
+  return fclose(file) == 0;
+}
+
+static bool write_scaling_json(const char *path, const Scaling_Options *options,
+                               const Scaling_Result *results, size_t length) {
+  FILE *file = fopen(path, "w");
+  if (!file) {
+    fprintf(stderr, "Could not open %s\n", path);
+    return false;
+  }
+  fprintf(file,
+          "{\n  \"wall_density\": %.3f,\n  \"material_count\": %zu,\n"
+          "  \"frame_count\": %zu,\n  \"view_w\": %d,\n  \"view_h\": %d,\n"
+          "  \"collision_bodies\": %d,\n  \"seed\": %llu,\n  \"results\": [\n",
+          options->wall_density, options->material_count,
+          options->frame_count, BENCH_VIEW_W, BENCH_VIEW_H,
+          BENCH_COLLISION_BODIES, (unsigned long long)options->seed);
+  for (size_t i = 0; i < length; i++) {
+    const Scaling_Result *result = &results[i];
+    fprintf(file, "    {\"side\": %zu, \"cells\": %zu, \"csv_load_ms\": ",
+            result->side, result->cell_count);
+    print_json_number(file, result->csv_load_ms);
+    fprintf(file, ", \"binary_load_ms\": ");
+    print_json_number(file, result->binary_load_ms);
+    fprintf(file,
+            ", \"tile_map_bytes\": %zu, \"peak_rss_kb\": %ld, "
+            "\"traversal_ms\": %.4f, \"traversal_far_ms\": %.4f, "
+            "\"floor_cast_ms\": %.4f, \"collision_ms\": %.4f, "
+            "\"open_fraction\": %.4f}%s\n",
+            result->tile_map_bytes, result->peak_rss_kb, result->traversal_ms,
+            result->traversal_far_ms, result->floor_cast_ms,
+            result->collision_ms, result->open_fraction,
+            i + 1 < length ? "," : "");
+  }
+  fprintf(file, "  ]\n}\n");
+  return fclose(file) == 0;
+}
+
+// Negative means not measured
+static void print_json_number(FILE *file, double value) {
+  if (value < 0) {
+    fprintf(file, "null");
+  } else {
+    fprintf(file, "%.3f", value);
+  }
+}
@@ -0,0 +1,142 @@
+#include "./synth-level.h"
+
+static uint64_t hash_synth_cell(uint64_t seed, size_t x, size_t y);
+static bool get_synth_cell(const Synth_Level_Params *params, size_t x,
+                           size_t y, size_t *out_wall, size_t *out_floor);
+
+/*
+ * Texture-less stand ins for the manifest: material_count solid walls
+ * "synth-wall-N" followed by as many walkable floors "synth-floor-N", all in
+ * SYNTH_MATERIAL_CATEGORY. Enough for the tile map, procgen, collision and
+ * traversal, which never touch pixels.
+ */
+extern World_Objects_Container *create_synth_materials(size_t material_count) {
+  World_Objects_Container *world_objects_container =
+      calloc(1, sizeof(World_Objects_Container));
+  if (!world_objects_container) {
+    return NULL;
+  }
+  world_objects_container->data =
+      calloc(material_count * 2, sizeof(World_Object *));
+  if (!world_objects_container->data) {
+    free(world_objects_container);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < material_count * 2; i++) {
+    World_Object *world_object = calloc(1, sizeof(World_Object));
+    char         *name         = malloc(SYNTH_MATERIAL_NAME_LENGTH);
+    if (!world_object || !name) {
+      free(world_object);
+      free(name);
+      free_synth_materials(world_objects_container);
+      return NULL;
+    }
+    bool is_wall = i < material_count;
+    snprintf(name, SYNTH_MATERIAL_NAME_LENGTH, "synth-%s-%zu",
+             is_wall ? "wall" : "floor", i % material_count);
+    world_object->name           = name;
+    world_object->category       = SYNTH_MATERIAL_CATEGORY;
+    world_object->surface_type   = is_wall ? COLLISION_MODE_WALL
+                                           : COLLISION_MODE_FLOOR;
+    world_object->collision_mode = is_wall ? COLLISION_MODE_WALL : 0;
+    world_objects_container->data[world_objects_container->length++] =
+        world_object;
+  }
+  return world_objects_container;
+}
+
+extern void
+free_synth_materials(World_Objects_Container *world_objects_container) {
+  if (!world_objects_container) {
+    return;
+  }
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    free(world_objects_container->data[i]->name);
+    free(world_objects_container->data[i]);
+  }
+  free(world_objects_container->data);
+  free(world_objects_container);
+}
+
+// The same cells create_synth_tile_map builds, as a wall and a floor CSV
+extern bool write_synth_level_csv(const Synth_Level_Params *params,
+                                  const char               *wall_path,
+                                  const char               *floor_path) {
+  FILE *wall_file  = fopen(wall_path, "w");
+  FILE *floor_file = fopen(floor_path, "w");
+  if (!wall_file || !floor_file) {
+    fprintf(stderr, "Could not open %s or %s\n", wall_path, floor_path);
+    if (wall_file) {
+      fclose(wall_file);
+    }
+    if (floor_file) {
+      fclose(floor_file);
+    }
+    return false;
+  }
+
+  for (size_t y = 0; y < params->height; y++) {
+    for (size_t x = 0; x < params->width; x++) {
+      size_t wall_index;
+      size_t floor_index;
+      const char *separator = x + 1 < params->width ? "," : "\n";
+      if (get_synth_cell(params, x, y, &wall_index, &floor_index)) {
+        fprintf(wall_file, "synth-wall-%zu%s", wall_index, separator);
+      } else {
+        fputs(separator, wall_file);
+      }
+      fprintf(floor_file, "synth-floor-%zu%s", floor_index, separator);
+    }
+  }
+
+  bool is_ok = !ferror(wall_file) && !ferror(floor_file);
+  is_ok      = (fclose(wall_file) == 0) && is_ok;
+  is_ok      = (fclose(floor_file) == 0) && is_ok;
+  return is_ok;
+}
+
+// Straight to a tile map, for sizes where the CSV round trip is too costly
+extern Tile_Map *
+create_synth_tile_map(const Synth_Level_Params      *params,
+                      const World_Objects_Container *world_objects_container) {
+  Tile_Map *tile_map = create_blank_tile_map(params->width, params->height,
+                                             world_objects_container);
+  if (!tile_map) {
+    return NULL;
+  }
+  for (size_t y = 0; y < params->height; y++) {
+    for (size_t x = 0; x < params->width; x++) {
+      size_t cell = y * params->width + x;
+      size_t wall_index;
+      size_t floor_index;
+      bool   is_wall = get_synth_cell(params, x, y, &wall_index, &floor_index);
+      tile_map->wall_ids[cell]  = is_wall ? (Material_Id)wall_index
+                                          : MATERIAL_ID_EMPTY;
+      tile_map->floor_ids[cell] =
+          (Material_Id)(params->material_count + floor_index);
+    }
+  }
+  resolve_tile_collision_bits(tile_map, world_objects_container);
+  return tile_map;
+}
+
+// splitmix64 finalizer
+static uint64_t hash_synth_cell(uint64_t seed, size_t x, size_t y) {
+  uint64_t h = seed ^ ((uint64_t)x * 0x9E3779B97F4A7C15ull) ^
+               ((uint64_t)y * 0xC2B2AE3D27D4EB4Full);
+  h          = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h          = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return h ^ (h >> 31);
+}
+
+static bool get_synth_cell(const Synth_Level_Params *params, size_t x,
+                           size_t y, size_t *out_wall, size_t *out_floor) {
+  uint64_t h       = hash_synth_cell(params->seed, x, y);
+  bool     is_edge = x == 0 || y == 0 || x + 1 == params->width ||
+                 y + 1 == params->height;
+  *out_wall        = (h >> 8) % params->material_count;
+  *out_floor       = (h >> 24) % params->material_count;
+  return is_edge ||
+         (h >> 40) * (1.0f / (1 << 24)) < params->wall_density;
+}
@@ -0,0 +1,22 @@
+#ifndef SYNTH_LEVEL_H
+#define SYNTH_LEVEL_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../assets/textures/constants.h"
+#include "../assets/textures/types.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/tile-map.h"
+#include "../data/grid/types.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern World_Objects_Container *create_synth_materials(size_t material_count);
+extern void free_synth_materials(World_Objects_Container *world_objects_container);
+extern bool write_synth_level_csv(const Synth_Level_Params *params, const char *wall_path, const char *floor_path);
+extern Tile_Map *create_synth_tile_map(const Synth_Level_Params *params, const World_Objects_Container *world_objects_container);
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef BENCH_TYPES_H
+#define BENCH_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct Synth_Level_Params {
+  size_t   width;
+  size_t   height;
+  uint64_t seed;
+  float    wall_density;   // chance of a wall per cell, the border is always wall
+  size_t   material_count; // distinct wall and floor materials each
+} Synth_Level_Params;
+
+// One row of the procgen table, per side and algorithm
+typedef struct Procgen_Bench_Result {
+  size_t      side;
+  const char *algorithm;
+  double      pool_ms;   // on the worker pool
+  double      single_ms; // on the calling thread alone
+  double      open_fraction;
+  uint64_t    hash;
+  bool        is_deterministic; // same hash on the pool, alone and by chunk
+} Procgen_Bench_Result;
+
+// One row of the scaling table, negative times were not measured
+typedef struct Scaling_Result {
+  size_t side;
+  size_t cell_count;
+  double csv_load_ms;
+  double binary_load_ms;
+  size_t tile_map_bytes;
+  long   peak_rss_kb;
+  double traversal_ms;     // rays stopped at the view distance, per frame
+  double traversal_far_ms; // rays allowed to cross the whole map, per frame
+  double floor_cast_ms;    // per frame
+  double collision_ms;     // BENCH_COLLISION_BODIES sweeps, per frame
+  double open_fraction;
+} Scaling_Result;
+
+// One call of a microbenchmarked kernel, doing ops_per_call units of work
+typedef void (*Bench_Kernel)(void *context);
+
+typedef struct Bench_Config {
+  size_t warmup_repetitions;
+  size_t repetitions;
+  double min_repetition_seconds; // calls are batched until a repetition lasts this long
+  int    cpu;                    // pinned to, or -1 to leave unpinned
+} Bench_Config;
+
+// Nanoseconds per op over the repetitions
+typedef struct Bench_Stats {
+  double min_ns;
+  double median_ns;
+  double p95_ns;
+  double mean_ns;
+  double stddev_ns;
+  size_t calls_per_repetition;
+} Bench_Stats;
+
+#endif
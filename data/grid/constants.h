@@ -3,5 +3,19 @@
 
 #define EMPTY_GRID_CELL_VALUE "EMPTY"
 #define GRID_CELL_SIZE 64.0f
+#define MATERIAL_ID_EMPTY 0xFFFF
+#define MATERIAL_FLAG_OPAQUE (1 << 0)
+
+// Translucent hits recorded per ray, including the terminating opaque hit
+#define MAX_RAY_HITS 4
+
+// Potentially visible set precomputation
+#define PVS_NO_SET 0xFFFFFFFFu
+#define PVS_MAX_CELLS 16384 // bitsets grow with cells^2, skip PVS above this
+
+// Lightmap levels, flood filled from light sources losing one level per cell
+#define LIGHT_LEVEL_MAX 15
+#define LIGHT_LEVEL_AMBIENT 4 // floor applied when sampling
+#define LIGHT_RADIUS (LIGHT_LEVEL_MAX - 1) // furthest cell a light can reach
 
 #endif
\ No newline at end of file
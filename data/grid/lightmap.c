@@ -0,0 +1,229 @@
+#include "./lightmap.h"
+
+static bool is_cell_light_blocker(const Tile_Map *tile_map, size_t cell);
+static void push_light_cell(Lightmap *lightmap, size_t *tail, size_t cell);
+static void relight_lightmap_region(Lightmap *lightmap, const Tile_Map *tile_map,
+                                    int min_x, int min_y, int max_x, int max_y);
+
+/*
+ * Light sources come from an optional level layer where a cell holds its
+ * light level (1..LIGHT_LEVEL_MAX), anything else is unlit. The whole map is
+ * baked once here, later changes only relight the cells around them. Without
+ * a layer there is no lightmap, NULL samples as full brightness.
+ */
+extern Lightmap *create_lightmap(const Tile_Map    *tile_map,
+                                 const Jagged_Grid *light_grid) {
+  if (!tile_map || !light_grid) {
+    return NULL;
+  }
+
+  Lightmap *lightmap = calloc(1, sizeof(Lightmap));
+  if (!lightmap) {
+    return NULL;
+  }
+
+  size_t cell_count   = tile_map->width * tile_map->height;
+  lightmap->width     = tile_map->width;
+  lightmap->height    = tile_map->height;
+  lightmap->levels    = calloc(cell_count, sizeof(uint8_t));
+  lightmap->queue     = malloc((cell_count + 1) * sizeof(size_t));
+  lightmap->is_queued = calloc(cell_count, sizeof(uint8_t));
+  if ((!lightmap->levels || !lightmap->queue || !lightmap->is_queued) &&
+      cell_count > 0) {
+    free_lightmap(lightmap);
+    return NULL;
+  }
+
+  for (size_t y = 0; y < light_grid->length; y++) {
+    const Jagged_Row *row = &light_grid->rows[y];
+    for (size_t x = 0; x < row->length; x++) {
+      char *end;
+      long  level = strtol(row->world_object_names[x], &end, 10);
+      if (end == row->world_object_names[x] || level <= 0) {
+        continue;
+      }
+
+      size_t capacity = lightmap->source_capacity;
+      if (lightmap->source_count == capacity) {
+        capacity = capacity ? capacity * 2 : 8;
+        Light_Source *sources =
+            realloc(lightmap->sources, capacity * sizeof(Light_Source));
+        if (!sources) {
+          free_lightmap(lightmap);
+          return NULL;
+        }
+        lightmap->sources         = sources;
+        lightmap->source_capacity = capacity;
+      }
+      lightmap->sources[lightmap->source_count++] = (Light_Source){
+          .cell.x = x,
+          .cell.y = y,
+          .level  = level > LIGHT_LEVEL_MAX ? LIGHT_LEVEL_MAX : level,
+      };
+    }
+  }
+
+  relight_lightmap_region(lightmap, tile_map, 0, 0, (int)lightmap->width - 1,
+                          (int)lightmap->height - 1);
+  return lightmap;
+}
+
+extern bool add_light_source(Lightmap *lightmap, const Tile_Map *tile_map,
+                             Light_Source source) {
+  if (lightmap->source_count == lightmap->source_capacity) {
+    size_t capacity =
+        lightmap->source_capacity ? lightmap->source_capacity * 2 : 8;
+    Light_Source *sources =
+        realloc(lightmap->sources, capacity * sizeof(Light_Source));
+    if (!sources) {
+      return false;
+    }
+    lightmap->sources         = sources;
+    lightmap->source_capacity = capacity;
+  }
+
+  lightmap->sources[lightmap->source_count++] = source;
+  relight_lightmap_cell(lightmap, tile_map, source.cell.x, source.cell.y);
+  return true;
+}
+
+// Swap removes, so source indexes past source_index are not stable
+extern void remove_light_source(Lightmap *lightmap, const Tile_Map *tile_map,
+                                size_t source_index) {
+  if (source_index >= lightmap->source_count) {
+    return;
+  }
+
+  IPoint_2D cell = lightmap->sources[source_index].cell;
+  lightmap->sources[source_index] =
+      lightmap->sources[--lightmap->source_count];
+  relight_lightmap_cell(lightmap, tile_map, cell.x, cell.y);
+}
+
+/*
+ * Call after a light or a wall changes at a cell. Nothing further than
+ * LIGHT_RADIUS cells away can be affected, so only that square is relit.
+ */
+extern void relight_lightmap_cell(Lightmap *lightmap, const Tile_Map *tile_map,
+                                  int cell_x, int cell_y) {
+  relight_lightmap_region(lightmap, tile_map, cell_x - LIGHT_RADIUS,
+                          cell_y - LIGHT_RADIUS, cell_x + LIGHT_RADIUS,
+                          cell_y + LIGHT_RADIUS);
+}
+
+extern void free_lightmap(Lightmap *lightmap) {
+  if (!lightmap) {
+    return;
+  }
+  free(lightmap->is_queued);
+  free(lightmap->queue);
+  free(lightmap->sources);
+  free(lightmap->levels);
+  free(lightmap);
+}
+
+static bool is_cell_light_blocker(const Tile_Map *tile_map, size_t cell) {
+  Material_Id wall_id = tile_map->wall_ids[cell];
+  return wall_id != MATERIAL_ID_EMPTY &&
+         (tile_map->material_flags[wall_id] & MATERIAL_FLAG_OPAQUE);
+}
+
+static void push_light_cell(Lightmap *lightmap, size_t *tail, size_t cell) {
+  if (lightmap->is_queued[cell]) {
+    return;
+  }
+  size_t slot_count         = lightmap->width * lightmap->height + 1;
+  lightmap->is_queued[cell] = 1;
+  lightmap->queue[*tail]    = cell;
+  *tail                     = (*tail + 1) % slot_count;
+}
+
+/*
+ * Clears the (inclusive) region and flood fills it again. Seeds are the
+ * sources inside it plus the lit ring of cells just outside, which stand in
+ * for every light beyond the region. A cell is only re-queued when its level
+ * rises, and is never in the ring twice, so one slot per cell (plus one) is enough.
+ */
+static void relight_lightmap_region(Lightmap *lightmap, const Tile_Map *tile_map,
+                                    int min_x, int min_y, int max_x, int max_y) {
+  int width  = (int)lightmap->width;
+  int height = (int)lightmap->height;
+  if (width == 0 || height == 0) {
+    return;
+  }
+
+  int ring_min_x = min_x - 1;
+  int ring_min_y = min_y - 1;
+  int ring_max_x = max_x + 1;
+  int ring_max_y = max_y + 1;
+  min_x          = min_x < 0 ? 0 : min_x;
+  min_y          = min_y < 0 ? 0 : min_y;
+  max_x          = max_x >= width ? width - 1 : max_x;
+  max_y          = max_y >= height ? height - 1 : max_y;
+
+  for (int y = min_y; y <= max_y; y++) {
+    memset(&lightmap->levels[(size_t)y * width + min_x], 0, max_x - min_x + 1);
+  }
+
+  size_t head = 0;
+  size_t tail = 0;
+  for (size_t i = 0; i < lightmap->source_count; i++) {
+    const Light_Source *source = &lightmap->sources[i];
+    if (source->cell.x < min_x || source->cell.x > max_x ||
+        source->cell.y < min_y || source->cell.y > max_y) {
+      continue;
+    }
+    size_t cell = (size_t)source->cell.y * width + source->cell.x;
+    if (source->level > lightmap->levels[cell]) {
+      lightmap->levels[cell] = source->level;
+      push_light_cell(lightmap, &tail, cell);
+    }
+  }
+
+  for (int y = ring_min_y; y <= ring_max_y; y++) {
+    for (int x = ring_min_x; x <= ring_max_x; x++) {
+      bool is_ring = y == ring_min_y || y == ring_max_y || x == ring_min_x ||
+                     x == ring_max_x;
+      if (!is_ring) {
+        x = ring_max_x - 1;
+        continue;
+      }
+      if (x < 0 || y < 0 || x >= width || y >= height) {
+        continue;
+      }
+      size_t cell = (size_t)y * width + x;
+      if (lightmap->levels[cell] > 1) {
+        push_light_cell(lightmap, &tail, cell);
+      }
+    }
+  }
+
+  static const int neighbour_offsets[4][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+  size_t           slot_count = (size_t)width * height + 1;
+  while (head != tail) {
+    size_t cell               = lightmap->queue[head];
+    head                      = (head + 1) % slot_count;
+    lightmap->is_queued[cell] = 0;
+
+    uint8_t level = lightmap->levels[cell];
+    if (level <= 1 || is_cell_light_blocker(tile_map, cell)) {
+      continue;
+    }
+
+    int cell_x = (int)(cell % width);
+    int cell_y = (int)(cell / width);
+    for (int i = 0; i < 4; i++) {
+      int next_x = cell_x + neighbour_offsets[i][0];
+      int next_y = cell_y + neighbour_offsets[i][1];
+      if (next_x < min_x || next_y < min_y || next_x > max_x ||
+          next_y > max_y) {
+        continue;
+      }
+      size_t next = (size_t)next_y * width + next_x;
+      if (lightmap->levels[next] < level - 1) {
+        lightmap->levels[next] = level - 1;
+        push_light_cell(lightmap, &tail, next);
+      }
+    }
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef LIGHTMAP_H
+#define LIGHTMAP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../types/algebraic-types.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Lightmap *create_lightmap(const Tile_Map    *tile_map,
+                                 const Jagged_Grid *light_grid);
+extern bool add_light_source(Lightmap *lightmap, const Tile_Map *tile_map,
+                             Light_Source source);
+extern void remove_light_source(Lightmap *lightmap, const Tile_Map *tile_map,
+                                size_t source_index);
+extern void relight_lightmap_cell(Lightmap *lightmap, const Tile_Map *tile_map,
+                                  int cell_x, int cell_y);
+extern void free_lightmap(Lightmap *lightmap);
+
+// Full brightness without a lightmap, ambient outside the map
+static inline uint8_t sample_lightmap(const Lightmap *lightmap, int cell_x,
+                                      int cell_y) {
+  if (!lightmap) {
+    return LIGHT_LEVEL_MAX;
+  }
+  if (cell_x < 0 || cell_y < 0 || (size_t)cell_x >= lightmap->width ||
+      (size_t)cell_y >= lightmap->height) {
+    return LIGHT_LEVEL_AMBIENT;
+  }
+  uint8_t level = lightmap->levels[(size_t)cell_y * lightmap->width + cell_x];
+  return level > LIGHT_LEVEL_AMBIENT ? level : LIGHT_LEVEL_AMBIENT;
+}
+
+#endif
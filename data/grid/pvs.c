@@ -0,0 +1,327 @@
+#include "./pvs.h"
+
+static bool is_cell_occluder(const Tile_Map *tile_map, size_t cell);
+static bool create_field_of_view(PVS_Field_Of_View *field_of_view,
+                                 size_t cell_count, size_t words_per_set);
+static void free_field_of_view(PVS_Field_Of_View *field_of_view);
+static void compute_field_of_view(const Tile_Map    *tile_map,
+                                  PVS_Field_Of_View *field_of_view,
+                                  size_t words_per_set, IPoint_1D source_x,
+                                  IPoint_1D source_y);
+static void scan_quadrant(const Tile_Map *tile_map,
+                          PVS_Field_Of_View *field_of_view, IPoint_1D source_x,
+                          IPoint_1D source_y, IVector_1D dir_x,
+                          IVector_1D dir_y);
+static void visit_quadrant_cell(const Tile_Map    *tile_map,
+                                PVS_Field_Of_View *field_of_view,
+                                IPoint_1D source_x, IPoint_1D source_y,
+                                IVector_1D dir_x, IVector_1D dir_y, IPoint_1D x,
+                                IPoint_1D y, size_t *view_index);
+static void mark_visible_cell(PVS_Field_Of_View *field_of_view, size_t cell);
+static void add_shallow_bump(PVS_Field_Of_View *field_of_view, PVS_View *view,
+                             IPoint_2D point);
+static void add_steep_bump(PVS_Field_Of_View *field_of_view, PVS_View *view,
+                           IPoint_2D point);
+static bool check_view(PVS_Field_Of_View *field_of_view, size_t view_index);
+static void remove_view(PVS_Field_Of_View *field_of_view, size_t view_index);
+static int64_t get_line_side(const ILine_2D *line, IPoint_2D point);
+
+/*
+ * Load time PVS. A cell is visible from an open cell when some line from
+ * anywhere inside the open cell reaches anywhere inside it without crossing an
+ * occluder (a precise permissive field of view, scanned one quadrant at a
+ * time). Lines may graze occluder edges and corners, so the set only ever
+ * over-approximates what the renderer's rays can reach. Every visible cell is
+ * then dilated by one cell, so a sprite standing in a hidden cell still counts
+ * when its billboard reaches into a visible one.
+ */
+extern Potentially_Visible_Set *
+create_potentially_visible_set(const Tile_Map *tile_map) {
+  if (!tile_map) {
+    return NULL;
+  }
+
+  size_t cell_count = tile_map->width * tile_map->height;
+  if (cell_count == 0 || cell_count > PVS_MAX_CELLS) {
+    return NULL;
+  }
+
+  Potentially_Visible_Set *pvs = calloc(1, sizeof(Potentially_Visible_Set));
+  if (!pvs) {
+    return NULL;
+  }
+  pvs->width         = tile_map->width;
+  pvs->height        = tile_map->height;
+  pvs->words_per_set = (cell_count + 63) / 64;
+  pvs->set_indexes   = malloc(cell_count * sizeof(uint32_t));
+  if (!pvs->set_indexes) {
+    free_potentially_visible_set(pvs);
+    return NULL;
+  }
+
+  uint32_t set_count = 0;
+  for (size_t i = 0; i < cell_count; i++) {
+    pvs->set_indexes[i] =
+        is_cell_occluder(tile_map, i) ? PVS_NO_SET : set_count++;
+  }
+
+  pvs->bits = calloc((size_t)set_count * pvs->words_per_set, sizeof(uint64_t));
+  PVS_Field_Of_View field_of_view;
+  if ((!pvs->bits && set_count > 0) ||
+      !create_field_of_view(&field_of_view, cell_count, pvs->words_per_set)) {
+    free_potentially_visible_set(pvs);
+    return NULL;
+  }
+
+  for (size_t cell = 0; cell < cell_count; cell++) {
+    uint32_t set_index = pvs->set_indexes[cell];
+    if (set_index == PVS_NO_SET) {
+      continue;
+    }
+
+    compute_field_of_view(tile_map, &field_of_view, pvs->words_per_set,
+                          cell % tile_map->width, cell / tile_map->width);
+    uint64_t *set = &pvs->bits[set_index * pvs->words_per_set];
+    for (size_t i = 0; i < field_of_view.visible_count; i++) {
+      IPoint_1D visible_x = field_of_view.visible_cells[i] % tile_map->width;
+      IPoint_1D visible_y = field_of_view.visible_cells[i] / tile_map->width;
+      for (IPoint_1D y = visible_y - 1; y <= visible_y + 1; y++) {
+        for (IPoint_1D x = visible_x - 1; x <= visible_x + 1; x++) {
+          if (x < 0 || y < 0 || (size_t)x >= tile_map->width ||
+              (size_t)y >= tile_map->height) {
+            continue;
+          }
+          size_t neighbour = (size_t)y * tile_map->width + x;
+          set[neighbour >> 6] |= 1ull << (neighbour & 63);
+        }
+      }
+    }
+  }
+
+  free_field_of_view(&field_of_view);
+  return pvs;
+}
+
+extern void free_potentially_visible_set(Potentially_Visible_Set *pvs) {
+  if (!pvs) {
+    return;
+  }
+
+  free(pvs->set_indexes);
+  free(pvs->bits);
+  free(pvs);
+}
+
+// Matches the renderer: only opaque wall cells stop a ray
+static bool is_cell_occluder(const Tile_Map *tile_map, size_t cell) {
+  Material_Id wall_id = tile_map->wall_ids[cell];
+  return wall_id != MATERIAL_ID_EMPTY &&
+         (tile_map->material_flags[wall_id] & MATERIAL_FLAG_OPAQUE);
+}
+
+/*
+ * A quadrant holds at most every cell of the map, each blocked cell splits
+ * off at most one view and bends at most two lines.
+ */
+static bool create_field_of_view(PVS_Field_Of_View *field_of_view,
+                                 size_t cell_count, size_t words_per_set) {
+  *field_of_view = (PVS_Field_Of_View){
+      .views         = malloc((cell_count + 1) * sizeof(PVS_View)),
+      .bumps         = malloc(2 * cell_count * sizeof(PVS_Bump)),
+      .visible_bits  = malloc(words_per_set * sizeof(uint64_t)),
+      .visible_cells = malloc(cell_count * sizeof(uint32_t)),
+  };
+  if (!field_of_view->views || !field_of_view->bumps ||
+      !field_of_view->visible_bits || !field_of_view->visible_cells) {
+    free_field_of_view(field_of_view);
+    return false;
+  }
+  return true;
+}
+
+static void free_field_of_view(PVS_Field_Of_View *field_of_view) {
+  free(field_of_view->views);
+  free(field_of_view->bumps);
+  free(field_of_view->visible_bits);
+  free(field_of_view->visible_cells);
+}
+
+static void compute_field_of_view(const Tile_Map    *tile_map,
+                                  PVS_Field_Of_View *field_of_view,
+                                  size_t words_per_set, IPoint_1D source_x,
+                                  IPoint_1D source_y) {
+  memset(field_of_view->visible_bits, 0, words_per_set * sizeof(uint64_t));
+  field_of_view->visible_count = 0;
+  mark_visible_cell(field_of_view,
+                    (size_t)source_y * tile_map->width + source_x);
+
+  // Quadrants share their axis rows and columns, marking is idempotent
+  scan_quadrant(tile_map, field_of_view, source_x, source_y, 1, 1);
+  scan_quadrant(tile_map, field_of_view, source_x, source_y, -1, 1);
+  scan_quadrant(tile_map, field_of_view, source_x, source_y, 1, -1);
+  scan_quadrant(tile_map, field_of_view, source_x, source_y, -1, -1);
+}
+
+/*
+ * Quadrant local cell (x, y) is map cell (source_x + x * dir_x, source_y + y *
+ * dir_y) and covers corners (x, y) to (x + 1, y + 1), so the source cell is
+ * the unit square at the origin. Cells are visited a diagonal (x + y) at a
+ * time, shallowest first, so the views are met in order along each diagonal.
+ */
+static void scan_quadrant(const Tile_Map *tile_map,
+                          PVS_Field_Of_View *field_of_view, IPoint_1D source_x,
+                          IPoint_1D source_y, IVector_1D dir_x,
+                          IVector_1D dir_y) {
+  IPoint_1D extent_x = dir_x > 0 ? (IPoint_1D)tile_map->width - 1 - source_x
+                                 : source_x;
+  IPoint_1D extent_y = dir_y > 0 ? (IPoint_1D)tile_map->height - 1 - source_y
+                                 : source_y;
+  // Far enough out that the first view's lines only set its directions
+  IPoint_1D line_extent = (IPoint_1D)(tile_map->width + tile_map->height);
+
+  field_of_view->bump_count = 0;
+  field_of_view->views[0]   = (PVS_View){
+        .shallow_line = {.start = {0, 1}, .end = {line_extent, 0}},
+        .steep_line   = {.start = {1, 0}, .end = {0, line_extent}},
+        .shallow_bump = -1,
+        .steep_bump   = -1,
+  };
+  field_of_view->view_count = 1;
+
+  for (IPoint_1D diagonal = 1; diagonal <= extent_x + extent_y &&
+                               field_of_view->view_count > 0;
+       diagonal++) {
+    IPoint_1D first_y = diagonal > extent_x ? diagonal - extent_x : 0;
+    IPoint_1D last_y  = diagonal < extent_y ? diagonal : extent_y;
+    size_t    view_index = 0;
+    for (IPoint_1D y = first_y;
+         y <= last_y && view_index < field_of_view->view_count; y++) {
+      visit_quadrant_cell(tile_map, field_of_view, source_x, source_y, dir_x,
+                          dir_y, diagonal - y, y, &view_index);
+    }
+  }
+}
+
+/*
+ * Marks the cell when it falls inside a view. A blocked cell then narrows
+ * that view: it bends the shallow line up past the cell, the steep line down
+ * past it, or splits the view in two around it.
+ */
+static void visit_quadrant_cell(const Tile_Map    *tile_map,
+                                PVS_Field_Of_View *field_of_view,
+                                IPoint_1D source_x, IPoint_1D source_y,
+                                IVector_1D dir_x, IVector_1D dir_y, IPoint_1D x,
+                                IPoint_1D y, size_t *view_index) {
+  IPoint_2D top_left     = {x, y + 1};
+  IPoint_2D bottom_right = {x + 1, y};
+  PVS_View *views        = field_of_view->views;
+
+  while (*view_index < field_of_view->view_count &&
+         get_line_side(&views[*view_index].steep_line, bottom_right) >= 0) {
+    (*view_index)++;
+  }
+  if (*view_index == field_of_view->view_count ||
+      get_line_side(&views[*view_index].shallow_line, top_left) <= 0) {
+    return;
+  }
+
+  size_t cell = (size_t)(source_y + y * dir_y) * tile_map->width +
+                (size_t)(source_x + x * dir_x);
+  mark_visible_cell(field_of_view, cell);
+  if (!is_cell_occluder(tile_map, cell)) {
+    return;
+  }
+
+  PVS_View *view           = &views[*view_index];
+  bool is_shallow_crossing = get_line_side(&view->shallow_line, bottom_right) < 0;
+  bool is_steep_crossing   = get_line_side(&view->steep_line, top_left) > 0;
+  if (is_shallow_crossing && is_steep_crossing) {
+    remove_view(field_of_view, *view_index);
+  } else if (is_shallow_crossing) {
+    add_shallow_bump(field_of_view, view, top_left);
+    check_view(field_of_view, *view_index);
+  } else if (is_steep_crossing) {
+    add_steep_bump(field_of_view, view, bottom_right);
+    check_view(field_of_view, *view_index);
+  } else {
+    memmove(&views[*view_index + 1], &views[*view_index],
+            (field_of_view->view_count - *view_index) * sizeof(PVS_View));
+    field_of_view->view_count++;
+
+    size_t steep_index = *view_index + 1;
+    add_steep_bump(field_of_view, &views[*view_index], bottom_right);
+    if (!check_view(field_of_view, *view_index)) {
+      steep_index--;
+    }
+    add_shallow_bump(field_of_view, &views[steep_index], top_left);
+    check_view(field_of_view, steep_index);
+    *view_index = steep_index;
+  }
+}
+
+static void mark_visible_cell(PVS_Field_Of_View *field_of_view, size_t cell) {
+  uint64_t *word = &field_of_view->visible_bits[cell >> 6];
+  uint64_t  bit  = 1ull << (cell & 63);
+  if (!(*word & bit)) {
+    *word |= bit;
+    field_of_view->visible_cells[field_of_view->visible_count++] =
+        (uint32_t)cell;
+  }
+}
+
+// The shallow line now ends past the cell and starts from the steepest bump
+static void add_shallow_bump(PVS_Field_Of_View *field_of_view, PVS_View *view,
+                             IPoint_2D point) {
+  PVS_Bump *bumps          = field_of_view->bumps;
+  view->shallow_line.end   = point;
+  bumps[field_of_view->bump_count] = (PVS_Bump){point, view->shallow_bump};
+  view->shallow_bump       = (int32_t)field_of_view->bump_count++;
+  for (int32_t i = view->steep_bump; i >= 0; i = bumps[i].parent) {
+    if (get_line_side(&view->shallow_line, bumps[i].point) < 0) {
+      view->shallow_line.start = bumps[i].point;
+    }
+  }
+}
+
+static void add_steep_bump(PVS_Field_Of_View *field_of_view, PVS_View *view,
+                           IPoint_2D point) {
+  PVS_Bump *bumps        = field_of_view->bumps;
+  view->steep_line.end   = point;
+  bumps[field_of_view->bump_count] = (PVS_Bump){point, view->steep_bump};
+  view->steep_bump       = (int32_t)field_of_view->bump_count++;
+  for (int32_t i = view->shallow_bump; i >= 0; i = bumps[i].parent) {
+    if (get_line_side(&view->steep_line, bumps[i].point) > 0) {
+      view->steep_line.start = bumps[i].point;
+    }
+  }
+}
+
+// Drops a view narrowed to a line that only grazes the source cell's corner
+static bool check_view(PVS_Field_Of_View *field_of_view, size_t view_index) {
+  const ILine_2D *shallow_line = &field_of_view->views[view_index].shallow_line;
+  const ILine_2D *steep_line   = &field_of_view->views[view_index].steep_line;
+  bool is_collinear = get_line_side(shallow_line, steep_line->start) == 0 &&
+                      get_line_side(shallow_line, steep_line->end) == 0;
+  if (is_collinear &&
+      (get_line_side(shallow_line, (IPoint_2D){0, 1}) == 0 ||
+       get_line_side(shallow_line, (IPoint_2D){1, 0}) == 0)) {
+    remove_view(field_of_view, view_index);
+    return false;
+  }
+  return true;
+}
+
+static void remove_view(PVS_Field_Of_View *field_of_view, size_t view_index) {
+  field_of_view->view_count--;
+  memmove(&field_of_view->views[view_index],
+          &field_of_view->views[view_index + 1],
+          (field_of_view->view_count - view_index) * sizeof(PVS_View));
+}
+
+// Positive when the point is left of the line, looking from start to end
+static int64_t get_line_side(const ILine_2D *line, IPoint_2D point) {
+  int64_t dx = (int64_t)line->end.x - line->start.x;
+  int64_t dy = (int64_t)line->end.y - line->start.y;
+  return dx * ((int64_t)point.y - line->start.y) -
+         dy * ((int64_t)point.x - line->start.x);
+}
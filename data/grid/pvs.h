@@ -0,0 +1,41 @@
+#ifndef PVS_H
+#define PVS_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../types/algebraic-types.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Potentially_Visible_Set *create_potentially_visible_set(const Tile_Map *tile_map);
+extern void free_potentially_visible_set(Potentially_Visible_Set *pvs);
+
+/*
+ * True when to_cell may be seen from somewhere in from_cell. Without a PVS,
+ * or from a cell that has no set, everything counts as visible.
+ */
+static inline bool is_cell_potentially_visible(const Potentially_Visible_Set *pvs,
+                                               int from_x, int from_y,
+                                               int to_x, int to_y) {
+  if (!pvs || from_x < 0 || from_y < 0 || (size_t)from_x >= pvs->width ||
+      (size_t)from_y >= pvs->height) {
+    return true;
+  }
+  uint32_t set_index = pvs->set_indexes[(size_t)from_y * pvs->width + from_x];
+  if (set_index == PVS_NO_SET) {
+    return true;
+  }
+  if (to_x < 0 || to_y < 0 || (size_t)to_x >= pvs->width ||
+      (size_t)to_y >= pvs->height) {
+    return false;
+  }
+  size_t          cell = (size_t)to_y * pvs->width + to_x;
+  const uint64_t *set  = &pvs->bits[set_index * pvs->words_per_set];
+  return (set[cell >> 6] >> (cell & 63)) & 1;
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "./tile-map.h"
+
+static size_t get_grid_width(const Jagged_Grid *grid);
+static void fill_material_ids(Material_Id *out_ids, size_t width,
+                              size_t height, const Jagged_Grid *grid,
+                              const World_Objects_Container *world_objects_container);
+
+extern Tile_Map *
+create_tile_map(const Jagged_Grid             *floor_grid,
+                const Jagged_Grid             *wall_grid,
+                const World_Objects_Container *world_objects_container) {
+  if (!floor_grid || !wall_grid || !world_objects_container) {
+    return NULL;
+  }
+
+  size_t floor_width = get_grid_width(floor_grid);
+  size_t wall_width  = get_grid_width(wall_grid);
+  size_t width       = floor_width > wall_width ? floor_width : wall_width;
+  size_t height      = floor_grid->length > wall_grid->length
+                           ? floor_grid->length
+                           : wall_grid->length;
+
+  Tile_Map *tile_map =
+      create_blank_tile_map(width, height, world_objects_container);
+  if (!tile_map) {
+    return NULL;
+  }
+
+  fill_material_ids(tile_map->wall_ids, tile_map->width, tile_map->height,
+                    wall_grid, world_objects_container);
+  fill_material_ids(tile_map->floor_ids, tile_map->width, tile_map->height,
+                    floor_grid, world_objects_container);
+
+  resolve_tile_collision_bits(tile_map, world_objects_container);
+
+  return tile_map;
+}
+
+/*
+ * Allocates the cell layers of a width x height map, left uninitialized for
+ * the caller to fill, and resolves the per material flags.
+ */
+extern Tile_Map *
+create_blank_tile_map(size_t width, size_t height,
+                      const World_Objects_Container *world_objects_container) {
+  Tile_Map *tile_map = calloc(1, sizeof(Tile_Map));
+  if (!tile_map) {
+    return NULL;
+  }
+
+  tile_map->width          = width;
+  tile_map->height         = height;
+  size_t cell_count        = width * height;
+  tile_map->wall_ids       = malloc(cell_count * sizeof(Material_Id));
+  tile_map->floor_ids      = malloc(cell_count * sizeof(Material_Id));
+  tile_map->collision_bits = malloc(cell_count * sizeof(uint8_t));
+  tile_map->material_count = world_objects_container->length;
+  tile_map->material_flags =
+      malloc(tile_map->material_count * sizeof(uint8_t));
+  if (!tile_map->wall_ids || !tile_map->floor_ids ||
+      !tile_map->collision_bits || !tile_map->material_flags) {
+    free_tile_map(tile_map);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < tile_map->material_count; i++) {
+    tile_map->material_flags[i] =
+        world_objects_container->data[i]->is_translucent
+            ? 0
+            : MATERIAL_FLAG_OPAQUE;
+  }
+  return tile_map;
+}
+
+// A wall material only blocks through its wall bit and a floor material
+// only through its floor bit
+extern void
+resolve_tile_collision_bits(Tile_Map                      *tile_map,
+                            const World_Objects_Container *world_objects_container) {
+  size_t cell_count = tile_map->width * tile_map->height;
+  for (size_t i = 0; i < cell_count; i++) {
+    uint8_t bits = 0;
+    if (tile_map->wall_ids[i] != MATERIAL_ID_EMPTY) {
+      bits |= world_objects_container->data[tile_map->wall_ids[i]]
+                  ->collision_mode &
+              COLLISION_MODE_WALL;
+    }
+    if (tile_map->floor_ids[i] != MATERIAL_ID_EMPTY) {
+      bits |= world_objects_container->data[tile_map->floor_ids[i]]
+                  ->collision_mode &
+              COLLISION_MODE_FLOOR;
+    }
+    tile_map->collision_bits[i] = bits;
+  }
+}
+
+extern Material_Id
+find_material_id(const World_Objects_Container *world_objects_container,
+                 const char                    *name) {
+  if (!name || strcmp(name, EMPTY_GRID_CELL_VALUE) == 0) {
+    return MATERIAL_ID_EMPTY;
+  }
+
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    if (world_objects_container->data[i] &&
+        world_objects_container->data[i]->name &&
+        strcmp(name, world_objects_container->data[i]->name) == 0) {
+      return (Material_Id)i;
+    }
+  }
+
+  fprintf(stderr, "Unknown material %s, treating as EMPTY\n", name);
+  return MATERIAL_ID_EMPTY;
+}
+
+static size_t get_grid_width(const Jagged_Grid *grid) {
+  size_t width = 0;
+  for (size_t i = 0; i < grid->length; i++) {
+    if (grid->rows[i].length > width) {
+      width = grid->rows[i].length;
+    }
+  }
+  return width;
+}
+
+static void
+fill_material_ids(Material_Id *out_ids, size_t width, size_t height,
+                  const Jagged_Grid             *grid,
+                  const World_Objects_Container *world_objects_container) {
+  for (size_t y = 0; y < height; y++) {
+    const Jagged_Row *row = y < grid->length ? &grid->rows[y] : NULL;
+    for (size_t x = 0; x < width; x++) {
+      Material_Id id = MATERIAL_ID_EMPTY;
+      if (row && row->world_object_names && x < row->length) {
+        id = find_material_id(world_objects_container,
+                              row->world_object_names[x]);
+      }
+      out_ids[y * width + x] = id;
+    }
+  }
+}
+
+extern void free_tile_map(Tile_Map *tile_map) {
+  if (!tile_map) {
+    return;
+  }
+
+  free(tile_map->wall_ids);
+  free(tile_map->floor_ids);
+  free(tile_map->collision_bits);
+  free(tile_map->material_flags);
+  free(tile_map);
+}
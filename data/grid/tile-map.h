@@ -0,0 +1,36 @@
+#ifndef TILE_MAP_H
+#define TILE_MAP_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../assets/textures/constants.h"
+#include "../../assets/textures/types.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Tile_Map *create_tile_map(const Jagged_Grid             *floor_grid,
+                                 const Jagged_Grid             *wall_grid,
+                                 const World_Objects_Container *world_objects_container);
+extern Tile_Map *create_blank_tile_map(size_t                         width,
+                                       size_t                         height,
+                                       const World_Objects_Container *world_objects_container);
+extern void resolve_tile_collision_bits(Tile_Map                      *tile_map,
+                                        const World_Objects_Container *world_objects_container);
+extern Material_Id find_material_id(const World_Objects_Container *world_objects_container,
+                                    const char                    *name);
+extern void free_tile_map(Tile_Map *tile_map);
+
+// Cells outside the map are treated as solid
+static inline uint8_t get_tile_collision_bits(const Tile_Map *tile_map,
+                                              int grid_x, int grid_y) {
+  if (grid_x < 0 || grid_y < 0 || (size_t)grid_x >= tile_map->width ||
+      (size_t)grid_y >= tile_map->height) {
+    return COLLISION_MODE_FLOOR | COLLISION_MODE_WALL;
+  }
+  return tile_map->collision_bits[(size_t)grid_y * tile_map->width + grid_x];
+}
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef GRID_TYPES_H
 #define GRID_TYPES_H
 
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../types/algebraic-types.h"
+
 typedef char *Object_Name;
 
 typedef struct Jagged_Row {
@@ -13,10 +18,95 @@ typedef struct Jagged_Grid {
   Jagged_Row *rows;
 } Jagged_Grid;
 
+// Index into the World_Objects_Container, or MATERIAL_ID_EMPTY
+typedef uint16_t Material_Id;
+
+/*
+ * Dense, row major copy of the floor and wall grids resolved to material ids
+ * once at load time. Ragged rows are padded with MATERIAL_ID_EMPTY.
+ */
+typedef struct Tile_Map {
+  size_t       width;
+  size_t       height;
+  Material_Id *wall_ids;
+  Material_Id *floor_ids;
+  uint8_t     *collision_bits; // COLLISION_MODE_* bits that block movement
+  uint8_t     *material_flags; // MATERIAL_FLAG_* per material id
+  size_t       material_count;
+} Tile_Map;
+
+/*
+ * For every open cell, a bitset over all cells of the map marking which cells
+ * are potentially visible from anywhere inside it. Solid cells have no set.
+ */
+typedef struct Potentially_Visible_Set {
+  size_t    width;
+  size_t    height;
+  size_t    words_per_set;
+  uint32_t *set_indexes; // per cell, PVS_NO_SET for solid cells
+  uint64_t *bits;
+} Potentially_Visible_Set;
+
+// A blocked cell's corner a view's line was bent around, bumps form a chain
+typedef struct PVS_Bump {
+  IPoint_2D point;
+  int32_t   parent; // index into the bumps, -1 ends the chain
+} PVS_Bump;
+
+/*
+ * A wedge of lines leaving the source cell, between shallow_line and
+ * steep_line. Lines run from the source cell or a bump (start) towards the
+ * bump they were last bent around (end), in quadrant local cell corners.
+ */
+typedef struct PVS_View {
+  ILine_2D shallow_line;
+  ILine_2D steep_line;
+  int32_t  shallow_bump;
+  int32_t  steep_bump;
+} PVS_View;
+
+// Scratch reused for every source cell while a PVS is built
+typedef struct PVS_Field_Of_View {
+  PVS_View *views; // shallowest first
+  size_t    view_count;
+  PVS_Bump *bumps; // per quadrant, shared between split views
+  size_t    bump_count;
+  uint64_t *visible_bits;  // before dilation
+  uint32_t *visible_cells; // the same cells, listed
+  size_t    visible_count;
+} PVS_Field_Of_View;
+
+typedef struct Light_Source {
+  IPoint_2D cell;
+  uint8_t   level; // 1..LIGHT_LEVEL_MAX
+} Light_Source;
+
+/*
+ * Per-cell light levels baked from the light sources. Opaque walls receive
+ * light on their faces but do not pass it on.
+ */
+typedef struct Lightmap {
+  size_t        width;
+  size_t        height;
+  uint8_t      *levels;
+  Light_Source *sources;
+  size_t        source_count;
+  size_t        source_capacity;
+  size_t       *queue;     // flood fill ring, cells + 1 slots
+  uint8_t      *is_queued; // per cell
+} Lightmap;
+
 // TODO ! Rename and move
 typedef enum Wall_Surface {
   WS_HORIZONTAL,
   WS_VERTICAL,
 } Wall_Surface;
 
+typedef struct Ray_Hit {
+  IPoint_2D    grid;
+  Material_Id  material;
+  Wall_Surface surface;
+  Point_2D     intersection;
+} Ray_Hit;
+
 #endif
\ No newline at end of file
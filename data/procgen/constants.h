@@ -0,0 +1,18 @@
+#ifndef PROCGEN_CONSTANTS_H
+#define PROCGEN_CONSTANTS_H
+
+// Chunks are the unit of work and of streaming, generated independently
+#define PROCGEN_CHUNK_SIZE 64
+#define PROCGEN_MAX_VARIANTS 16 // materials drawn from one category
+
+// Rooms and corridors, one room per chunk joined to its four neighbours
+#define PROCGEN_ROOM_MIN 6
+#define PROCGEN_ROOM_MARGIN 2 // cells kept clear of the chunk edge
+#define PROCGEN_CORRIDOR_W 2
+
+// Caves, fractal value noise over lattices of these spacings in cells
+#define PROCGEN_CAVE_OCTAVES 3
+#define PROCGEN_CAVE_SPACING 16 // first octave, halved for each next one
+#define PROCGEN_CAVE_THRESHOLD_DEFAULT 0.45f
+
+#endif
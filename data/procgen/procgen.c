@@ -0,0 +1,411 @@
+#include "./procgen.h"
+
+typedef enum Procgen_Salt {
+  PROCGEN_SALT_ROOM,
+  PROCGEN_SALT_DOOR_EAST,
+  PROCGEN_SALT_DOOR_SOUTH,
+  PROCGEN_SALT_VARIANT,
+  PROCGEN_SALT_NOISE, // one per octave from here
+} Procgen_Salt;
+
+typedef struct Procgen_Region {
+  size_t x;
+  size_t y;
+  size_t w;
+  size_t h;
+} Procgen_Region;
+
+typedef struct Procgen_Job {
+  const Procgen_Generator *generator;
+  Tile_Map                *tile_map;
+  size_t                   chunks_x;
+} Procgen_Job;
+
+static bool fill_material_set(Procgen_Material_Set          *out_set,
+                              const World_Objects_Container *world_objects_container,
+                              const char *category, uint8_t surface_bit,
+                              bool is_solid);
+static uint64_t hash_procgen(uint64_t seed, uint64_t x, uint64_t y,
+                             uint64_t salt);
+static void generate_chunk_job(void *context, size_t index);
+static void generate_room_chunk(const Procgen_Generator *generator,
+                                Tile_Map *tile_map, Procgen_Region region,
+                                size_t chunk_x, size_t chunk_y);
+static void generate_cave_chunk(const Procgen_Generator *generator,
+                                Tile_Map *tile_map, Procgen_Region region);
+static void carve_region(const Procgen_Generator *generator, Tile_Map *tile_map,
+                         const Procgen_Region *bounds, size_t x0, size_t y0,
+                         size_t x1, size_t y1, size_t floor_variant);
+static void set_procgen_cell(const Procgen_Generator *generator,
+                             Tile_Map *tile_map, size_t cell, bool is_wall,
+                             size_t wall_variant, size_t floor_variant);
+
+/*
+ * Resolves the wall and floor categories against the manifest. Walls are the
+ * opaque materials of the category that block movement, floors the ones that
+ * can be walked on. NULL when either category has no such material.
+ */
+extern Procgen_Generator *
+create_procgen_generator(const Procgen_Params          *params,
+                         const World_Objects_Container *world_objects_container) {
+  if (!params || !world_objects_container ||
+      params->algorithm >= PROCGEN_ALGORITHM_COUNT) {
+    return NULL;
+  }
+  Procgen_Generator *generator = calloc(1, sizeof(Procgen_Generator));
+  if (!generator) {
+    return NULL;
+  }
+  generator->params = *params;
+  if (!fill_material_set(&generator->walls, world_objects_container,
+                         params->wall_category, COLLISION_MODE_WALL, true) ||
+      !fill_material_set(&generator->floors, world_objects_container,
+                         params->floor_category, COLLISION_MODE_FLOOR,
+                         false)) {
+    free_procgen_generator(generator);
+    return NULL;
+  }
+  return generator;
+}
+
+extern void free_procgen_generator(Procgen_Generator *generator) {
+  free(generator);
+}
+
+/*
+ * Full map, one PROCGEN_CHUNK_SIZE square per job on the worker pool, or on
+ * the calling thread when there is no pool. Chunks write disjoint cells, so
+ * there is nothing to lock.
+ */
+extern Tile_Map *
+generate_tile_map(const Procgen_Generator       *generator,
+                  size_t                         width,
+                  size_t                         height,
+                  const World_Objects_Container *world_objects_container,
+                  Worker_Pool                   *worker_pool) {
+  if (!generator || width == 0 || height == 0) {
+    return NULL;
+  }
+  Tile_Map *tile_map =
+      create_blank_tile_map(width, height, world_objects_container);
+  if (!tile_map) {
+    return NULL;
+  }
+
+  Procgen_Job job = {
+      .generator = generator,
+      .tile_map  = tile_map,
+      .chunks_x  = (width + PROCGEN_CHUNK_SIZE - 1) / PROCGEN_CHUNK_SIZE,
+  };
+  size_t chunks_y = (height + PROCGEN_CHUNK_SIZE - 1) / PROCGEN_CHUNK_SIZE;
+  run_worker_pool(worker_pool, generate_chunk_job, &job,
+                  job.chunks_x * chunks_y);
+  return tile_map;
+}
+
+/*
+ * Fills one chunk of an already allocated map in place. This is the entry
+ * point for streaming: a chunk only reads the seed and its own coordinates,
+ * so it matches what generate_tile_map would have produced there.
+ */
+extern void generate_tile_map_chunk(const Procgen_Generator *generator,
+                                    Tile_Map *tile_map, size_t chunk_x,
+                                    size_t chunk_y) {
+  Procgen_Region region = {
+      .x = chunk_x * PROCGEN_CHUNK_SIZE,
+      .y = chunk_y * PROCGEN_CHUNK_SIZE,
+  };
+  if (region.x >= tile_map->width || region.y >= tile_map->height) {
+    return;
+  }
+  region.w = tile_map->width - region.x < PROCGEN_CHUNK_SIZE
+                 ? tile_map->width - region.x
+                 : PROCGEN_CHUNK_SIZE;
+  region.h = tile_map->height - region.y < PROCGEN_CHUNK_SIZE
+                 ? tile_map->height - region.y
+                 : PROCGEN_CHUNK_SIZE;
+
+  switch (generator->params.algorithm) {
+    case PROCGEN_ALGORITHM_ROOMS:
+      generate_room_chunk(generator, tile_map, region, chunk_x, chunk_y);
+      break;
+    case PROCGEN_ALGORITHM_CAVES:
+      generate_cave_chunk(generator, tile_map, region);
+      break;
+    default:
+      break;
+  }
+}
+
+// First open cell at or after the middle of the map, wrapping around
+extern bool find_procgen_spawn(const Tile_Map *tile_map, IPoint_2D *out_cell) {
+  size_t cell_count = tile_map->width * tile_map->height;
+  size_t start      = (tile_map->height / 2) * tile_map->width +
+                 tile_map->width / 2;
+  for (size_t i = 0; i < cell_count; i++) {
+    size_t cell = (start + i) % cell_count;
+    if (tile_map->wall_ids[cell] == MATERIAL_ID_EMPTY &&
+        tile_map->collision_bits[cell] == 0) {
+      out_cell->x = (int)(cell % tile_map->width);
+      out_cell->y = (int)(cell / tile_map->width);
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool fill_material_set(Procgen_Material_Set          *out_set,
+                              const World_Objects_Container *world_objects_container,
+                              const char *category, uint8_t surface_bit,
+                              bool is_solid) {
+  out_set->length = 0;
+  for (size_t i = 0; i < world_objects_container->length &&
+                     out_set->length < PROCGEN_MAX_VARIANTS;
+       i++) {
+    const World_Object *world_object = world_objects_container->data[i];
+    if (!world_object || !world_object->category || !category ||
+        strcmp(world_object->category, category) != 0 ||
+        !(world_object->surface_type & surface_bit)) {
+      continue;
+    }
+    bool is_blocking = world_object->collision_mode & surface_bit;
+    if (is_blocking != is_solid ||
+        (is_solid && world_object->is_translucent)) {
+      continue;
+    }
+    out_set->ids[out_set->length]            = (Material_Id)i;
+    out_set->collision_bits[out_set->length] =
+        world_object->collision_mode & surface_bit;
+    out_set->length++;
+  }
+  if (out_set->length == 0) {
+    fprintf(stderr, "No %s materials in category %s\n",
+            is_solid ? "wall" : "floor", category ? category : "(null)");
+    return false;
+  }
+  return true;
+}
+
+// splitmix64 finalizer over the mixed inputs
+static uint64_t hash_procgen(uint64_t seed, uint64_t x, uint64_t y,
+                             uint64_t salt) {
+  uint64_t h = seed ^ (x * 0x9E3779B97F4A7C15ull) ^
+               (y * 0xC2B2AE3D27D4EB4Full) ^ (salt * 0x165667B19E3779F9ull);
+  h          = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+  h          = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+  return h ^ (h >> 31);
+}
+
+static void generate_chunk_job(void *context, size_t index) {
+  Procgen_Job *job = context;
+  generate_tile_map_chunk(job->generator, job->tile_map,
+                          index % job->chunks_x, index / job->chunks_x);
+}
+
+/*
+ * One room per chunk, kept PROCGEN_ROOM_MARGIN inside it, with a corridor to a
+ * door on every edge shared with another chunk. A door's position hashes the
+ * edge itself, so both chunks on either side carve to the same cells.
+ */
+static void generate_room_chunk(const Procgen_Generator *generator,
+                                Tile_Map *tile_map, Procgen_Region region,
+                                size_t chunk_x, size_t chunk_y) {
+  uint64_t seed          = generator->params.seed;
+  uint64_t variant_hash  = hash_procgen(seed, chunk_x, chunk_y,
+                                        PROCGEN_SALT_VARIANT);
+  size_t   wall_variant  = variant_hash % generator->walls.length;
+  size_t   floor_variant = (variant_hash >> 32) % generator->floors.length;
+
+  for (size_t y = region.y; y < region.y + region.h; y++) {
+    for (size_t x = region.x; x < region.x + region.w; x++) {
+      set_procgen_cell(generator, tile_map, y * tile_map->width + x, true,
+                       wall_variant, floor_variant);
+    }
+  }
+
+  size_t inner_w = region.w > PROCGEN_ROOM_MARGIN * 2
+                       ? region.w - PROCGEN_ROOM_MARGIN * 2
+                       : 1;
+  size_t inner_h = region.h > PROCGEN_ROOM_MARGIN * 2
+                       ? region.h - PROCGEN_ROOM_MARGIN * 2
+                       : 1;
+
+  uint64_t room_hash = hash_procgen(seed, chunk_x, chunk_y, PROCGEN_SALT_ROOM);
+  size_t   room_w    = inner_w;
+  size_t   room_h    = inner_h;
+  if (inner_w > PROCGEN_ROOM_MIN) {
+    room_w = PROCGEN_ROOM_MIN +
+             (room_hash & 0xFFFF) % (inner_w - PROCGEN_ROOM_MIN + 1);
+  }
+  if (inner_h > PROCGEN_ROOM_MIN) {
+    room_h = PROCGEN_ROOM_MIN +
+             ((room_hash >> 16) & 0xFFFF) % (inner_h - PROCGEN_ROOM_MIN + 1);
+  }
+  size_t room_x = region.x + PROCGEN_ROOM_MARGIN +
+                  ((room_hash >> 32) & 0xFFFF) % (inner_w - room_w + 1);
+  size_t room_y = region.y + PROCGEN_ROOM_MARGIN +
+                  (room_hash >> 48) % (inner_h - room_h + 1);
+  carve_region(generator, tile_map, &region, room_x, room_y, room_x + room_w,
+               room_y + room_h, floor_variant);
+
+  size_t centre_x    = room_x + room_w / 2;
+  size_t centre_y    = room_y + room_h / 2;
+  size_t door_span_w = inner_w > PROCGEN_CORRIDOR_W
+                           ? inner_w - PROCGEN_CORRIDOR_W + 1
+                           : 1;
+  size_t door_span_h = inner_h > PROCGEN_CORRIDOR_W
+                           ? inner_h - PROCGEN_CORRIDOR_W + 1
+                           : 1;
+  size_t region_x1   = region.x + region.w;
+  size_t region_y1   = region.y + region.h;
+  bool   has_east    = region_x1 < tile_map->width;
+  bool   has_south   = region_y1 < tile_map->height;
+
+  // A west door is the west neighbour's east door, hashed from the same edge
+  for (int side = 0; side < 2; side++) {
+    bool is_east = side == 0;
+    if ((is_east && !has_east) || (!is_east && region.x == 0)) {
+      continue;
+    }
+    size_t door_y = region.y + PROCGEN_ROOM_MARGIN +
+                    hash_procgen(seed, is_east ? chunk_x + 1 : chunk_x,
+                                 chunk_y, PROCGEN_SALT_DOOR_EAST) %
+                        door_span_h;
+    size_t low_y  = door_y < centre_y ? door_y : centre_y;
+    size_t high_y = door_y > centre_y ? door_y : centre_y;
+    carve_region(generator, tile_map, &region, centre_x, low_y,
+                 centre_x + PROCGEN_CORRIDOR_W, high_y + PROCGEN_CORRIDOR_W,
+                 floor_variant);
+    carve_region(generator, tile_map, &region, is_east ? centre_x : region.x,
+                 door_y, is_east ? region_x1 : centre_x + PROCGEN_CORRIDOR_W,
+                 door_y + PROCGEN_CORRIDOR_W, floor_variant);
+  }
+  for (int side = 0; side < 2; side++) {
+    bool is_south = side == 0;
+    if ((is_south && !has_south) || (!is_south && region.y == 0)) {
+      continue;
+    }
+    size_t door_x = region.x + PROCGEN_ROOM_MARGIN +
+                    hash_procgen(seed, chunk_x,
+                                 is_south ? chunk_y + 1 : chunk_y,
+                                 PROCGEN_SALT_DOOR_SOUTH) %
+                        door_span_w;
+    size_t low_x  = door_x < centre_x ? door_x : centre_x;
+    size_t high_x = door_x > centre_x ? door_x : centre_x;
+    carve_region(generator, tile_map, &region, low_x, centre_y,
+                 high_x + PROCGEN_CORRIDOR_W, centre_y + PROCGEN_CORRIDOR_W,
+                 floor_variant);
+    carve_region(generator, tile_map, &region, door_x,
+                 is_south ? centre_y : region.y, door_x + PROCGEN_CORRIDOR_W,
+                 is_south ? region_y1 : centre_y + PROCGEN_CORRIDOR_W,
+                 floor_variant);
+  }
+}
+
+/*
+ * Fractal value noise, thresholded into walls. The lattice values a chunk
+ * touches are hashed once into small tables and the cells interpolate between
+ * them, so the cost per cell is a few multiplies per octave. The lattice is in
+ * map coordinates, so caves run seamlessly across chunk edges.
+ */
+static void generate_cave_chunk(const Procgen_Generator *generator,
+                                Tile_Map *tile_map, Procgen_Region region) {
+  enum { LATTICE_W = PROCGEN_CHUNK_SIZE + 2 };
+  float noise[PROCGEN_CHUNK_SIZE * PROCGEN_CHUNK_SIZE] = {0};
+  float lattice[LATTICE_W * LATTICE_W];
+  float amplitude       = 1.0f;
+  float amplitude_total = 0.0f;
+
+  for (int octave = 0; octave < PROCGEN_CAVE_OCTAVES; octave++) {
+    size_t spacing = PROCGEN_CAVE_SPACING >> octave;
+    spacing        = spacing > 0 ? spacing : 1;
+    size_t lx0     = region.x / spacing;
+    size_t ly0     = region.y / spacing;
+    size_t lw      = (region.x + region.w - 1) / spacing - lx0 + 2;
+    size_t lh      = (region.y + region.h - 1) / spacing - ly0 + 2;
+    for (size_t ly = 0; ly < lh; ly++) {
+      for (size_t lx = 0; lx < lw; lx++) {
+        uint64_t h = hash_procgen(generator->params.seed, lx0 + lx, ly0 + ly,
+                                  PROCGEN_SALT_NOISE + octave);
+        lattice[ly * LATTICE_W + lx] = (h >> 40) * (1.0f / (1 << 24));
+      }
+    }
+
+    // Columns share their lattice index and weight across every row
+    float  inv_spacing = 1.0f / spacing;
+    size_t column_lx[PROCGEN_CHUNK_SIZE];
+    float  column_fx[PROCGEN_CHUNK_SIZE];
+    for (size_t x = 0; x < region.w; x++) {
+      size_t map_x = region.x + x;
+      float  fx    = (map_x % spacing) * inv_spacing;
+      column_lx[x] = map_x / spacing - lx0;
+      column_fx[x] = fx * fx * (3.0f - 2.0f * fx);
+    }
+    for (size_t y = 0; y < region.h; y++) {
+      size_t       map_y = region.y + y;
+      size_t       ly    = map_y / spacing - ly0;
+      float        fy    = (map_y % spacing) * inv_spacing;
+      fy                 = fy * fy * (3.0f - 2.0f * fy);
+      const float *row0  = &lattice[ly * LATTICE_W];
+      const float *row1  = row0 + LATTICE_W;
+      float       *out   = &noise[y * PROCGEN_CHUNK_SIZE];
+      for (size_t x = 0; x < region.w; x++) {
+        size_t lx     = column_lx[x];
+        float  top    = row0[lx] + (row0[lx + 1] - row0[lx]) * column_fx[x];
+        float  bottom = row1[lx] + (row1[lx + 1] - row1[lx]) * column_fx[x];
+        out[x]       += amplitude * (top + (bottom - top) * fy);
+      }
+    }
+    amplitude_total += amplitude;
+    amplitude       *= 0.5f;
+  }
+
+  // Material variants come in 4x4 patches, hashed once per patch
+  float threshold = generator->params.cave_threshold * amplitude_total;
+  for (size_t y = 0; y < region.h; y++) {
+    size_t   map_y   = region.y + y;
+    uint64_t variant = 0;
+    for (size_t x = 0; x < region.w; x++) {
+      size_t map_x = region.x + x;
+      if (x == 0 || (map_x & 3) == 0) {
+        variant = hash_procgen(generator->params.seed, map_x >> 2, map_y >> 2,
+                               PROCGEN_SALT_VARIANT);
+      }
+      bool is_edge = map_x == 0 || map_y == 0 ||
+                     map_x == tile_map->width - 1 ||
+                     map_y == tile_map->height - 1;
+      set_procgen_cell(generator, tile_map, map_y * tile_map->width + map_x,
+                       is_edge ||
+                           noise[y * PROCGEN_CHUNK_SIZE + x] < threshold,
+                       variant % generator->walls.length,
+                       (variant >> 32) % generator->floors.length);
+    }
+  }
+}
+
+// Opens [x0, x1) x [y0, y1), clipped to the chunk being generated
+static void carve_region(const Procgen_Generator *generator, Tile_Map *tile_map,
+                         const Procgen_Region *bounds, size_t x0, size_t y0,
+                         size_t x1, size_t y1, size_t floor_variant) {
+  x0 = x0 > bounds->x ? x0 : bounds->x;
+  y0 = y0 > bounds->y ? y0 : bounds->y;
+  x1 = x1 < bounds->x + bounds->w ? x1 : bounds->x + bounds->w;
+  y1 = y1 < bounds->y + bounds->h ? y1 : bounds->y + bounds->h;
+  for (size_t y = y0; y < y1; y++) {
+    for (size_t x = x0; x < x1; x++) {
+      set_procgen_cell(generator, tile_map, y * tile_map->width + x, false, 0,
+                       floor_variant);
+    }
+  }
+}
+
+static void set_procgen_cell(const Procgen_Generator *generator,
+                             Tile_Map *tile_map, size_t cell, bool is_wall,
+                             size_t wall_variant, size_t floor_variant) {
+  tile_map->floor_ids[cell]      = generator->floors.ids[floor_variant];
+  tile_map->wall_ids[cell]       = is_wall ? generator->walls.ids[wall_variant]
+                                           : MATERIAL_ID_EMPTY;
+  tile_map->collision_bits[cell] =
+      generator->floors.collision_bits[floor_variant] |
+      (is_wall ? generator->walls.collision_bits[wall_variant] : 0);
+}
@@ -0,0 +1,31 @@
+#ifndef PROCGEN_H
+#define PROCGEN_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../../assets/textures/constants.h"
+#include "../../assets/textures/types.h"
+#include "../../utils/worker-pool.h"
+#include "../grid/constants.h"
+#include "../grid/tile-map.h"
+#include "../grid/types.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Procgen_Generator *create_procgen_generator(const Procgen_Params          *params,
+                                                   const World_Objects_Container *world_objects_container);
+extern void free_procgen_generator(Procgen_Generator *generator);
+extern Tile_Map *generate_tile_map(const Procgen_Generator       *generator,
+                                   size_t                         width,
+                                   size_t                         height,
+                                   const World_Objects_Container *world_objects_container,
+                                   Worker_Pool                   *worker_pool);
+extern void generate_tile_map_chunk(const Procgen_Generator *generator, Tile_Map *tile_map,
+                                    size_t chunk_x, size_t chunk_y);
+extern bool find_procgen_spawn(const Tile_Map *tile_map, IPoint_2D *out_cell);
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef PROCGEN_TYPES_H
+#define PROCGEN_TYPES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../grid/types.h"
+#include "./constants.h"
+
+typedef enum Procgen_Algorithm {
+  PROCGEN_ALGORITHM_ROOMS,
+  PROCGEN_ALGORITHM_CAVES,
+  PROCGEN_ALGORITHM_COUNT,
+} Procgen_Algorithm;
+
+typedef struct Procgen_Params {
+  uint64_t          seed;
+  Procgen_Algorithm algorithm;
+  const char       *wall_category;  // manifest category of solid walls
+  const char       *floor_category; // manifest category of walkable floors
+  float             cave_threshold; // noise below this is wall, 0..1
+} Procgen_Params;
+
+typedef struct Procgen_Material_Set {
+  Material_Id ids[PROCGEN_MAX_VARIANTS];
+  uint8_t     collision_bits[PROCGEN_MAX_VARIANTS];
+  size_t      length;
+} Procgen_Material_Set;
+
+/*
+ * Params plus the materials resolved from the manifest. Every cell is a pure
+ * function of the seed and its map coordinates, so chunks can be generated in
+ * any order, on any thread, and still come out identical.
+ */
+typedef struct Procgen_Generator {
+  Procgen_Params       params;
+  Procgen_Material_Set walls;
+  Procgen_Material_Set floors;
+} Procgen_Generator;
+
+#endif
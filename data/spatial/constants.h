@@ -0,0 +1,7 @@
+#ifndef SPATIAL_CONSTANTS_H
+#define SPATIAL_CONSTANTS_H
+
+#define SPATIAL_HASH_NONE 0xFFFFFFFFu
+#define SPATIAL_HASH_MIN_BUCKETS 64
+
+#endif
@@ -0,0 +1,287 @@
+#include "./spatial-hash.h"
+
+static uint32_t hash_cell(const Spatial_Hash *spatial_hash, IPoint_2D cell);
+static IPoint_2D get_cell(const Spatial_Hash *spatial_hash, Point_2D position);
+static void link_entry(Spatial_Hash *spatial_hash, uint32_t index);
+static void unlink_entry(Spatial_Hash *spatial_hash, uint32_t index);
+static bool intersect_ray_circle(Point_2D origin, Vector_2D direction,
+                                 Point_2D centre, Scalar radius,
+                                 Scalar *out_distance);
+
+extern Spatial_Hash *create_spatial_hash(Scalar cell_size,
+                                         size_t expected_length) {
+  Spatial_Hash *spatial_hash = calloc(1, sizeof(Spatial_Hash));
+  if (!spatial_hash) {
+    return NULL;
+  }
+
+  // Roughly two buckets per entry keeps chains short without rehashing
+  uint32_t bucket_count = SPATIAL_HASH_MIN_BUCKETS;
+  while (bucket_count < expected_length * 2 && bucket_count < (1u << 30)) {
+    bucket_count <<= 1;
+  }
+
+  spatial_hash->cell_size   = cell_size;
+  spatial_hash->bucket_mask = bucket_count - 1;
+  spatial_hash->free_head   = SPATIAL_HASH_NONE;
+  spatial_hash->buckets     = malloc(bucket_count * sizeof(uint32_t));
+  if (!spatial_hash->buckets) {
+    free(spatial_hash);
+    return NULL;
+  }
+  for (uint32_t i = 0; i < bucket_count; i++) {
+    spatial_hash->buckets[i] = SPATIAL_HASH_NONE;
+  }
+
+  return spatial_hash;
+}
+
+extern void free_spatial_hash(Spatial_Hash *spatial_hash) {
+  if (!spatial_hash) {
+    return;
+  }
+
+  free(spatial_hash->buckets);
+  free(spatial_hash->entries);
+  free(spatial_hash);
+}
+
+extern Spatial_Handle insert_spatial_entry(Spatial_Hash *spatial_hash,
+                                           uint32_t user_id, Point_2D position,
+                                           Scalar radius) {
+  uint32_t index;
+  if (spatial_hash->free_head != SPATIAL_HASH_NONE) {
+    index                   = spatial_hash->free_head;
+    spatial_hash->free_head = spatial_hash->entries[index].next;
+  } else {
+    if (spatial_hash->length == spatial_hash->capacity) {
+      size_t capacity =
+          spatial_hash->capacity ? spatial_hash->capacity * 2 : 64;
+      Spatial_Entry *entries =
+          realloc(spatial_hash->entries, capacity * sizeof(Spatial_Entry));
+      if (!entries) {
+        return SPATIAL_HASH_NONE;
+      }
+      spatial_hash->entries  = entries;
+      spatial_hash->capacity = capacity;
+    }
+    index = (uint32_t)spatial_hash->length++;
+  }
+
+  Spatial_Entry *entry = &spatial_hash->entries[index];
+  entry->position      = position;
+  entry->radius        = radius;
+  entry->user_id       = user_id;
+  entry->cell          = get_cell(spatial_hash, position);
+  entry->is_alive      = true;
+  link_entry(spatial_hash, index);
+
+  if (radius > spatial_hash->max_radius) {
+    spatial_hash->max_radius = radius;
+  }
+
+  return index;
+}
+
+extern void move_spatial_entry(Spatial_Hash  *spatial_hash,
+                               Spatial_Handle handle, Point_2D position) {
+  Spatial_Entry *entry = &spatial_hash->entries[handle];
+  IPoint_2D      cell  = get_cell(spatial_hash, position);
+
+  entry->position = position;
+  if (cell.x == entry->cell.x && cell.y == entry->cell.y) {
+    return;
+  }
+
+  unlink_entry(spatial_hash, handle);
+  entry->cell = cell;
+  link_entry(spatial_hash, handle);
+}
+
+extern void remove_spatial_entry(Spatial_Hash  *spatial_hash,
+                                 Spatial_Handle handle) {
+  Spatial_Entry *entry = &spatial_hash->entries[handle];
+  if (!entry->is_alive) {
+    return;
+  }
+
+  unlink_entry(spatial_hash, handle);
+  entry->is_alive         = false;
+  entry->next             = spatial_hash->free_head;
+  spatial_hash->free_head = handle;
+}
+
+/*
+ * Writes the user ids of every entry whose circle overlaps the query circle,
+ * up to capacity. Returns the total number of overlaps, which may be larger
+ * than capacity.
+ */
+extern size_t query_spatial_radius(const Spatial_Hash *spatial_hash,
+                                   Point_2D centre, Scalar radius,
+                                   uint32_t *out_user_ids, size_t capacity) {
+  Scalar reach = radius + spatial_hash->max_radius;
+  int    min_x = floorf((centre.x - reach) / spatial_hash->cell_size);
+  int    max_x = floorf((centre.x + reach) / spatial_hash->cell_size);
+  int    min_y = floorf((centre.y - reach) / spatial_hash->cell_size);
+  int    max_y = floorf((centre.y + reach) / spatial_hash->cell_size);
+  size_t found = 0;
+
+  for (int y = min_y; y <= max_y; y++) {
+    for (int x = min_x; x <= max_x; x++) {
+      IPoint_2D cell  = {x, y};
+      uint32_t  index = spatial_hash->buckets[hash_cell(spatial_hash, cell)];
+      while (index != SPATIAL_HASH_NONE) {
+        const Spatial_Entry *entry = &spatial_hash->entries[index];
+        index                      = entry->next;
+        if (entry->cell.x != x || entry->cell.y != y) {
+          continue;
+        }
+
+        Vector_1D dx         = entry->position.x - centre.x;
+        Vector_1D dy         = entry->position.y - centre.y;
+        Scalar    overlap_at = radius + entry->radius;
+        if (dx * dx + dy * dy > overlap_at * overlap_at) {
+          continue;
+        }
+
+        if (found < capacity) {
+          out_user_ids[found] = entry->user_id;
+        }
+        found++;
+      }
+    }
+  }
+
+  return found;
+}
+
+/*
+ * Nearest entry hit by the ray. Cells are walked with a DDA and each visited
+ * cell's neighbourhood (wide enough for the largest radius) is tested, so the
+ * walk can stop as soon as the next cell starts beyond the best hit.
+ */
+extern Spatial_Ray_Hit query_spatial_ray(const Spatial_Hash *spatial_hash,
+                                         Point_2D origin, Vector_2D direction,
+                                         Scalar max_distance) {
+  Spatial_Ray_Hit hit = {.is_hit = false, .distance = max_distance};
+
+  Scalar length = sqrtf(direction.x * direction.x + direction.y * direction.y);
+  if (length == 0) {
+    return hit;
+  }
+  direction.x /= length;
+  direction.y /= length;
+
+  Scalar    cell_size = spatial_hash->cell_size;
+  int       reach     = (int)ceilf(spatial_hash->max_radius / cell_size);
+  IPoint_2D cell      = get_cell(spatial_hash, origin);
+
+  IVector_1D step_x  = direction.x >= 0 ? 1 : -1;
+  IVector_1D step_y  = direction.y >= 0 ? 1 : -1;
+  Vector_1D  delta_x = fabsf(cell_size / direction.x);
+  Vector_1D  delta_y = fabsf(cell_size / direction.y);
+  Scalar     next_x  = direction.x >= 0 ? (cell.x + 1) * cell_size - origin.x
+                                        : origin.x - cell.x * cell_size;
+  Scalar     next_y  = direction.y >= 0 ? (cell.y + 1) * cell_size - origin.y
+                                        : origin.y - cell.y * cell_size;
+  Scalar t_max_x = direction.x != 0 ? next_x / fabsf(direction.x) : INFINITY;
+  Scalar t_max_y = direction.y != 0 ? next_y / fabsf(direction.y) : INFINITY;
+  Scalar t_enter = 0;
+
+  while (t_enter <= max_distance && t_enter <= hit.distance) {
+    for (int y = cell.y - reach; y <= cell.y + reach; y++) {
+      for (int x = cell.x - reach; x <= cell.x + reach; x++) {
+        IPoint_2D neighbour = {x, y};
+        uint32_t  index =
+            spatial_hash->buckets[hash_cell(spatial_hash, neighbour)];
+        while (index != SPATIAL_HASH_NONE) {
+          const Spatial_Entry *entry = &spatial_hash->entries[index];
+          index                      = entry->next;
+          if (entry->cell.x != x || entry->cell.y != y) {
+            continue;
+          }
+
+          Scalar distance;
+          if (intersect_ray_circle(origin, direction, entry->position,
+                                   entry->radius, &distance) &&
+              distance <= hit.distance) {
+            hit.is_hit   = true;
+            hit.user_id  = entry->user_id;
+            hit.distance = distance;
+          }
+        }
+      }
+    }
+
+    if (t_max_x < t_max_y) {
+      t_enter = t_max_x;
+      t_max_x += delta_x;
+      cell.x += step_x;
+    } else {
+      t_enter = t_max_y;
+      t_max_y += delta_y;
+      cell.y += step_y;
+    }
+  }
+
+  return hit;
+}
+
+static uint32_t hash_cell(const Spatial_Hash *spatial_hash, IPoint_2D cell) {
+  uint32_t hash = ((uint32_t)cell.x * 73856093u) ^ ((uint32_t)cell.y * 19349663u);
+  return hash & spatial_hash->bucket_mask;
+}
+
+static IPoint_2D get_cell(const Spatial_Hash *spatial_hash, Point_2D position) {
+  IPoint_2D cell = {
+      .x = floorf(position.x / spatial_hash->cell_size),
+      .y = floorf(position.y / spatial_hash->cell_size),
+  };
+  return cell;
+}
+
+static void link_entry(Spatial_Hash *spatial_hash, uint32_t index) {
+  Spatial_Entry *entry = &spatial_hash->entries[index];
+  entry->bucket        = hash_cell(spatial_hash, entry->cell);
+  entry->prev          = SPATIAL_HASH_NONE;
+  entry->next          = spatial_hash->buckets[entry->bucket];
+  if (entry->next != SPATIAL_HASH_NONE) {
+    spatial_hash->entries[entry->next].prev = index;
+  }
+  spatial_hash->buckets[entry->bucket] = index;
+}
+
+static void unlink_entry(Spatial_Hash *spatial_hash, uint32_t index) {
+  Spatial_Entry *entry = &spatial_hash->entries[index];
+  if (entry->prev != SPATIAL_HASH_NONE) {
+    spatial_hash->entries[entry->prev].next = entry->next;
+  } else {
+    spatial_hash->buckets[entry->bucket] = entry->next;
+  }
+  if (entry->next != SPATIAL_HASH_NONE) {
+    spatial_hash->entries[entry->next].prev = entry->prev;
+  }
+}
+
+static bool intersect_ray_circle(Point_2D origin, Vector_2D direction,
+                                 Point_2D centre, Scalar radius,
+                                 Scalar *out_distance) {
+  Vector_1D to_centre_x  = centre.x - origin.x;
+  Vector_1D to_centre_y  = centre.y - origin.y;
+  Scalar    closest_t    = to_centre_x * direction.x + to_centre_y * direction.y;
+  Scalar    centre_dist2 = to_centre_x * to_centre_x + to_centre_y * to_centre_y;
+  Scalar    miss_dist2   = centre_dist2 - closest_t * closest_t;
+  if (miss_dist2 > radius * radius) {
+    return false;
+  }
+
+  Scalar half_chord = sqrtf(radius * radius - miss_dist2);
+  Scalar enter_t    = closest_t - half_chord;
+  if (closest_t + half_chord < 0) {
+    return false;
+  }
+
+  // Origin inside the circle counts as a hit at distance 0
+  *out_distance = enter_t > 0 ? enter_t : 0;
+  return true;
+}
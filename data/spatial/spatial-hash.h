@@ -0,0 +1,20 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <math.h>
+#include <stdlib.h>
+
+#include "./constants.h"
+#include "./types.h"
+
+extern Spatial_Hash *create_spatial_hash(Scalar cell_size, size_t expected_length);
+extern void free_spatial_hash(Spatial_Hash *spatial_hash);
+
+extern Spatial_Handle insert_spatial_entry(Spatial_Hash *spatial_hash, uint32_t user_id, Point_2D position, Scalar radius);
+extern void move_spatial_entry(Spatial_Hash *spatial_hash, Spatial_Handle handle, Point_2D position);
+extern void remove_spatial_entry(Spatial_Hash *spatial_hash, Spatial_Handle handle);
+
+extern size_t query_spatial_radius(const Spatial_Hash *spatial_hash, Point_2D centre, Scalar radius, uint32_t *out_user_ids, size_t capacity);
+extern Spatial_Ray_Hit query_spatial_ray(const Spatial_Hash *spatial_hash, Point_2D origin, Vector_2D direction, Scalar max_distance);
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef SPATIAL_TYPES_H
+#define SPATIAL_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../types/algebraic-types.h"
+
+typedef uint32_t Spatial_Handle;
+
+// Entries are kept in a pool and linked into their bucket by index
+typedef struct Spatial_Entry {
+  Point_2D  position;
+  Scalar    radius;
+  uint32_t  user_id; // caller's id, e.g. an index into an entity array
+  IPoint_2D cell;
+  uint32_t  bucket;
+  uint32_t  prev;
+  uint32_t  next;
+  bool      is_alive;
+} Spatial_Entry;
+
+/*
+ * Uniform grid over GRID_CELL_SIZE cells, hashed into a fixed power of two
+ * bucket table so the world does not need to be bounded.
+ */
+typedef struct Spatial_Hash {
+  Scalar         cell_size;
+  Scalar         max_radius;
+  uint32_t       bucket_mask;
+  uint32_t      *buckets;
+  Spatial_Entry *entries;
+  size_t         length;
+  size_t         capacity;
+  uint32_t       free_head;
+} Spatial_Hash;
+
+typedef struct Spatial_Ray_Hit {
+  bool     is_hit;
+  uint32_t user_id;
+  Scalar   distance;
+} Spatial_Ray_Hit;
+
+#endif
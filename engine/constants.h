@@ -0,0 +1,24 @@
+#ifndef ENGINE_CONSTANTS_H
+#define ENGINE_CONSTANTS_H
+
+#define ENGINE_MANIFEST_PATH_DEFAULT "./manifests/texture_manifest.json"
+#define ENGINE_LEVEL_DIRECTORY_DEFAULT "./assets/levels/3"
+#define ENGINE_WALL_FILE_DEFAULT "w.csv"
+#define ENGINE_FLOOR_FILE_DEFAULT "f.csv"
+
+// Top left of the player's hit box on every level
+#define ENGINE_PLAYER_START_X 72.0f
+#define ENGINE_PLAYER_START_Y 72.0f
+
+// Engine_Input buttons, held for the whole tick
+#define ENGINE_BUTTON_FORWARDS (1 << 0)
+#define ENGINE_BUTTON_BACKWARDS (1 << 1)
+#define ENGINE_BUTTON_TURN_LEFT (1 << 2)
+#define ENGINE_BUTTON_TURN_RIGHT (1 << 3)
+#define ENGINE_BUTTON_SPRINT (1 << 4)
+
+// Engine_Input events, applied once on the tick they arrive
+#define ENGINE_EVENT_VIEW_FARTHER (1 << 0)
+#define ENGINE_EVENT_VIEW_NEARER (1 << 1)
+
+#endif
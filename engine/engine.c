@@ -0,0 +1,314 @@
+#include "./engine.h"
+
+static bool load_engine_level(Engine_Context      *engine,
+                              const Engine_Config *config);
+static Jagged_Grid *read_level_layer(const char *level_directory,
+                                     const char *file_name, bool is_required);
+static void init_engine_player(Player *player);
+static void rotate_engine_player(Engine_Context *engine, float rotation,
+                                 float delta_time);
+static void move_engine_player(Engine_Context *engine, float direction,
+                               bool is_sprinting, float delta_time);
+
+extern Engine_Config get_default_engine_config(void) {
+  return (Engine_Config){
+      .manifest_path   = ENGINE_MANIFEST_PATH_DEFAULT,
+      .level_directory = ENGINE_LEVEL_DIRECTORY_DEFAULT,
+      .wall_file_name  = ENGINE_WALL_FILE_DEFAULT,
+      .floor_file_name = ENGINE_FLOOR_FILE_DEFAULT,
+      .view_w          = SOFTWARE_RENDER_W,
+      .view_h          = SOFTWARE_RENDER_H,
+      .view_distance   = VIEW_DISTANCE_DEFAULT,
+      .use_fixed_point = false,
+  };
+}
+
+/*
+ * Materials, level and a software renderer, with no window or SDL_Renderer.
+ * Textures are loaded as surfaces only; a front end that draws with SDL
+ * creates its GPU textures from them with create_world_object_textures.
+ */
+extern Engine_Context *create_engine(const Engine_Config *config) {
+  Engine_Context *engine = calloc(1, sizeof(Engine_Context));
+  if (!engine) {
+    return NULL;
+  }
+
+  char manifest_path[MAX_PATH_LENGTH];
+  snprintf(manifest_path, sizeof(manifest_path), "%s", config->manifest_path);
+  engine->world_objects_container =
+      setup_engine_textures(NULL, manifest_path);
+  if (!engine->world_objects_container) {
+    free_engine(engine);
+    return NULL;
+  }
+  engine->animation_clocks =
+      create_animation_clocks(engine->world_objects_container);
+  engine->indexed_renderer = create_indexed_renderer(
+      engine->world_objects_container, config->view_w, config->view_h);
+  if (!engine->animation_clocks || !engine->indexed_renderer ||
+      !load_engine_level(engine, config)) {
+    free_engine(engine);
+    return NULL;
+  }
+  engine->indexed_renderer->use_fixed_point = config->use_fixed_point;
+
+  engine->render_scene = (Render_Scene){
+      .tile_map                = engine->tile_map,
+      .world_objects_container = engine->world_objects_container,
+      .sprite_entities         = engine->sprite_entities,
+      .spatial_hash            = engine->spatial_hash,
+      .pvs                     = engine->potentially_visible_set,
+      .lightmap                = engine->lightmap,
+      .fog                     = create_fog(config->view_distance),
+      .sprite_draw_list        = engine->sprite_draw_list,
+  };
+  init_engine_player(&engine->player);
+  return engine;
+}
+
+/*
+ * One tick: events apply, animations advance, then the player turns and moves.
+ * Input is the only thing read, so the same inputs and delta times replay the
+ * same world.
+ */
+extern void step_engine(Engine_Context *engine, Engine_Input input,
+                        float delta_time) {
+  Fog *fog = &engine->render_scene.fog;
+  if (input.events & ENGINE_EVENT_VIEW_FARTHER) {
+    *fog = create_fog(fog->max_distance + VIEW_DISTANCE_STEP);
+  }
+  if (input.events & ENGINE_EVENT_VIEW_NEARER) {
+    *fog = create_fog(fog->max_distance - VIEW_DISTANCE_STEP);
+  }
+  advance_animation_clocks(engine->animation_clocks, delta_time);
+
+  engine->has_bumped = false;
+  bool is_sprinting  = input.buttons & ENGINE_BUTTON_SPRINT;
+  if (input.buttons & ENGINE_BUTTON_TURN_LEFT) {
+    rotate_engine_player(engine, ANTI_CLOCKWISE, delta_time);
+  }
+  if (input.buttons & ENGINE_BUTTON_TURN_RIGHT) {
+    rotate_engine_player(engine, CLOCKWISE, delta_time);
+  }
+  if (input.buttons & ENGINE_BUTTON_FORWARDS) {
+    move_engine_player(engine, FORWARDS, is_sprinting, delta_time);
+  }
+  if (input.buttons & ENGINE_BUTTON_BACKWARDS) {
+    move_engine_player(engine, BACKWARDS, is_sprinting, delta_time);
+  }
+  // Letting go ends the push, pushing again is a new bump
+  if (!(input.buttons & (ENGINE_BUTTON_FORWARDS | ENGINE_BUTTON_BACKWARDS))) {
+    engine->is_player_blocked = false;
+  }
+}
+
+extern Camera get_engine_camera(const Engine_Context *engine) {
+  return (Camera){
+      .position =
+          {
+              .x = engine->player.rect.x + (PLAYER_W / 2),
+              .y = engine->player.rect.y + (PLAYER_H / 2),
+          },
+      .angle = engine->player.angle,
+  };
+}
+
+// Places the eye directly, without collision, for scripted and offline views
+extern void set_engine_camera(Engine_Context *engine, Camera camera) {
+  Player *player  = &engine->player;
+  player->rect.x  = camera.position.x - (PLAYER_W / 2);
+  player->rect.y  = camera.position.y - (PLAYER_H / 2);
+  player->angle   = camera.angle;
+  Radians radians = convert_deg_to_rads(player->angle);
+  player->delta.x = cos(radians) * PLAYER_MOTION_DELTA_MULTIPLIER;
+  player->delta.y = sin(radians) * PLAYER_MOTION_DELTA_MULTIPLIER;
+}
+
+// The framebuffer must be the size the engine was configured with
+extern bool render_engine_frame(Engine_Context           *engine,
+                                const Engine_Framebuffer *framebuffer) {
+  Indexed_Renderer *indexed_renderer = engine->indexed_renderer;
+  if (!framebuffer->pixels || framebuffer->w != indexed_renderer->w ||
+      framebuffer->h != indexed_renderer->h ||
+      framebuffer->pitch < framebuffer->w * (int)sizeof(uint32_t)) {
+    return false;
+  }
+
+  render_indexed_frame(indexed_renderer, &engine->render_scene,
+                       get_engine_camera(engine));
+  expand_indexed_frame(indexed_renderer, framebuffer->pixels,
+                       framebuffer->pitch);
+  return true;
+}
+
+/*
+ * Fingerprint of everything a tick changes, field by field so struct padding
+ * never leaks in. Equal inputs must give equal hashes on the same build.
+ */
+extern uint64_t hash_engine_state(const Engine_Context *engine) {
+  const Player *player     = &engine->player;
+  uint64_t      hash       = FNV_OFFSET_BASIS;
+  uint8_t       is_blocked = engine->is_player_blocked;
+  hash = hash_fnv1a(hash, &player->rect.x, sizeof(player->rect.x));
+  hash = hash_fnv1a(hash, &player->rect.y, sizeof(player->rect.y));
+  hash = hash_fnv1a(hash, &player->angle, sizeof(player->angle));
+  hash = hash_fnv1a(hash, &player->delta.x, sizeof(player->delta.x));
+  hash = hash_fnv1a(hash, &player->delta.y, sizeof(player->delta.y));
+  hash = hash_fnv1a(hash, &is_blocked, sizeof(is_blocked));
+  hash = hash_fnv1a(hash, &engine->render_scene.fog.max_distance,
+                    sizeof(engine->render_scene.fog.max_distance));
+  hash = hash_fnv1a(hash, &engine->animation_clocks->elapsed_time,
+                    sizeof(engine->animation_clocks->elapsed_time));
+  return hash;
+}
+
+// Visible pixels only, row padding past w is skipped
+extern uint64_t hash_engine_framebuffer(const Engine_Framebuffer *framebuffer) {
+  uint64_t hash = FNV_OFFSET_BASIS;
+  for (int y = 0; y < framebuffer->h; y++) {
+    hash = hash_fnv1a(hash,
+                      (const uint8_t *)framebuffer->pixels +
+                          (size_t)y * framebuffer->pitch,
+                      (size_t)framebuffer->w * sizeof(uint32_t));
+  }
+  return hash;
+}
+
+extern void free_engine(Engine_Context *engine) {
+  if (!engine) {
+    return;
+  }
+
+  free_indexed_renderer(engine->indexed_renderer);
+  free_sprite_draw_list(engine->sprite_draw_list);
+  free_spatial_hash(engine->spatial_hash);
+  free_sprite_entities(engine->sprite_entities);
+  free_lightmap(engine->lightmap);
+  free_potentially_visible_set(engine->potentially_visible_set);
+  free_tile_map(engine->tile_map);
+  free_animation_clocks(engine->animation_clocks);
+  if (engine->world_objects_container) {
+    cleanup_world_objects(engine->world_objects_container);
+    free(engine->world_objects_container);
+  }
+  free(engine);
+}
+
+// Walls and floors are required, a level without lights or entities is not
+static bool load_engine_level(Engine_Context      *engine,
+                              const Engine_Config *config) {
+  const char  *level_directory = config->level_directory;
+  Jagged_Grid *floor_grid =
+      read_level_layer(level_directory, config->floor_file_name, true);
+  Jagged_Grid *wall_grid =
+      read_level_layer(level_directory, config->wall_file_name, true);
+  engine->tile_map        = create_tile_map(floor_grid, wall_grid,
+                                            engine->world_objects_container);
+  free_jagged_grid(wall_grid);
+  free_jagged_grid(floor_grid);
+  if (!engine->tile_map) {
+    return false;
+  }
+  // Maps over PVS_MAX_CELLS get no PVS on purpose, everything is visible there
+  engine->potentially_visible_set =
+      create_potentially_visible_set(engine->tile_map);
+  bool is_pvs_missing =
+      !engine->potentially_visible_set &&
+      engine->tile_map->width * engine->tile_map->height <= PVS_MAX_CELLS;
+
+  // Levels without l.csv have no lightmap and draw at full brightness
+  Jagged_Grid *light_grid = read_level_layer(level_directory, "l.csv", false);
+  engine->lightmap        = create_lightmap(engine->tile_map, light_grid);
+  bool is_lightmap_missing = light_grid && !engine->lightmap;
+  free_jagged_grid(light_grid);
+
+  Jagged_Grid *sprite_grid = read_level_layer(level_directory, "e.csv", false);
+  engine->sprite_entities  = create_sprite_entities_from_grid(
+      sprite_grid, engine->world_objects_container);
+  free_jagged_grid(sprite_grid);
+  if (is_pvs_missing || is_lightmap_missing || !engine->sprite_entities) {
+    return false;
+  }
+
+  engine->sprite_draw_list = create_sprite_draw_list();
+  engine->spatial_hash =
+      create_spatial_hash(GRID_CELL_SIZE, engine->sprite_entities->length);
+  return engine->sprite_draw_list && engine->spatial_hash &&
+         index_sprite_entities(engine->spatial_hash, engine->sprite_entities);
+}
+
+// Optional layers that are missing read as NULL without an error
+static Jagged_Grid *read_level_layer(const char *level_directory,
+                                     const char *file_name, bool is_required) {
+  char path[MAX_PATH_LENGTH];
+  snprintf(path, sizeof(path), "%s/%s", level_directory, file_name);
+  if (!is_required) {
+    FILE *file = fopen(path, "r");
+    if (!file) {
+      return NULL;
+    }
+    fclose(file);
+  }
+  return read_grid_csv_file(path);
+}
+
+static void init_engine_player(Player *player) {
+  player->rect.x = ENGINE_PLAYER_START_X;
+  player->rect.y = ENGINE_PLAYER_START_Y;
+  player->rect.w = PLAYER_W;
+  player->rect.h = PLAYER_H;
+  player->angle  = 0.0f;
+
+  Radians radians = convert_deg_to_rads(player->angle);
+  player->delta.x = cos(radians) * PLAYER_MOTION_DELTA_MULTIPLIER;
+  player->delta.y = sin(radians) * PLAYER_MOTION_DELTA_MULTIPLIER;
+}
+
+static void rotate_engine_player(Engine_Context *engine, float rotation,
+                                 float delta_time) {
+  Player *player = &engine->player;
+  player->angle  = player->angle + (rotation * PLAYER_ROTATION_STEP *
+                                   PLAYER_ROTATION_SPEED * delta_time);
+  player->angle  = (player->angle < 0)     ? 360
+                   : (player->angle > 360) ? 0
+                                           : player->angle;
+  Radians radians = convert_deg_to_rads(player->angle);
+  player->delta.x = cos(radians) * PLAYER_MOTION_DELTA_MULTIPLIER;
+  player->delta.y = sin(radians) * PLAYER_MOTION_DELTA_MULTIPLIER;
+}
+
+static void move_engine_player(Engine_Context *engine, float direction,
+                               bool is_sprinting, float delta_time) {
+  Player *player = &engine->player;
+  float   speed  = PLAYER_SPEED + (is_sprinting ? SPRINT_SPEED_INCREASE : 0);
+
+  // The hit box keeps PLAYER_INTERACTION_DISTANCE of clearance around the player
+  Collision_Body body = {
+      .position.x     = player->rect.x - PLAYER_INTERACTION_DISTANCE,
+      .position.y     = player->rect.y - PLAYER_INTERACTION_DISTANCE,
+      .size.x         = PLAYER_W + PLAYER_INTERACTION_DISTANCE * 2,
+      .size.y         = PLAYER_H + PLAYER_INTERACTION_DISTANCE * 2,
+      .displacement.x = direction * player->delta.x * speed * delta_time,
+      .displacement.y = direction * player->delta.y * speed * delta_time,
+      .collision_mask = COLLISION_MODE_FLOOR | COLLISION_MODE_WALL,
+  };
+
+  sweep_collision_body(engine->tile_map, &body);
+
+  player->rect.x = body.position.x + PLAYER_INTERACTION_DISTANCE;
+  player->rect.y = body.position.y + PLAYER_INTERACTION_DISTANCE;
+
+  // Bumping into a wall is reported once, not every tick the player pushes
+  bool is_blocked = body.is_hit_x || body.is_hit_y;
+  if (is_blocked && !engine->is_player_blocked) {
+    engine->has_bumped    = true;
+    engine->bump_position = (Point_2D){
+        .x = player->rect.x + PLAYER_W / 2 +
+             player->delta.x * direction * GRID_CELL_SIZE / 2,
+        .y = player->rect.y + PLAYER_H / 2 +
+             player->delta.y * direction * GRID_CELL_SIZE / 2,
+    };
+  }
+  engine->is_player_blocked = is_blocked;
+}
@@ -0,0 +1,39 @@
+#ifndef ENGINE_H
+#define ENGINE_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "../assets/sprites/setup.h"
+#include "../assets/textures/animation.h"
+#include "../assets/textures/setup.h"
+#include "../config/constants.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/lightmap.h"
+#include "../data/grid/pvs.h"
+#include "../data/grid/tile-map.h"
+#include "../data/spatial/spatial-hash.h"
+#include "../io/level-io.h"
+#include "../objects/collision/collision.h"
+#include "../objects/player/constants.h"
+#include "../render/constants.h"
+#include "../render/fog.h"
+#include "../render/indexed-renderer.h"
+#include "../utils/fnv-hash.h"
+#include "../utils/math-utils.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Engine_Config get_default_engine_config(void);
+extern Engine_Context *create_engine(const Engine_Config *config);
+extern void step_engine(Engine_Context *engine, Engine_Input input, float delta_time);
+extern Camera get_engine_camera(const Engine_Context *engine);
+extern void set_engine_camera(Engine_Context *engine, Camera camera);
+extern bool render_engine_frame(Engine_Context *engine, const Engine_Framebuffer *framebuffer);
+extern uint64_t hash_engine_state(const Engine_Context *engine);
+extern uint64_t hash_engine_framebuffer(const Engine_Framebuffer *framebuffer);
+extern void free_engine(Engine_Context *engine);
+
+#endif
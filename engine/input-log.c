@@ -0,0 +1,130 @@
+#include "./input-log.h"
+
+/*
+ * Input logs, everything needed to re-run a session through step_engine:
+ *
+ *   uint32 magic, version
+ *   uint16 length, length bytes, the level directory
+ *   per tick: float delta_time, uint8 buttons, uint8 events, uint64 state_hash
+ *
+ * Ticks are packed field by field, INPUT_LOG_TICK_SIZE bytes each, and run to
+ * the end of the file. Numbers are in host byte order, as in tile map files.
+ */
+
+extern Input_Recorder *start_input_recording(const char *filename,
+                                             const char *level_directory) {
+  Input_Recorder *recorder = calloc(1, sizeof(Input_Recorder));
+  if (!recorder) {
+    return NULL;
+  }
+  recorder->file = fopen(filename, "wb");
+  if (!recorder->file) {
+    fprintf(stderr, "Could not open file %s\n", filename);
+    free(recorder);
+    return NULL;
+  }
+
+  uint32_t header[2] = {INPUT_LOG_FILE_MAGIC, INPUT_LOG_FILE_VERSION};
+  uint16_t length    = (uint16_t)strlen(level_directory);
+  recorder->is_ok =
+      fwrite(header, sizeof(header), 1, recorder->file) == 1 &&
+      fwrite(&length, sizeof(length), 1, recorder->file) == 1 &&
+      fwrite(level_directory, 1, length, recorder->file) == length;
+  return recorder;
+}
+
+extern void record_input_tick(Input_Recorder       *recorder,
+                              const Input_Log_Tick *tick) {
+  if (!recorder->is_ok) {
+    return;
+  }
+  recorder->is_ok =
+      fwrite(&tick->delta_time, sizeof(tick->delta_time), 1, recorder->file) ==
+          1 &&
+      fwrite(&tick->input.buttons, 1, 1, recorder->file) == 1 &&
+      fwrite(&tick->input.events, 1, 1, recorder->file) == 1 &&
+      fwrite(&tick->state_hash, sizeof(tick->state_hash), 1, recorder->file) ==
+          1;
+  recorder->tick_count += recorder->is_ok;
+}
+
+// False when any tick failed to write, the file keeps the ticks before it
+extern bool finish_input_recording(Input_Recorder *recorder) {
+  if (!recorder) {
+    return false;
+  }
+  bool is_ok = fclose(recorder->file) == 0 && recorder->is_ok;
+  if (!is_ok) {
+    fprintf(stderr, "Failed to record input after %zu ticks\n",
+            recorder->tick_count);
+  }
+  free(recorder);
+  return is_ok;
+}
+
+// A torn last tick, from a session that crashed mid write, is dropped
+extern Input_Log *read_input_log_file(const char *filename) {
+  FILE *file = fopen(filename, "rb");
+  if (!file) {
+    fprintf(stderr, "Could not open file %s\n", filename);
+    return NULL;
+  }
+
+  uint32_t header[2];
+  uint16_t length;
+  if (fread(header, sizeof(header), 1, file) != 1 ||
+      header[0] != INPUT_LOG_FILE_MAGIC ||
+      header[1] != INPUT_LOG_FILE_VERSION ||
+      fread(&length, sizeof(length), 1, file) != 1) {
+    fprintf(stderr, "Not an input log: %s\n", filename);
+    fclose(file);
+    return NULL;
+  }
+
+  Input_Log *input_log = calloc(1, sizeof(Input_Log));
+  if (!input_log) {
+    fclose(file);
+    return NULL;
+  }
+  input_log->level_directory = calloc(length + 1, 1);
+  if (!input_log->level_directory ||
+      fread(input_log->level_directory, 1, length, file) != length) {
+    free_input_log(input_log);
+    fclose(file);
+    return NULL;
+  }
+
+  long ticks_start = ftell(file);
+  fseek(file, 0, SEEK_END);
+  long file_size = ftell(file);
+  fseek(file, ticks_start, SEEK_SET);
+  size_t capacity  = (size_t)(file_size - ticks_start) / INPUT_LOG_TICK_SIZE;
+  input_log->ticks = malloc((capacity ? capacity : 1) * sizeof(Input_Log_Tick));
+  if (!input_log->ticks) {
+    free_input_log(input_log);
+    fclose(file);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    Input_Log_Tick *tick = &input_log->ticks[i];
+    if (fread(&tick->delta_time, sizeof(tick->delta_time), 1, file) != 1 ||
+        fread(&tick->input.buttons, 1, 1, file) != 1 ||
+        fread(&tick->input.events, 1, 1, file) != 1 ||
+        fread(&tick->state_hash, sizeof(tick->state_hash), 1, file) != 1) {
+      break;
+    }
+    input_log->length++;
+  }
+  fclose(file);
+  return input_log;
+}
+
+extern void free_input_log(Input_Log *input_log) {
+  if (!input_log) {
+    return;
+  }
+  free(input_log->level_directory);
+  free(input_log->ticks);
+  free(input_log);
+}
@@ -0,0 +1,22 @@
+#ifndef INPUT_LOG_H
+#define INPUT_LOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./types.h"
+
+#define INPUT_LOG_FILE_MAGIC 0x474F4C49u // "ILOG" when read little endian
+#define INPUT_LOG_FILE_VERSION 1u
+#define INPUT_LOG_TICK_SIZE 14 // bytes per tick on disk
+
+extern Input_Recorder *start_input_recording(const char *filename, const char *level_directory);
+extern void record_input_tick(Input_Recorder *recorder, const Input_Log_Tick *tick);
+extern bool finish_input_recording(Input_Recorder *recorder);
+extern Input_Log *read_input_log_file(const char *filename);
+extern void free_input_log(Input_Log *input_log);
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef ENGINE_TYPES_H
+#define ENGINE_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "../assets/sprites/types.h"
+#include "../assets/textures/types.h"
+#include "../data/grid/types.h"
+#include "../objects/player/types.h"
+#include "../render/types.h"
+#include "../types/algebraic-types.h"
+
+typedef struct Engine_Config {
+  const char *manifest_path;
+  const char *level_directory; // walls and floors, optionally l.csv and e.csv
+  const char *wall_file_name;  // in level_directory
+  const char *floor_file_name;
+  int         view_w;          // framebuffer size in pixels
+  int         view_h;
+  Scalar      view_distance;
+  bool        use_fixed_point;
+} Engine_Config;
+
+// One tick of input
+typedef struct Engine_Input {
+  uint8_t buttons; // ENGINE_BUTTON_* bits
+  uint8_t events;  // ENGINE_EVENT_* bits
+} Engine_Input;
+
+// One recorded tick, state_hash is hash_engine_state after it was stepped
+typedef struct Input_Log_Tick {
+  float        delta_time;
+  Engine_Input input;
+  uint64_t     state_hash;
+} Input_Log_Tick;
+
+typedef struct Input_Log {
+  char           *level_directory;
+  Input_Log_Tick *ticks;
+  size_t          length;
+} Input_Log;
+
+// Ticks are streamed to disk as they happen, a crash keeps all but the last
+typedef struct Input_Recorder {
+  FILE  *file;
+  size_t tick_count;
+  bool   is_ok;
+} Input_Recorder;
+
+// Caller owned pixels, SDL_PIXELFORMAT_RGBA32 byte order
+typedef struct Engine_Framebuffer {
+  void *pixels;
+  int   w;
+  int   h;
+  int   pitch; // bytes between rows
+} Engine_Framebuffer;
+
+/*
+ * Everything one running world owns. Nothing is shared between contexts, so
+ * any number can step and render side by side, one thread per context.
+ */
+typedef struct Engine_Context {
+  World_Objects_Container   *world_objects_container;
+  Animation_Clocks          *animation_clocks;
+  Tile_Map                  *tile_map;
+  Potentially_Visible_Set   *potentially_visible_set;
+  Lightmap                  *lightmap;
+  Sprite_Entities_Container *sprite_entities;
+  Sprite_Draw_List          *sprite_draw_list;
+  Spatial_Hash              *spatial_hash;
+  Indexed_Renderer          *indexed_renderer;
+  Render_Scene               render_scene;
+  Player                     player;
+  bool                       is_player_blocked;
+  bool                       has_bumped; // started pushing on a wall this tick
+  Point_2D                   bump_position;
+} Engine_Context;
+
+#endif
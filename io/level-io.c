@@ -18,12 +18,14 @@ extern Jagged_Grid *read_grid_csv_file(const char *filename) {
 
   // First pass: count the number of rows
   grid->length = 0;
-  char c;
+  int c;
+  int last_c = '\n';
   while ((c = fgetc(file)) != EOF) {
     if (c == '\n')
       grid->length++;
+    last_c = c;
   }
-  if (c != '\n' && grid->length > 0)
+  if (last_c != '\n')
     grid->length++; // Handle last line without newline
 
   grid->rows = malloc(grid->length * sizeof(Jagged_Row));
@@ -47,6 +49,8 @@ extern Jagged_Grid *read_grid_csv_file(const char *filename) {
     row_index++;
   }
 
+  grid->length = row_index; // never expose rows getline did not reach
+
   free(line);
   fclose(file);
   return grid;
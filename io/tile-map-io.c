@@ -0,0 +1,134 @@
+#include "./tile-map-io.h"
+
+/*
+ * Binary tile maps, the resolved form of a level's floor and wall CSVs:
+ *
+ *   uint32 magic, version, width, height, name_count
+ *   name_count x (uint16 length, length bytes), the material names
+ *   width * height uint16 wall ids, then as many floor ids
+ *
+ * Ids index the name table, 0xFFFF is empty. Integers are in host byte order,
+ * a file from a host of the other order fails the magic check. Names are
+ * stored rather than manifest indexes so a file survives manifest edits.
+ */
+
+static bool read_material_names(FILE *file, uint32_t name_count,
+                                const World_Objects_Container *world_objects_container,
+                                Material_Id                   *out_ids);
+static bool read_material_layer(FILE *file, Material_Id *layer,
+                                size_t cell_count, const Material_Id *ids,
+                                uint32_t name_count);
+
+extern bool
+write_tile_map_file(const char                    *filename,
+                    const Tile_Map                *tile_map,
+                    const World_Objects_Container *world_objects_container) {
+  FILE *file = fopen(filename, "wb");
+  if (!file) {
+    fprintf(stderr, "Could not open file %s\n", filename);
+    return false;
+  }
+
+  uint32_t header[5] = {
+      TILE_MAP_FILE_MAGIC,
+      TILE_MAP_FILE_VERSION,
+      (uint32_t)tile_map->width,
+      (uint32_t)tile_map->height,
+      (uint32_t)world_objects_container->length,
+  };
+  bool is_ok = fwrite(header, sizeof(header), 1, file) == 1;
+  for (size_t i = 0; is_ok && i < world_objects_container->length; i++) {
+    const char *name   = world_objects_container->data[i]->name;
+    uint16_t    length = (uint16_t)strlen(name);
+    is_ok = fwrite(&length, sizeof(length), 1, file) == 1 &&
+            fwrite(name, 1, length, file) == length;
+  }
+
+  size_t cell_count = tile_map->width * tile_map->height;
+  is_ok = is_ok &&
+          fwrite(tile_map->wall_ids, sizeof(Material_Id), cell_count, file) ==
+              cell_count &&
+          fwrite(tile_map->floor_ids, sizeof(Material_Id), cell_count, file) ==
+              cell_count;
+  if (fclose(file) != 0 || !is_ok) {
+    fprintf(stderr, "Failed to write %s\n", filename);
+    return false;
+  }
+  return true;
+}
+
+/*
+ * Reads the two layers straight into the map and remaps the file's ids to the
+ * current manifest in place. Unknown names become EMPTY, as in the CSV path.
+ */
+extern Tile_Map *
+read_tile_map_file(const char                    *filename,
+                   const World_Objects_Container *world_objects_container) {
+  FILE *file = fopen(filename, "rb");
+  if (!file) {
+    fprintf(stderr, "Could not open file %s\n", filename);
+    return NULL;
+  }
+
+  uint32_t header[5];
+  if (fread(header, sizeof(header), 1, file) != 1 ||
+      header[0] != TILE_MAP_FILE_MAGIC || header[1] != TILE_MAP_FILE_VERSION ||
+      header[4] >= MATERIAL_ID_EMPTY) {
+    fprintf(stderr, "Not a tile map file: %s\n", filename);
+    fclose(file);
+    return NULL;
+  }
+  uint32_t name_count = header[4];
+
+  Material_Id *ids      = malloc((name_count ? name_count : 1) * sizeof(Material_Id));
+  Tile_Map    *tile_map = create_blank_tile_map(header[2], header[3],
+                                                world_objects_container);
+  size_t       cell_count = (size_t)header[2] * header[3];
+  if (!ids || !tile_map ||
+      !read_material_names(file, name_count, world_objects_container, ids) ||
+      !read_material_layer(file, tile_map->wall_ids, cell_count, ids,
+                           name_count) ||
+      !read_material_layer(file, tile_map->floor_ids, cell_count, ids,
+                           name_count)) {
+    fprintf(stderr, "Failed to read %s\n", filename);
+    free(ids);
+    free_tile_map(tile_map);
+    fclose(file);
+    return NULL;
+  }
+  free(ids);
+  fclose(file);
+
+  resolve_tile_collision_bits(tile_map, world_objects_container);
+  return tile_map;
+}
+
+static bool read_material_names(FILE *file, uint32_t name_count,
+                                const World_Objects_Container *world_objects_container,
+                                Material_Id                   *out_ids) {
+  char name[UINT16_MAX + 1];
+  for (uint32_t i = 0; i < name_count; i++) {
+    uint16_t length;
+    if (fread(&length, sizeof(length), 1, file) != 1 ||
+        fread(name, 1, length, file) != length) {
+      return false;
+    }
+    name[length] = '\0';
+    out_ids[i]   = find_material_id(world_objects_container, name);
+  }
+  return true;
+}
+
+static bool read_material_layer(FILE *file, Material_Id *layer,
+                                size_t cell_count, const Material_Id *ids,
+                                uint32_t name_count) {
+  if (fread(layer, sizeof(Material_Id), cell_count, file) != cell_count) {
+    return false;
+  }
+  for (size_t i = 0; i < cell_count; i++) {
+    if (layer[i] != MATERIAL_ID_EMPTY) {
+      layer[i] = layer[i] < name_count ? ids[layer[i]] : MATERIAL_ID_EMPTY;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,21 @@
+#ifndef TILE_MAP_IO_H
+#define TILE_MAP_IO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../assets/textures/types.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/tile-map.h"
+#include "../data/grid/types.h"
+
+#define TILE_MAP_FILE_MAGIC 0x50414D54u // "TMAP" when read little endian
+#define TILE_MAP_FILE_VERSION 1u
+
+extern bool write_tile_map_file(const char *filename, const Tile_Map *tile_map, const World_Objects_Container *world_objects_container);
+extern Tile_Map *read_tile_map_file(const char *filename, const World_Objects_Container *world_objects_container);
+
+#endif
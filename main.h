@@ -1,12 +1,6 @@
 #ifndef MAIN_H
 #define MAIN_H
 
-// Input helpers
-#define KEY_UP (1 << 0)
-#define KEY_DOWN (1 << 1)
-#define KEY_LEFT (1 << 2)
-#define KEY_RIGHT (1 << 3)
-
 #include <math.h>
 #include <stdbool.h>
 #include <stdlib.h>
@@ -24,17 +18,37 @@
 #include <SDL3_ttf/SDL_ttf.h>
 #include <SDL3_mixer/SDL_mixer.h>
 
+#include "./assets/sprites/setup.h"
+#include "./audio/audio.h"
+#include "./assets/textures/animation.h"
 #include "./assets/textures/constants.h"
 #include "./assets/textures/setup.h"
 #include "./config/constants.h"
 #include "./config/sdl/sdl.h"
 #include "./data/grid/constants.h"
+#include "./data/grid/lightmap.h"
+#include "./data/grid/pvs.h"
+#include "./data/grid/tile-map.h"
 #include "./data/grid/types.h"
+#include "./data/spatial/spatial-hash.h"
+#include "./engine/engine.h"
+#include "./engine/input-log.h"
 #include "./io/level-io.h"
+#include "./objects/collision/collision.h"
 #include "./objects/types.h"
 #include "./objects/player/constants.h"
 #include "./objects/player/types.h"
+#include "./render/constants.h"
+#include "./render/debug-overlay.h"
+#include "./render/fog.h"
+#include "./render/g-buffer.h"
+#include "./render/indexed-renderer.h"
+#include "./render/minimap.h"
+#include "./render/ray-cache.h"
+#include "./render/strip-view.h"
+#include "./render/types.h"
 #include "./types/algebraic-types.h"
 #include "./utils/math-utils.h"
+#include "./utils/radix-sort.h"
 
 #endif
@@ -0,0 +1,156 @@
+#include "./collision.h"
+
+static bool is_column_blocked(const Tile_Map *tile_map, int grid_x,
+                              int grid_y_start, int grid_y_end,
+                              uint8_t collision_mask);
+static bool is_row_blocked(const Tile_Map *tile_map, int grid_y,
+                           int grid_x_start, int grid_x_end,
+                           uint8_t collision_mask);
+static Point_1D sweep_axis_x(const Tile_Map *tile_map, Collision_Body *body);
+static Point_1D sweep_axis_y(const Tile_Map *tile_map, Collision_Body *body);
+
+/*
+ * Swept AABB against the tile map, resolved one axis at a time so a blocked
+ * axis does not cancel the other (wall sliding). Every cell the leading edge
+ * passes through is tested, so fast bodies cannot tunnel through walls.
+ */
+extern void sweep_collision_body(const Tile_Map *tile_map, Collision_Body *body)
+{
+  body->is_hit_x = false;
+  body->is_hit_y = false;
+
+  body->position.x = sweep_axis_x(tile_map, body);
+  body->position.y = sweep_axis_y(tile_map, body);
+
+  body->displacement.x = 0;
+  body->displacement.y = 0;
+}
+
+extern void sweep_collision_bodies(const Tile_Map *tile_map,
+                                   Collision_Body *bodies, size_t length)
+{
+  for (size_t i = 0; i < length; i++)
+  {
+    sweep_collision_body(tile_map, &bodies[i]);
+  }
+}
+
+static Point_1D sweep_axis_x(const Tile_Map *tile_map, Collision_Body *body)
+{
+  Point_1D x = body->position.x;
+  Vector_1D dx = body->displacement.x;
+  if (dx == 0)
+  {
+    return x;
+  }
+
+  IPoint_1D grid_y_start = floorf(body->position.y / GRID_CELL_SIZE);
+  IPoint_1D grid_y_end =
+      floorf((body->position.y + body->size.y - COLLISION_SKIN) / GRID_CELL_SIZE);
+
+  if (dx > 0)
+  {
+    Point_1D leading_edge = x + body->size.x - COLLISION_SKIN;
+    IPoint_1D grid_x_start = (IPoint_1D)floorf(leading_edge / GRID_CELL_SIZE) + 1;
+    IPoint_1D grid_x_end = floorf((leading_edge + dx) / GRID_CELL_SIZE);
+    for (IPoint_1D grid_x = grid_x_start; grid_x <= grid_x_end; grid_x++)
+    {
+      if (is_column_blocked(tile_map, grid_x, grid_y_start, grid_y_end,
+                            body->collision_mask))
+      {
+        body->is_hit_x = true;
+        return grid_x * GRID_CELL_SIZE - body->size.x;
+      }
+    }
+  }
+  else
+  {
+    IPoint_1D grid_x_start = (IPoint_1D)floorf(x / GRID_CELL_SIZE) - 1;
+    IPoint_1D grid_x_end = floorf((x + dx) / GRID_CELL_SIZE);
+    for (IPoint_1D grid_x = grid_x_start; grid_x >= grid_x_end; grid_x--)
+    {
+      if (is_column_blocked(tile_map, grid_x, grid_y_start, grid_y_end,
+                            body->collision_mask))
+      {
+        body->is_hit_x = true;
+        return (grid_x + 1) * GRID_CELL_SIZE;
+      }
+    }
+  }
+
+  return x + dx;
+}
+
+static Point_1D sweep_axis_y(const Tile_Map *tile_map, Collision_Body *body)
+{
+  Point_1D y = body->position.y;
+  Vector_1D dy = body->displacement.y;
+  if (dy == 0)
+  {
+    return y;
+  }
+
+  IPoint_1D grid_x_start = floorf(body->position.x / GRID_CELL_SIZE);
+  IPoint_1D grid_x_end =
+      floorf((body->position.x + body->size.x - COLLISION_SKIN) / GRID_CELL_SIZE);
+
+  if (dy > 0)
+  {
+    Point_1D leading_edge = y + body->size.y - COLLISION_SKIN;
+    IPoint_1D grid_y_start = (IPoint_1D)floorf(leading_edge / GRID_CELL_SIZE) + 1;
+    IPoint_1D grid_y_end = floorf((leading_edge + dy) / GRID_CELL_SIZE);
+    for (IPoint_1D grid_y = grid_y_start; grid_y <= grid_y_end; grid_y++)
+    {
+      if (is_row_blocked(tile_map, grid_y, grid_x_start, grid_x_end,
+                         body->collision_mask))
+      {
+        body->is_hit_y = true;
+        return grid_y * GRID_CELL_SIZE - body->size.y;
+      }
+    }
+  }
+  else
+  {
+    IPoint_1D grid_y_start = (IPoint_1D)floorf(y / GRID_CELL_SIZE) - 1;
+    IPoint_1D grid_y_end = floorf((y + dy) / GRID_CELL_SIZE);
+    for (IPoint_1D grid_y = grid_y_start; grid_y >= grid_y_end; grid_y--)
+    {
+      if (is_row_blocked(tile_map, grid_y, grid_x_start, grid_x_end,
+                         body->collision_mask))
+      {
+        body->is_hit_y = true;
+        return (grid_y + 1) * GRID_CELL_SIZE;
+      }
+    }
+  }
+
+  return y + dy;
+}
+
+static bool is_column_blocked(const Tile_Map *tile_map, int grid_x,
+                              int grid_y_start, int grid_y_end,
+                              uint8_t collision_mask)
+{
+  for (int grid_y = grid_y_start; grid_y <= grid_y_end; grid_y++)
+  {
+    if (get_tile_collision_bits(tile_map, grid_x, grid_y) & collision_mask)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool is_row_blocked(const Tile_Map *tile_map, int grid_y,
+                           int grid_x_start, int grid_x_end,
+                           uint8_t collision_mask)
+{
+  for (int grid_x = grid_x_start; grid_x <= grid_x_end; grid_x++)
+  {
+    if (get_tile_collision_bits(tile_map, grid_x, grid_y) & collision_mask)
+    {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,15 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <math.h>
+#include <stddef.h>
+
+#include "../../data/grid/constants.h"
+#include "../../data/grid/tile-map.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern void sweep_collision_body(const Tile_Map *tile_map, Collision_Body *body);
+extern void sweep_collision_bodies(const Tile_Map *tile_map, Collision_Body *bodies, size_t length);
+
+#endif
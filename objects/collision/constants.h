@@ -0,0 +1,12 @@
+#ifndef COLLISION_CONSTANTS_H
+#define COLLISION_CONSTANTS_H
+
+// Gap kept between a body and the tile it was stopped by
+#define COLLISION_SKIN 0.001f
+
+// Rays traversed in lockstep by the batched raycast path
+#define RAYCAST_LANES 8
+// Lines of sight converted to queries per batched call
+#define RAYCAST_LOS_BATCH_SIZE 64
+
+#endif
@@ -0,0 +1,341 @@
+#include "./raycast.h"
+
+// DDA state of one ray, in cells along the normalized direction
+typedef struct Raycast_Ray
+{
+  IPoint_2D cell;
+  IVector_2D step;
+  Vector_2D delta;
+  Vector_2D side; // distance to the next vertical and horizontal cell edge
+  Vector_2D direction;
+  Scalar max_t;
+} Raycast_Ray;
+
+#if defined(__GNUC__)
+typedef float Lane_Float __attribute__((vector_size(RAYCAST_LANES * sizeof(float))));
+typedef int32_t Lane_Int __attribute__((vector_size(RAYCAST_LANES * sizeof(int32_t))));
+
+// Per lane a where mask is set, else b. A macro so vectors never cross a call
+#define SELECT_LANE_FLOATS(mask, a, b)                                         \
+  ((Lane_Float)(((Lane_Int)(a) & (mask)) | ((Lane_Int)(b) & ~(mask))))
+#define SELECT_LANE_INTS(mask, a, b) (((a) & (mask)) | ((b) & ~(mask)))
+
+static void cast_tile_ray_lanes(const Tile_Map *tile_map,
+                                const Raycast_Query *queries,
+                                Raycast_Hit *out_hits, size_t length);
+static bool is_any_lane_set(const Lane_Int *mask);
+#endif
+static Raycast_Query get_line_query(const Line_2D *line, uint8_t collision_mask);
+static bool start_raycast_ray(const Tile_Map *tile_map,
+                              const Raycast_Query *query, Raycast_Ray *out_ray,
+                              Raycast_Hit *out_hit);
+static bool enter_raycast_cell(const Tile_Map *tile_map,
+                               const Raycast_Query *query,
+                               const Raycast_Ray *ray, Scalar t,
+                               bool is_x_step, Raycast_Hit *out_hit);
+
+/*
+ * First cell along the ray whose collision bits intersect the mask, using the
+ * same grid DDA as the renderer. Cells outside the map count as floor and
+ * wall, like they do for movement.
+ */
+extern bool cast_tile_ray(const Tile_Map *tile_map, const Raycast_Query *query,
+                          Raycast_Hit *out_hit)
+{
+  Raycast_Ray ray;
+  if (!start_raycast_ray(tile_map, query, &ray, out_hit))
+  {
+    return out_hit->is_hit;
+  }
+
+  while (true)
+  {
+    bool is_x_step = ray.side.x < ray.side.y;
+    Scalar t = is_x_step ? ray.side.x : ray.side.y;
+    if (t > ray.max_t)
+    {
+      return false;
+    }
+
+    if (is_x_step)
+    {
+      ray.cell.x += ray.step.x;
+      ray.side.x += ray.delta.x;
+    }
+    else
+    {
+      ray.cell.y += ray.step.y;
+      ray.side.y += ray.delta.y;
+    }
+
+    if (!enter_raycast_cell(tile_map, query, &ray, t, is_x_step, out_hit))
+    {
+      return out_hit->is_hit;
+    }
+  }
+}
+
+// Same results as cast_tile_ray per query, stepped in vector registers
+extern void cast_tile_rays(const Tile_Map *tile_map,
+                           const Raycast_Query *queries, Raycast_Hit *out_hits,
+                           size_t length)
+{
+#if defined(__GNUC__)
+  cast_tile_ray_lanes(tile_map, queries, out_hits, length);
+#else
+  for (size_t i = 0; i < length; i++)
+  {
+    cast_tile_ray(tile_map, &queries[i], &out_hits[i]);
+  }
+#endif
+}
+
+// A point inside a blocking cell is not visible from outside it
+extern bool has_line_of_sight(const Tile_Map *tile_map, Line_2D line,
+                              uint8_t collision_mask)
+{
+  Raycast_Query query = get_line_query(&line, collision_mask);
+  Raycast_Hit hit;
+  return !cast_tile_ray(tile_map, &query, &hit) ||
+         hit.distance >= query.max_distance;
+}
+
+extern void check_lines_of_sight(const Tile_Map *tile_map,
+                                 const Line_2D *lines, size_t length,
+                                 uint8_t collision_mask, bool *out_is_visible)
+{
+  Raycast_Query queries[RAYCAST_LOS_BATCH_SIZE];
+  Raycast_Hit hits[RAYCAST_LOS_BATCH_SIZE];
+
+  for (size_t i = 0; i < length; i += RAYCAST_LOS_BATCH_SIZE)
+  {
+    size_t batch_length = length - i < RAYCAST_LOS_BATCH_SIZE
+                              ? length - i
+                              : RAYCAST_LOS_BATCH_SIZE;
+    for (size_t j = 0; j < batch_length; j++)
+    {
+      queries[j] = get_line_query(&lines[i + j], collision_mask);
+    }
+
+    cast_tile_rays(tile_map, queries, hits, batch_length);
+    for (size_t j = 0; j < batch_length; j++)
+    {
+      out_is_visible[i + j] =
+          !hits[j].is_hit || hits[j].distance >= queries[j].max_distance;
+    }
+  }
+}
+
+#if defined(__GNUC__)
+/*
+ * Lockstep DDA over RAYCAST_LANES rays. A lane whose ray finishes is refilled
+ * with the next query straight away, so long and short rays do not leave
+ * lanes idle.
+ */
+static void cast_tile_ray_lanes(const Tile_Map *tile_map,
+                                const Raycast_Query *queries,
+                                Raycast_Hit *out_hits, size_t length)
+{
+  Raycast_Ray rays[RAYCAST_LANES];
+  size_t query_indexes[RAYCAST_LANES];
+  Lane_Int is_active = {0}, collision_masks = {0};
+  Lane_Int cell_x = {0}, cell_y = {0}, step_x = {0}, step_y = {0};
+  Lane_Float side_x = {0}, side_y = {0}, delta_x = {0}, delta_y = {0};
+  Lane_Float max_t = {0};
+  Lane_Float zero = {0};
+  Lane_Int width = {0}, height = {0};
+  width += (int32_t)tile_map->width;
+  height += (int32_t)tile_map->height;
+  size_t next_query = 0;
+  bool is_refill_needed = true;
+
+  while (true)
+  {
+    for (int lane = 0; is_refill_needed && lane < RAYCAST_LANES; lane++)
+    {
+      while (!is_active[lane] && next_query < length)
+      {
+        size_t i = next_query++;
+        Raycast_Ray *ray = &rays[lane];
+        if (!start_raycast_ray(tile_map, &queries[i], ray, &out_hits[i]))
+        {
+          continue;
+        }
+        query_indexes[lane] = i;
+        is_active[lane] = -1;
+        collision_masks[lane] = queries[i].collision_mask;
+        cell_x[lane] = ray->cell.x;
+        cell_y[lane] = ray->cell.y;
+        step_x[lane] = ray->step.x;
+        step_y[lane] = ray->step.y;
+        side_x[lane] = ray->side.x;
+        side_y[lane] = ray->side.y;
+        delta_x[lane] = ray->delta.x;
+        delta_y[lane] = ray->delta.y;
+        max_t[lane] = ray->max_t;
+      }
+    }
+    if (!is_any_lane_set(&is_active))
+    {
+      return;
+    }
+    is_refill_needed = false;
+
+    Lane_Int is_x_step = side_x < side_y;
+    Lane_Float t = SELECT_LANE_FLOATS(is_x_step, side_x, side_y);
+
+    // Lanes past their max distance are misses, their hit is already cleared
+    Lane_Int is_far = is_active & (t > max_t);
+    is_active &= ~is_far;
+    is_refill_needed = is_any_lane_set(&is_far);
+
+    Lane_Int x_mask = is_x_step & is_active;
+    Lane_Int y_mask = ~is_x_step & is_active;
+    cell_x += step_x & x_mask;
+    cell_y += step_y & y_mask;
+    side_x += SELECT_LANE_FLOATS(x_mask, delta_x, zero);
+    side_y += SELECT_LANE_FLOATS(y_mask, delta_y, zero);
+
+    // Only the collision bit loads are per lane, outside the map is solid
+    Lane_Int is_inside = (cell_x >= 0) & (cell_y >= 0) & (cell_x < width) &
+                         (cell_y < height);
+    Lane_Int cell_indexes = (cell_y * width + cell_x) & is_inside;
+    Lane_Int bits;
+    for (int lane = 0; lane < RAYCAST_LANES; lane++)
+    {
+      bits[lane] = tile_map->collision_bits[cell_indexes[lane]];
+    }
+    bits = SELECT_LANE_INTS(is_inside, bits, COLLISION_MODE_FLOOR | COLLISION_MODE_WALL);
+    Lane_Int is_done = is_active & (((bits & collision_masks) != 0) | ~is_inside);
+    if (!is_any_lane_set(&is_done))
+    {
+      continue;
+    }
+    is_refill_needed = true;
+
+    for (int lane = 0; lane < RAYCAST_LANES; lane++)
+    {
+      if (!is_done[lane])
+      {
+        continue;
+      }
+      size_t i = query_indexes[lane];
+      rays[lane].cell.x = cell_x[lane];
+      rays[lane].cell.y = cell_y[lane];
+      enter_raycast_cell(tile_map, &queries[i], &rays[lane], t[lane],
+                         is_x_step[lane], &out_hits[i]);
+    }
+    is_active &= ~is_done;
+  }
+}
+
+static bool is_any_lane_set(const Lane_Int *mask)
+{
+  int32_t is_any = 0;
+  for (int lane = 0; lane < RAYCAST_LANES; lane++)
+  {
+    is_any |= (*mask)[lane];
+  }
+  return is_any != 0;
+}
+#endif
+
+static Raycast_Query get_line_query(const Line_2D *line, uint8_t collision_mask)
+{
+  Vector_2D direction = {
+      .x = line->end.x - line->start.x,
+      .y = line->end.y - line->start.y,
+  };
+  return (Raycast_Query){
+      .origin = line->start,
+      .direction = direction,
+      .max_distance = sqrtf(direction.x * direction.x + direction.y * direction.y),
+      .collision_mask = collision_mask,
+  };
+}
+
+/*
+ * Clears out_hit and sets up the DDA. Returns false when there is nothing to
+ * traverse: the origin cell already blocks, or the direction is zero.
+ */
+static bool start_raycast_ray(const Tile_Map *tile_map,
+                              const Raycast_Query *query, Raycast_Ray *out_ray,
+                              Raycast_Hit *out_hit)
+{
+  *out_hit = (Raycast_Hit){0};
+
+  Point_1D norm_x = query->origin.x / GRID_CELL_SIZE;
+  Point_1D norm_y = query->origin.y / GRID_CELL_SIZE;
+  out_ray->cell.x = floorf(norm_x);
+  out_ray->cell.y = floorf(norm_y);
+
+  if (get_tile_collision_bits(tile_map, out_ray->cell.x, out_ray->cell.y) &
+      query->collision_mask)
+  {
+    out_hit->is_hit = true;
+    out_hit->cell = out_ray->cell;
+    out_hit->point = query->origin;
+    return false;
+  }
+
+  Scalar length = sqrtf(query->direction.x * query->direction.x +
+                        query->direction.y * query->direction.y);
+  if (length == 0)
+  {
+    return false;
+  }
+
+  Vector_1D x_dir = query->direction.x / length;
+  Vector_1D y_dir = query->direction.y / length;
+  out_ray->direction.x = x_dir;
+  out_ray->direction.y = y_dir;
+  out_ray->step.x = (x_dir >= 0) ? 1 : -1;
+  out_ray->step.y = (y_dir >= 0) ? 1 : -1;
+  out_ray->delta.x = fabsf(1.0f / x_dir);
+  out_ray->delta.y = fabsf(1.0f / y_dir);
+  out_ray->side.x = (x_dir < 0) ? (norm_x - out_ray->cell.x) * out_ray->delta.x
+                                : (out_ray->cell.x + 1 - norm_x) * out_ray->delta.x;
+  out_ray->side.y = (y_dir < 0) ? (norm_y - out_ray->cell.y) * out_ray->delta.y
+                                : (out_ray->cell.y + 1 - norm_y) * out_ray->delta.y;
+  out_ray->max_t = query->max_distance / GRID_CELL_SIZE;
+  return true;
+}
+
+/*
+ * Tests the cell the ray just stepped into, t cells from the origin. Returns
+ * false once the ray is done, with out_hit filled in when it was stopped.
+ */
+static bool enter_raycast_cell(const Tile_Map *tile_map,
+                               const Raycast_Query *query,
+                               const Raycast_Ray *ray, Scalar t,
+                               bool is_x_step, Raycast_Hit *out_hit)
+{
+  if (!(get_tile_collision_bits(tile_map, ray->cell.x, ray->cell.y) &
+        query->collision_mask))
+  {
+    // Past the map edge nothing else can block
+    return ray->cell.x >= 0 && ray->cell.y >= 0 &&
+           (size_t)ray->cell.x < tile_map->width &&
+           (size_t)ray->cell.y < tile_map->height;
+  }
+
+  Scalar distance = t * GRID_CELL_SIZE;
+  out_hit->is_hit = true;
+  out_hit->cell = ray->cell;
+  out_hit->distance = distance;
+  if (is_x_step)
+  {
+    out_hit->point.x = (ray->step.x > 0 ? ray->cell.x : ray->cell.x + 1) *
+                       GRID_CELL_SIZE;
+    out_hit->point.y = query->origin.y + ray->direction.y * distance;
+    out_hit->normal.x = -ray->step.x;
+  }
+  else
+  {
+    out_hit->point.x = query->origin.x + ray->direction.x * distance;
+    out_hit->point.y = (ray->step.y > 0 ? ray->cell.y : ray->cell.y + 1) *
+                       GRID_CELL_SIZE;
+    out_hit->normal.y = -ray->step.y;
+  }
+  return false;
+}
@@ -0,0 +1,24 @@
+#ifndef RAYCAST_H
+#define RAYCAST_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../../data/grid/constants.h"
+#include "../../data/grid/tile-map.h"
+#include "./constants.h"
+#include "./types.h"
+
+/*
+ * Tile map ray queries for gameplay. They only read the tile map and keep no
+ * state, so any number of threads can query the same map at once as long as
+ * nothing edits it meanwhile.
+ */
+extern bool cast_tile_ray(const Tile_Map *tile_map, const Raycast_Query *query, Raycast_Hit *out_hit);
+extern void cast_tile_rays(const Tile_Map *tile_map, const Raycast_Query *queries, Raycast_Hit *out_hits, size_t length);
+extern bool has_line_of_sight(const Tile_Map *tile_map, Line_2D line, uint8_t collision_mask);
+extern void check_lines_of_sight(const Tile_Map *tile_map, const Line_2D *lines, size_t length, uint8_t collision_mask, bool *out_is_visible);
+
+#endif
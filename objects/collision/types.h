@@ -0,0 +1,36 @@
+#ifndef COLLISION_TYPES_H
+#define COLLISION_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "../../types/algebraic-types.h"
+
+typedef struct Collision_Body
+{
+  Point_2D position;      // top-left of the AABB
+  Vector_2D size;
+  Vector_2D displacement; // requested movement, consumed by the sweep
+  uint8_t collision_mask; // COLLISION_MODE_* bits this body is stopped by
+  bool is_hit_x;
+  bool is_hit_y;
+} Collision_Body;
+
+typedef struct Raycast_Query
+{
+  Point_2D origin;
+  Vector_2D direction;    // any length but zero
+  Scalar max_distance;    // world units, finite
+  uint8_t collision_mask; // COLLISION_MODE_* bits that stop the ray
+} Raycast_Query;
+
+typedef struct Raycast_Hit
+{
+  bool is_hit;
+  IPoint_2D cell;
+  Point_2D point;
+  Vector_2D normal; // of the face entered, zero when the origin is inside a blocked cell
+  Scalar distance;  // from the origin, in world units
+} Raycast_Hit;
+
+#endif
@@ -4,6 +4,7 @@
 #define PLAYER_MOTION_DELTA_MULTIPLIER 5
 #define PLAYER_FOV_DEG 60
 #define PLAYER_FOV_DEG_INC 0.375f
+#define PLAYER_RAY_COUNT 161 // PLAYER_FOV_DEG / PLAYER_FOV_DEG_INC + 1
 #define PLAYER_W 8.0f
 #define PLAYER_H 8.0f
 #define PLAYER_INTERACTION_DISTANCE 4.0f
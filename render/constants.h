@@ -0,0 +1,67 @@
+#ifndef RENDER_CONSTANTS_H
+#define RENDER_CONSTANTS_H
+
+// Software framebuffers cover the same screen region as the SDL renderer path
+#define SOFTWARE_RENDER_W (WINDOW_W / 2)
+#define SOFTWARE_RENDER_H WINDOW_H
+#define SOFTWARE_RENDER_X (WINDOW_W / 4)
+
+// SDL_Renderer strip view, ray angles come from a 0.3 degree trig table
+#define STRIP_VIEW_LUT_ANGLES 1200
+#define STRIP_VIEW_LUT_STEP_DEG 0.3f
+
+// Palette index 0 is reserved for transparent texels
+#define PALETTE_SIZE 256
+#define PALETTE_TRANSPARENT_INDEX 0
+#define PALETTE_ALPHA_THRESHOLD 128
+#define RGB555_SIZE (1 << 15)
+
+/*
+ * Square power of two texture sizes that get their own sampling kernels,
+ * anything else takes the generic path. X macro, X(size) per entry.
+ */
+#define TEXTURE_KERNEL_SIZES(X) X(16) X(32) X(64) X(128)
+
+// Fog / light shading, level 0 is full brightness, the last level is fog
+#define COLORMAP_LEVELS 32
+#define COLORMAP_MAX_DIMMING 1.0f
+#define COLORMAP_LEVELS_PER_LIGHT_LEVEL 2 // darkening per missing light level
+
+// Fog is also the clear colour, so anything past the view distance is free
+#define FOG_COLOR_R 30
+#define FOG_COLOR_G 0
+#define FOG_COLOR_B 30
+#define FOG_START_FRACTION 0.5f // of the view distance
+#define VIEW_DISTANCE_DEFAULT (GRID_CELL_SIZE * 12)
+#define VIEW_DISTANCE_MIN (GRID_CELL_SIZE * 2)
+#define VIEW_DISTANCE_MAX (GRID_CELL_SIZE * 64)
+#define VIEW_DISTANCE_STEP GRID_CELL_SIZE
+
+// Printable ASCII is rasterized once into the glyph atlas
+#define GLYPH_FIRST 32
+#define GLYPH_LAST 126
+#define GLYPH_COUNT (GLYPH_LAST - GLYPH_FIRST + 1)
+#define GLYPH_ATLAS_W 512
+#define GLYPH_PADDING 1
+#define FONT_PATH "./assets/fonts/PressStart2P-Regular.ttf"
+
+#define OVERLAY_GRAPH_SAMPLES 240 // frames of history
+#define OVERLAY_GRAPH_BAR_W 1
+#define OVERLAY_GRAPH_H 80
+#define OVERLAY_GRAPH_MAX_MS 50.0f // top of the graph
+#define OVERLAY_TARGET_MS (1000.0f / 60.0f)
+#define OVERLAY_MAX_LINES 12
+#define OVERLAY_LINE_LENGTH 64
+#define OVERLAY_MARGIN 8
+
+// Minimap texture, drawn in the free quarter right of the view
+#define MINIMAP_CELL_PX 8 // shrinks for maps wider than the texture limit
+#define MINIMAP_CELL_GAP 1
+#define MINIMAP_MAX_TEXTURE_PX 8192
+#define MINIMAP_ZOOM_DEFAULT 24.0f // cells across the view
+#define MINIMAP_ZOOM_MIN 8.0f
+#define MINIMAP_ZOOM_STEP 1.25f
+#define MINIMAP_MARKER_SIZE 8.0f
+#define MINIMAP_MARGIN 8
+
+#endif
@@ -0,0 +1,150 @@
+#include "./debug-overlay.h"
+
+typedef enum Frame_Bucket {
+  FRAME_BUCKET_ON_TARGET,
+  FRAME_BUCKET_SLOW,
+  FRAME_BUCKET_DROPPED,
+  FRAME_BUCKET_COUNT,
+} Frame_Bucket;
+
+static const SDL_Color FRAME_BUCKET_COLORS[FRAME_BUCKET_COUNT] = {
+    [FRAME_BUCKET_ON_TARGET] = {80, 220, 80, 255},
+    [FRAME_BUCKET_SLOW]      = {240, 200, 40, 255},
+    [FRAME_BUCKET_DROPPED]   = {240, 60, 60, 255},
+};
+
+static void draw_frame_graph(SDL_Renderer *renderer,
+                             const Debug_Overlay *debug_overlay, float x,
+                             float y);
+
+// NULL when the font cannot be loaded
+extern Debug_Overlay *create_debug_overlay(SDL_Renderer *renderer) {
+  Glyph_Atlas *glyph_atlas = create_glyph_atlas(renderer, FONT_PATH, FONT_SMALL);
+  if (!glyph_atlas) {
+    return NULL;
+  }
+  Debug_Overlay *debug_overlay = calloc(1, sizeof(Debug_Overlay));
+  if (!debug_overlay) {
+    free_glyph_atlas(glyph_atlas);
+    return NULL;
+  }
+  debug_overlay->glyph_atlas = glyph_atlas;
+  debug_overlay->is_visible  = true;
+  return debug_overlay;
+}
+
+extern void record_overlay_frame(Debug_Overlay *debug_overlay, float frame_ms) {
+  debug_overlay->frame_ms[debug_overlay->frame_index] = frame_ms;
+  debug_overlay->frame_index =
+      (debug_overlay->frame_index + 1) % OVERLAY_GRAPH_SAMPLES;
+}
+
+// Text is formatted here, not per frame, so update lines as rarely as they change
+extern void set_overlay_line(Debug_Overlay *debug_overlay, int index,
+                             const char *format, ...) {
+  if (index < 0 || index >= OVERLAY_MAX_LINES) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  vsnprintf(debug_overlay->lines[index], OVERLAY_LINE_LENGTH, format, args);
+  va_end(args);
+  if (index >= debug_overlay->line_count) {
+    debug_overlay->line_count = index + 1;
+  }
+}
+
+/*
+ * Panel, frame time graph and text lines in the top left corner. A handful of
+ * draw calls however many lines there are: the text is one geometry batch.
+ */
+extern void draw_debug_overlay(SDL_Renderer  *renderer,
+                               Debug_Overlay *debug_overlay) {
+  if (!debug_overlay || !debug_overlay->is_visible) {
+    return;
+  }
+  Glyph_Atlas *glyph_atlas = debug_overlay->glyph_atlas;
+  float        x           = OVERLAY_MARGIN;
+  float        y           = OVERLAY_MARGIN;
+  float        text_y      = y + OVERLAY_GRAPH_H + OVERLAY_MARGIN;
+
+  float text_w = 0;
+  for (int i = 0; i < debug_overlay->line_count; i++) {
+    float line_w = measure_text(glyph_atlas, debug_overlay->lines[i]);
+    text_w       = line_w > text_w ? line_w : text_w;
+  }
+  float     graph_w = OVERLAY_GRAPH_SAMPLES * OVERLAY_GRAPH_BAR_W;
+  SDL_FRect panel   = {
+      .x = 0,
+      .y = 0,
+      .w = (graph_w > text_w ? graph_w : text_w) + OVERLAY_MARGIN * 2,
+      .h = text_y + debug_overlay->line_count * glyph_atlas->line_height +
+           OVERLAY_MARGIN,
+  };
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 160);
+  SDL_RenderFillRect(renderer, &panel);
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+  draw_frame_graph(renderer, debug_overlay, x, y);
+
+  SDL_Color white = {255, 255, 255, 255};
+  for (int i = 0; i < debug_overlay->line_count; i++) {
+    queue_text(glyph_atlas, x, text_y + i * glyph_atlas->line_height,
+               debug_overlay->lines[i], white);
+  }
+  flush_text(renderer, glyph_atlas);
+}
+
+extern void free_debug_overlay(Debug_Overlay *debug_overlay) {
+  if (!debug_overlay) {
+    return;
+  }
+  free_glyph_atlas(debug_overlay->glyph_atlas);
+  free(debug_overlay);
+}
+
+/*
+ * One bar per recorded frame, oldest on the left, batched into a fill call
+ * per colour. The line marks the frame time target.
+ */
+static void draw_frame_graph(SDL_Renderer        *renderer,
+                             const Debug_Overlay *debug_overlay, float x,
+                             float y) {
+  SDL_FRect bars[FRAME_BUCKET_COUNT][OVERLAY_GRAPH_SAMPLES];
+  int       bar_counts[FRAME_BUCKET_COUNT] = {0};
+  float     px_per_ms = OVERLAY_GRAPH_H / OVERLAY_GRAPH_MAX_MS;
+
+  for (int i = 0; i < OVERLAY_GRAPH_SAMPLES; i++) {
+    float frame_ms = debug_overlay->frame_ms[(debug_overlay->frame_index + i) %
+                                             OVERLAY_GRAPH_SAMPLES];
+    if (frame_ms <= 0.0f) {
+      continue;
+    }
+    Frame_Bucket bucket = frame_ms <= OVERLAY_TARGET_MS       ? FRAME_BUCKET_ON_TARGET
+                          : frame_ms <= OVERLAY_TARGET_MS * 2 ? FRAME_BUCKET_SLOW
+                                                              : FRAME_BUCKET_DROPPED;
+    float h = frame_ms * px_per_ms;
+    h       = h > OVERLAY_GRAPH_H ? OVERLAY_GRAPH_H : h;
+    bars[bucket][bar_counts[bucket]++] = (SDL_FRect){
+        .x = x + i * OVERLAY_GRAPH_BAR_W,
+        .y = y + OVERLAY_GRAPH_H - h,
+        .w = OVERLAY_GRAPH_BAR_W,
+        .h = h,
+    };
+  }
+
+  for (int bucket = 0; bucket < FRAME_BUCKET_COUNT; bucket++) {
+    if (bar_counts[bucket] == 0) {
+      continue;
+    }
+    SDL_Color color = FRAME_BUCKET_COLORS[bucket];
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRects(renderer, bars[bucket], bar_counts[bucket]);
+  }
+
+  float target_y = y + OVERLAY_GRAPH_H - OVERLAY_TARGET_MS * px_per_ms;
+  SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+  SDL_RenderLine(renderer, x, target_y,
+                 x + OVERLAY_GRAPH_SAMPLES * OVERLAY_GRAPH_BAR_W, target_y);
+}
@@ -0,0 +1,23 @@
+#ifndef DEBUG_OVERLAY_H
+#define DEBUG_OVERLAY_H
+
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_render.h>
+
+#include "../config/constants.h"
+#include "./constants.h"
+#include "./text.h"
+#include "./types.h"
+
+extern Debug_Overlay *create_debug_overlay(SDL_Renderer *renderer);
+extern void record_overlay_frame(Debug_Overlay *debug_overlay, float frame_ms);
+extern void set_overlay_line(Debug_Overlay *debug_overlay, int index, const char *format, ...);
+extern void draw_debug_overlay(SDL_Renderer *renderer, Debug_Overlay *debug_overlay);
+extern void free_debug_overlay(Debug_Overlay *debug_overlay);
+
+#endif
@@ -0,0 +1,290 @@
+#include "./fixed-caster.h"
+#include "./indexed-renderer.h"
+
+#define FIXED_DELTA_MAX ((int64_t)1 << 40) // ray parallel to an axis
+#define FIXED_MIN_PERP_DISTANCE (FIXED_ONE / 256)
+
+static void render_fixed_column(Indexed_Renderer   *indexed_renderer,
+                                const Render_Scene *scene,
+                                const Fixed_View *view, int x);
+static void draw_fixed_wall(Indexed_Renderer   *indexed_renderer,
+                            const Render_Scene *scene,
+                            const Fixed_View *view, int x,
+                            const Fixed_Ray_Hit *hit, Fixed cos_theta);
+static const uint8_t *get_fixed_colormap(const Indexed_Renderer *indexed_renderer,
+                                         const Fixed_View *view,
+                                         Fixed distance, uint8_t light);
+
+extern bool create_fixed_caster_tables(Fixed_Caster_Tables *tables, int w,
+                                       int h) {
+  tables->column_angles  = malloc(w * sizeof(Fixed_Angle));
+  tables->column_cos     = malloc(w * sizeof(Fixed));
+  tables->column_inv_cos = malloc(w * sizeof(Fixed));
+  tables->row_distances  = malloc(h * sizeof(Fixed));
+  if (!tables->column_angles || !tables->column_cos ||
+      !tables->column_inv_cos || !tables->row_distances) {
+    free_fixed_caster_tables(tables);
+    return false;
+  }
+
+  // Same linear angle spread as the float caster, in integer binary angles
+  int64_t fov = (int64_t)FIXED_ANGLE_STEPS * PLAYER_FOV_DEG / 360;
+  for (int x = 0; x < w; x++) {
+    tables->column_angles[x]  = (Fixed_Angle)(fov * x / w - fov / 2);
+    tables->column_cos[x]     = fixed_cos(tables->column_angles[x]);
+    tables->column_inv_cos[x] = fixed_div(FIXED_ONE, tables->column_cos[x]);
+  }
+
+  // distance = (h / 2) / (y - h / 2), doubled to stay integer for odd h
+  for (int y = 0; y < h; y++) {
+    tables->row_distances[y] =
+        2 * y > h ? (Fixed)(((int64_t)h << FIXED_SHIFT) / (2 * y - h)) : 0;
+  }
+
+  return true;
+}
+
+extern void render_fixed_columns(Indexed_Renderer   *indexed_renderer,
+                                 const Render_Scene *scene, Camera camera) {
+  Fixed_View view = create_fixed_view(scene, camera);
+  for (int x = 0; x < indexed_renderer->w; x++) {
+    render_fixed_column(indexed_renderer, scene, &view, x);
+  }
+}
+
+// Multiplying by a power of two is exact, so these match on every build
+extern Fixed_View create_fixed_view(const Render_Scene *scene, Camera camera) {
+  return (Fixed_View){
+      .angle     = convert_deg_to_fixed_angle(camera.angle),
+      .eye_x     = (Fixed)(camera.position.x * (FIXED_ONE / GRID_CELL_SIZE)),
+      .eye_y     = (Fixed)(camera.position.y * (FIXED_ONE / GRID_CELL_SIZE)),
+      .fog_start = (Fixed)(scene->fog.start_distance *
+                           (FIXED_ONE / GRID_CELL_SIZE)),
+      .fog_max   = (Fixed)(scene->fog.max_distance *
+                           (FIXED_ONE / GRID_CELL_SIZE)),
+  };
+}
+
+/*
+ * The float caster's DDA in 16.16 cells. Side distances are 64 bit so long
+ * rays near an axis cannot overflow, and the only divides are per ray.
+ * Hits and the return value are as for trace_indexed_ray.
+ */
+extern int trace_fixed_ray(const Render_Scene *scene, const Fixed_View *view,
+                           Fixed x_dir, Fixed y_dir, int64_t max_ray_distance,
+                           Fixed_Ray_Hit *hits, bool *out_is_wall_hit) {
+  const Tile_Map *tile_map = scene->tile_map;
+
+  int     grid_x  = view->eye_x >> FIXED_SHIFT;
+  int     grid_y  = view->eye_y >> FIXED_SHIFT;
+  int     step_x  = (x_dir >= 0) ? 1 : -1;
+  int     step_y  = (y_dir >= 0) ? 1 : -1;
+  int64_t delta_x = x_dir ? ((int64_t)1 << (2 * FIXED_SHIFT)) / abs(x_dir)
+                          : FIXED_DELTA_MAX;
+  int64_t delta_y = y_dir ? ((int64_t)1 << (2 * FIXED_SHIFT)) / abs(y_dir)
+                          : FIXED_DELTA_MAX;
+  Fixed   frac_x  = view->eye_x & (FIXED_ONE - 1);
+  Fixed   frac_y  = view->eye_y & (FIXED_ONE - 1);
+  int64_t side_x =
+      ((x_dir < 0 ? frac_x : FIXED_ONE - frac_x) * delta_x) >> FIXED_SHIFT;
+  int64_t side_y =
+      ((y_dir < 0 ? frac_y : FIXED_ONE - frac_y) * delta_y) >> FIXED_SHIFT;
+
+  int  hit_count   = 0;
+  bool is_wall_hit = false;
+  while (!is_wall_hit) {
+    if ((side_x < side_y ? side_x : side_y) > max_ray_distance) {
+      break;
+    }
+
+    Fixed distance;
+    bool  is_vertical;
+    if (side_x < side_y) {
+      distance    = (Fixed)side_x;
+      side_x     += delta_x;
+      grid_x     += step_x;
+      is_vertical = true;
+    } else {
+      distance    = (Fixed)side_y;
+      side_y     += delta_y;
+      grid_y     += step_y;
+      is_vertical = false;
+    }
+
+    if (grid_x < 0 || grid_y < 0 || (size_t)grid_x >= tile_map->width ||
+        (size_t)grid_y >= tile_map->height) {
+      break;
+    }
+
+    Material_Id wall_id =
+        tile_map->wall_ids[(size_t)grid_y * tile_map->width + grid_x];
+    if (wall_id == MATERIAL_ID_EMPTY) {
+      continue;
+    }
+
+    Fixed wall_u = is_vertical ? view->eye_y + fixed_mul(distance, y_dir)
+                               : view->eye_x + fixed_mul(distance, x_dir);
+    uint8_t light =
+        is_vertical
+            ? sample_lightmap(scene->lightmap, grid_x - step_x, grid_y)
+            : sample_lightmap(scene->lightmap, grid_x, grid_y - step_y);
+    hits[hit_count++] = (Fixed_Ray_Hit){
+        .material = wall_id,
+        .distance = distance,
+        .wall_u   = wall_u & (FIXED_ONE - 1),
+        .light    = light,
+    };
+    if ((tile_map->material_flags[wall_id] & MATERIAL_FLAG_OPAQUE) ||
+        hit_count == MAX_RAY_HITS) {
+      is_wall_hit = true;
+    }
+  }
+
+  *out_is_wall_hit = is_wall_hit;
+  return hit_count;
+}
+
+extern void free_fixed_caster_tables(Fixed_Caster_Tables *tables) {
+  free(tables->column_angles);
+  free(tables->column_cos);
+  free(tables->column_inv_cos);
+  free(tables->row_distances);
+  *tables = (Fixed_Caster_Tables){0};
+}
+
+static void render_fixed_column(Indexed_Renderer   *indexed_renderer,
+                                const Render_Scene *scene,
+                                const Fixed_View *view, int x) {
+  const Fixed_Caster_Tables *tables = &indexed_renderer->fixed_tables;
+
+  Fixed_Angle angle     = view->angle + tables->column_angles[x];
+  Fixed       x_dir     = fixed_cos(angle);
+  Fixed       y_dir     = fixed_sin(angle);
+  Fixed       cos_theta = tables->column_cos[x];
+  int64_t     max_ray_distance =
+      ((int64_t)view->fog_max * tables->column_inv_cos[x]) >> FIXED_SHIFT;
+
+  Fixed_Ray_Hit hits[MAX_RAY_HITS];
+  bool          is_wall_hit;
+  int hit_count = trace_fixed_ray(scene, view, x_dir, y_dir, max_ray_distance,
+                                  hits, &is_wall_hit);
+
+  int h             = indexed_renderer->h;
+  int floor_start_y = h / 2 + 1;
+  indexed_renderer->z_buffer[x] = INFINITY;
+  if (is_wall_hit) {
+    Fixed perp_distance = fixed_mul(hits[hit_count - 1].distance, cos_theta);
+    perp_distance       = perp_distance < FIXED_MIN_PERP_DISTANCE
+                              ? FIXED_MIN_PERP_DISTANCE
+                              : perp_distance;
+    int64_t wall_strip_h = ((int64_t)h << (2 * FIXED_SHIFT)) / perp_distance;
+    int     wall_bottom =
+        (int)((((int64_t)h << FIXED_SHIFT) + wall_strip_h) >> (FIXED_SHIFT + 1));
+    floor_start_y = wall_bottom > floor_start_y ? wall_bottom : floor_start_y;
+    indexed_renderer->z_buffer[x] =
+        perp_distance * (GRID_CELL_SIZE / FIXED_ONE);
+  }
+
+  draw_fixed_floor(indexed_renderer, scene, view, x,
+                   fixed_mul(x_dir, tables->column_inv_cos[x]),
+                   fixed_mul(y_dir, tables->column_inv_cos[x]), floor_start_y);
+
+  for (int i = hit_count - 1; i >= 0; i--) {
+    draw_fixed_wall(indexed_renderer, scene, view, x, &hits[i], cos_theta);
+  }
+}
+
+// draw_indexed_floor with per row distances from the tables
+extern void draw_fixed_floor(Indexed_Renderer   *indexed_renderer,
+                             const Render_Scene *scene,
+                             const Fixed_View *view, int x,
+                             Fixed floor_x_dir, Fixed floor_y_dir,
+                             int start_y) {
+  const Tile_Map *tile_map      = scene->tile_map;
+  const Fixed    *row_distances = indexed_renderer->fixed_tables.row_distances;
+  int             w             = indexed_renderer->w;
+
+  for (int y = start_y; y < indexed_renderer->h; y++) {
+    Fixed distance = row_distances[y];
+    if (distance > view->fog_max) {
+      continue;
+    }
+
+    Fixed world_x = view->eye_x + fixed_mul(floor_x_dir, distance);
+    Fixed world_y = view->eye_y + fixed_mul(floor_y_dir, distance);
+    if (world_x < 0 || world_y < 0) {
+      continue;
+    }
+
+    size_t grid_x = world_x >> FIXED_SHIFT;
+    size_t grid_y = world_y >> FIXED_SHIFT;
+    if (grid_x >= tile_map->width || grid_y >= tile_map->height) {
+      continue;
+    }
+
+    Material_Id floor_id = tile_map->floor_ids[grid_y * tile_map->width + grid_x];
+    if (floor_id == MATERIAL_ID_EMPTY) {
+      continue;
+    }
+
+    const Indexed_Texture *texture = get_material_texture(
+        indexed_renderer, scene->world_objects_container, floor_id);
+    uint8_t texel = sample_floor_texel_fixed(texture, world_x, world_y);
+    uint8_t light = sample_lightmap(scene->lightmap, grid_x, grid_y);
+    indexed_renderer->framebuffer[y * w + x] =
+        get_fixed_colormap(indexed_renderer, view, distance, light)[texel];
+  }
+}
+
+static void draw_fixed_wall(Indexed_Renderer   *indexed_renderer,
+                            const Render_Scene *scene,
+                            const Fixed_View *view, int x,
+                            const Fixed_Ray_Hit *hit, Fixed cos_theta) {
+  int   w             = indexed_renderer->w;
+  int   h             = indexed_renderer->h;
+  Fixed perp_distance = fixed_mul(hit->distance, cos_theta);
+  perp_distance       = perp_distance < FIXED_MIN_PERP_DISTANCE
+                            ? FIXED_MIN_PERP_DISTANCE
+                            : perp_distance;
+
+  // Screen rows in 16.16, the strip is h / perp_distance pixels tall
+  int64_t wall_strip_h = ((int64_t)h << (2 * FIXED_SHIFT)) / perp_distance;
+  int64_t wall_top     = (((int64_t)h << FIXED_SHIFT) - wall_strip_h) / 2;
+  int     start_y =
+      wall_top < 0 ? 0 : (int)((wall_top + FIXED_ONE - 1) >> FIXED_SHIFT);
+  int64_t end_y = (wall_top + wall_strip_h + FIXED_ONE - 1) >> FIXED_SHIFT;
+  end_y         = end_y > h ? h : end_y;
+  if (end_y <= start_y) {
+    return;
+  }
+
+  const Indexed_Texture *texture = get_material_texture(
+      indexed_renderer, scene->world_objects_container, hit->material);
+  int texture_x = ((int64_t)hit->wall_u * texture->w) >> FIXED_SHIFT;
+  texture_x     = texture_x >= texture->w ? texture->w - 1 : texture_x;
+
+  Fixed step = (Fixed)((int64_t)texture->h * perp_distance / h);
+  Fixed texture_pos =
+      (Fixed)(((((int64_t)start_y << FIXED_SHIFT) - wall_top) * step) >>
+              FIXED_SHIFT);
+
+  texture->draw_wall_column(
+      &indexed_renderer->framebuffer[start_y * w + x], w, end_y - start_y,
+      &texture->columns[texture_x * texture->h], texture->h, texture_pos, step,
+      get_fixed_colormap(indexed_renderer, view, perp_distance, hit->light));
+}
+
+static const uint8_t *get_fixed_colormap(const Indexed_Renderer *indexed_renderer,
+                                         const Fixed_View *view,
+                                         Fixed distance, uint8_t light) {
+  int level = 0;
+  if (distance >= view->fog_max) {
+    level = COLORMAP_LEVELS - 1;
+  } else if (distance > view->fog_start) {
+    level = (int)((int64_t)(distance - view->fog_start) *
+                  (COLORMAP_LEVELS - 1) / (view->fog_max - view->fog_start));
+  }
+  level += (LIGHT_LEVEL_MAX - light) * COLORMAP_LEVELS_PER_LIGHT_LEVEL;
+  level  = level >= COLORMAP_LEVELS ? COLORMAP_LEVELS - 1 : level;
+  return &indexed_renderer->colormaps[level * PALETTE_SIZE];
+}
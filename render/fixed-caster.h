@@ -0,0 +1,22 @@
+#ifndef FIXED_CASTER_H
+#define FIXED_CASTER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "../data/grid/constants.h"
+#include "../data/grid/lightmap.h"
+#include "../objects/player/constants.h"
+#include "../utils/fixed-point.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern bool create_fixed_caster_tables(Fixed_Caster_Tables *tables, int w, int h);
+extern void render_fixed_columns(Indexed_Renderer *indexed_renderer, const Render_Scene *scene, Camera camera);
+extern Fixed_View create_fixed_view(const Render_Scene *scene, Camera camera);
+extern int trace_fixed_ray(const Render_Scene *scene, const Fixed_View *view, Fixed x_dir, Fixed y_dir, int64_t max_ray_distance, Fixed_Ray_Hit *hits, bool *out_is_wall_hit);
+extern void draw_fixed_floor(Indexed_Renderer *indexed_renderer, const Render_Scene *scene, const Fixed_View *view, int x, Fixed floor_x_dir, Fixed floor_y_dir, int start_y);
+extern void free_fixed_caster_tables(Fixed_Caster_Tables *tables);
+
+#endif
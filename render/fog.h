@@ -0,0 +1,39 @@
+#ifndef FOG_H
+#define FOG_H
+
+#include <math.h>
+
+#include "../data/grid/constants.h"
+#include "../types/algebraic-types.h"
+#include "./constants.h"
+#include "./types.h"
+
+static inline Fog create_fog(Scalar view_distance) {
+  view_distance = view_distance < VIEW_DISTANCE_MIN   ? VIEW_DISTANCE_MIN
+                  : view_distance > VIEW_DISTANCE_MAX ? VIEW_DISTANCE_MAX
+                                                      : view_distance;
+  return (Fog){
+      .start_distance = view_distance * FOG_START_FRACTION,
+      .max_distance   = view_distance,
+  };
+}
+
+// 0 before the fog starts, 1 at and past the view distance
+static inline float get_fog_amount(const Fog *fog, Scalar distance) {
+  if (distance <= fog->start_distance) {
+    return 0.0f;
+  }
+  if (distance >= fog->max_distance) {
+    return 1.0f;
+  }
+  return (distance - fog->start_distance) /
+         (fog->max_distance - fog->start_distance);
+}
+
+// First screen row (from the top) whose floor is nearer than the view distance
+static inline int get_fog_floor_start_y(const Fog *fog, int screen_h) {
+  return (int)ceilf(screen_h / 2.0f +
+                    (screen_h / 2.0f) * GRID_CELL_SIZE / fog->max_distance);
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "./g-buffer.h"
+
+static const char *const RENDER_STAGE_NAMES[RENDER_STAGE_COUNT] = {
+    [RENDER_STAGE_TRAVERSAL] = "traversal",
+    [RENDER_STAGE_FLOORS]    = "floors",
+    [RENDER_STAGE_WALLS]     = "walls",
+    [RENDER_STAGE_FOG]       = "fog",
+    [RENDER_STAGE_SPRITES]   = "sprites",
+};
+
+extern Column_G_Buffer *create_column_g_buffer(size_t length) {
+  Column_G_Buffer *g_buffer = calloc(1, sizeof(Column_G_Buffer));
+  if (!g_buffer) {
+    return NULL;
+  }
+  g_buffer->length         = length;
+  g_buffer->ray_dirs_x     = malloc(length * sizeof(Vector_1D));
+  g_buffer->ray_dirs_y     = malloc(length * sizeof(Vector_1D));
+  g_buffer->inv_cos_thetas = malloc(length * sizeof(Scalar));
+  g_buffer->perp_distances = malloc(length * sizeof(Scalar));
+  g_buffer->floor_start_ys = malloc(length * sizeof(Point_1D));
+  g_buffer->hit_counts     = malloc(length * sizeof(uint8_t));
+  g_buffer->hits = malloc(length * MAX_RAY_HITS * sizeof(Column_Hit));
+  if (!g_buffer->ray_dirs_x || !g_buffer->ray_dirs_y ||
+      !g_buffer->inv_cos_thetas || !g_buffer->perp_distances ||
+      !g_buffer->floor_start_ys || !g_buffer->hit_counts || !g_buffer->hits) {
+    free_column_g_buffer(g_buffer);
+    return NULL;
+  }
+  reset_column_g_buffer(g_buffer);
+  return g_buffer;
+}
+
+// Every column empty, as if each ray escaped the map
+extern void reset_column_g_buffer(Column_G_Buffer *g_buffer) {
+  for (size_t i = 0; i < g_buffer->length; i++) {
+    g_buffer->perp_distances[i] = INFINITY;
+    g_buffer->hit_counts[i]     = 0;
+  }
+}
+
+extern const char *get_render_stage_name(Render_Stage stage) {
+  return RENDER_STAGE_NAMES[stage];
+}
+
+// Average milliseconds per frame of each stage
+extern void print_render_stage_timings(const Render_Stage_Timings *timings) {
+  if (timings->frame_count == 0) {
+    return;
+  }
+  printf("Stage ms/frame:");
+  for (int i = 0; i < RENDER_STAGE_COUNT; i++) {
+    printf(" %s %.3f", RENDER_STAGE_NAMES[i],
+           timings->seconds[i] * 1000.0 / timings->frame_count);
+  }
+  printf("\n");
+}
+
+extern void free_column_g_buffer(Column_G_Buffer *g_buffer) {
+  if (!g_buffer) {
+    return;
+  }
+  free(g_buffer->ray_dirs_x);
+  free(g_buffer->ray_dirs_y);
+  free(g_buffer->inv_cos_thetas);
+  free(g_buffer->perp_distances);
+  free(g_buffer->floor_start_ys);
+  free(g_buffer->hit_counts);
+  free(g_buffer->hits);
+  free(g_buffer);
+}
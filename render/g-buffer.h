@@ -0,0 +1,34 @@
+#ifndef G_BUFFER_H
+#define G_BUFFER_H
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL_timer.h>
+
+#include "../data/grid/constants.h"
+#include "./types.h"
+
+extern Column_G_Buffer *create_column_g_buffer(size_t length);
+extern void reset_column_g_buffer(Column_G_Buffer *g_buffer);
+extern const char *get_render_stage_name(Render_Stage stage);
+extern void print_render_stage_timings(const Render_Stage_Timings *timings);
+extern void free_column_g_buffer(Column_G_Buffer *g_buffer);
+
+static inline Column_Hit *get_column_hits(const Column_G_Buffer *g_buffer,
+                                          size_t                 column) {
+  return &g_buffer->hits[column * MAX_RAY_HITS];
+}
+
+// Adds the time since start, from SDL_GetPerformanceCounter, to a stage
+static inline void add_render_stage_time(Render_Stage_Timings *timings,
+                                         Render_Stage stage, Uint64 start) {
+  if (!timings) {
+    return;
+  }
+  timings->seconds[stage] += (double)(SDL_GetPerformanceCounter() - start) /
+                             SDL_GetPerformanceFrequency();
+}
+
+#endif
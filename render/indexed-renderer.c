@@ -0,0 +1,403 @@
+#include "./indexed-renderer.h"
+
+static const uint8_t *get_colormap(const Indexed_Renderer *indexed_renderer,
+                                   const Fog *fog, Scalar distance,
+                                   uint8_t light);
+static void render_indexed_column(Indexed_Renderer   *indexed_renderer,
+                                  const Render_Scene *scene, Camera camera,
+                                  int x);
+static void draw_indexed_wall(Indexed_Renderer   *indexed_renderer,
+                              const Render_Scene *scene, int x,
+                              const Indexed_Ray_Hit *hit, Scalar cos_theta);
+static void draw_indexed_sprites(Indexed_Renderer   *indexed_renderer,
+                                 const Render_Scene *scene, Camera camera);
+
+/*
+ * Builds the shared palette and colormaps and quantizes every frame of every
+ * material once. Frames stay in memory, callers expand them to RGBA into their
+ * own pixels with expand_indexed_frame.
+ */
+extern Indexed_Renderer *
+create_indexed_renderer(const World_Objects_Container *world_objects_container,
+                        int w, int h) {
+  Indexed_Renderer *indexed_renderer = calloc(1, sizeof(Indexed_Renderer));
+  if (!indexed_renderer) {
+    return NULL;
+  }
+
+  indexed_renderer->w           = w;
+  indexed_renderer->h           = h;
+  indexed_renderer->framebuffer = malloc((size_t)w * h);
+  indexed_renderer->z_buffer    = malloc(w * sizeof(Scalar));
+  indexed_renderer->palette     = create_shared_palette(world_objects_container);
+  if (!indexed_renderer->framebuffer || !indexed_renderer->z_buffer ||
+      !indexed_renderer->palette) {
+    free_indexed_renderer(indexed_renderer);
+    return NULL;
+  }
+
+  SDL_Color fog_color = {FOG_COLOR_R, FOG_COLOR_G, FOG_COLOR_B, 255};
+  indexed_renderer->colormaps =
+      create_colormaps(indexed_renderer->palette, fog_color);
+  indexed_renderer->background_index = find_palette_index(
+      indexed_renderer->palette, FOG_COLOR_R, FOG_COLOR_G, FOG_COLOR_B);
+
+  size_t frame_count = 0;
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    frame_count += world_objects_container->data[i]->surfaces.length;
+  }
+  indexed_renderer->material_count = world_objects_container->length;
+  indexed_renderer->frame_offsets =
+      malloc(indexed_renderer->material_count * sizeof(size_t));
+  indexed_renderer->textures = calloc(frame_count, sizeof(Indexed_Texture));
+  indexed_renderer->texture_count = frame_count;
+  if (!indexed_renderer->colormaps || !indexed_renderer->frame_offsets ||
+      !indexed_renderer->textures) {
+    free_indexed_renderer(indexed_renderer);
+    return NULL;
+  }
+
+  size_t frame_offset = 0;
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    const Surface_Src_Container *surfaces =
+        &world_objects_container->data[i]->surfaces;
+    indexed_renderer->frame_offsets[i] = frame_offset;
+    for (size_t j = 0; j < surfaces->length; j++) {
+      Indexed_Texture *texture = &indexed_renderer->textures[frame_offset + j];
+      if (!quantize_surface(indexed_renderer->palette, surfaces->data[j],
+                            texture)) {
+        free_indexed_renderer(indexed_renderer);
+        return NULL;
+      }
+      assign_texture_kernels(texture);
+    }
+    frame_offset += surfaces->length;
+  }
+
+  init_fixed_trig_lut();
+  if (!create_fixed_caster_tables(&indexed_renderer->fixed_tables, w, h)) {
+    free_indexed_renderer(indexed_renderer);
+    return NULL;
+  }
+
+  return indexed_renderer;
+}
+
+extern void render_indexed_frame(Indexed_Renderer   *indexed_renderer,
+                                 const Render_Scene *scene, Camera camera) {
+  memset(indexed_renderer->framebuffer, indexed_renderer->background_index,
+         (size_t)indexed_renderer->w * indexed_renderer->h);
+
+  if (indexed_renderer->use_fixed_point) {
+    render_fixed_columns(indexed_renderer, scene, camera);
+  } else {
+    for (int x = 0; x < indexed_renderer->w; x++) {
+      render_indexed_column(indexed_renderer, scene, camera, x);
+    }
+  }
+
+  draw_indexed_sprites(indexed_renderer, scene, camera);
+}
+
+/*
+ * The only place palette indexes are expanded to RGBA, w by h pixels in
+ * SDL_PIXELFORMAT_RGBA32 byte order with rows pitch bytes apart
+ */
+extern void expand_indexed_frame(const Indexed_Renderer *indexed_renderer,
+                                 void *pixels, int pitch) {
+  Uint32 palette_rgba[PALETTE_SIZE];
+  for (int i = 0; i < PALETTE_SIZE; i++) {
+    SDL_Color color = indexed_renderer->palette->colors[i];
+    color.a         = 255;
+    memcpy(&palette_rgba[i], &color, sizeof(Uint32));
+  }
+
+  for (int y = 0; y < indexed_renderer->h; y++) {
+    Uint32        *dst_row = (Uint32 *)((Uint8 *)pixels + y * pitch);
+    const uint8_t *src_row =
+        &indexed_renderer->framebuffer[y * indexed_renderer->w];
+    for (int x = 0; x < indexed_renderer->w; x++) {
+      dst_row[x] = palette_rgba[src_row[x]];
+    }
+  }
+}
+
+extern void free_indexed_renderer(Indexed_Renderer *indexed_renderer) {
+  if (!indexed_renderer) {
+    return;
+  }
+
+  for (size_t i = 0; indexed_renderer->textures &&
+                     i < indexed_renderer->texture_count;
+       i++) {
+    free(indexed_renderer->textures[i].texels);
+    free(indexed_renderer->textures[i].columns);
+  }
+  free_fixed_caster_tables(&indexed_renderer->fixed_tables);
+  free(indexed_renderer->textures);
+  free(indexed_renderer->frame_offsets);
+  free(indexed_renderer->colormaps);
+  free(indexed_renderer->palette);
+  free(indexed_renderer->z_buffer);
+  free(indexed_renderer->framebuffer);
+  free(indexed_renderer);
+}
+
+/*
+ * Walks one ray from eye (world units) through the grid, collecting wall hits
+ * near to far until an opaque wall, a full stack or max_ray_distance (cells,
+ * along the ray). Returns the hit count, out_is_wall_hit says whether the
+ * last hit stopped the ray.
+ */
+extern int trace_indexed_ray(const Render_Scene *scene, Point_2D eye,
+                             Vector_1D x_dir, Vector_1D y_dir,
+                             Scalar max_ray_distance, Indexed_Ray_Hit *hits,
+                             bool *out_is_wall_hit) {
+  const Tile_Map *tile_map = scene->tile_map;
+
+  Point_1D   norm_x  = eye.x / GRID_CELL_SIZE;
+  Point_1D   norm_y  = eye.y / GRID_CELL_SIZE;
+  IPoint_1D  grid_x  = floorf(norm_x);
+  IPoint_1D  grid_y  = floorf(norm_y);
+  IVector_1D step_x  = (x_dir >= 0) ? 1 : -1;
+  IVector_1D step_y  = (y_dir >= 0) ? 1 : -1;
+  Vector_1D  delta_x = fabsf(1.0f / x_dir);
+  Vector_1D  delta_y = fabsf(1.0f / y_dir);
+  Vector_1D  side_x  = (x_dir < 0) ? (norm_x - grid_x) * delta_x
+                                   : (grid_x + 1 - norm_x) * delta_x;
+  Vector_1D  side_y  = (y_dir < 0) ? (norm_y - grid_y) * delta_y
+                                   : (grid_y + 1 - norm_y) * delta_y;
+
+  int  hit_count   = 0;
+  bool is_wall_hit = false;
+  while (!is_wall_hit) {
+    if (fminf(side_x, side_y) > max_ray_distance) {
+      break;
+    }
+
+    Scalar distance;
+    bool   is_vertical;
+    if (side_x < side_y) {
+      distance    = side_x;
+      side_x     += delta_x;
+      grid_x     += step_x;
+      is_vertical = true;
+    } else {
+      distance    = side_y;
+      side_y     += delta_y;
+      grid_y     += step_y;
+      is_vertical = false;
+    }
+
+    if (grid_x < 0 || grid_y < 0 || (size_t)grid_x >= tile_map->width ||
+        (size_t)grid_y >= tile_map->height) {
+      break;
+    }
+
+    Material_Id wall_id =
+        tile_map->wall_ids[(size_t)grid_y * tile_map->width + grid_x];
+    if (wall_id == MATERIAL_ID_EMPTY) {
+      continue;
+    }
+
+    Scalar wall_u = is_vertical ? norm_y + distance * y_dir
+                                : norm_x + distance * x_dir;
+    uint8_t light = is_vertical
+                        ? sample_lightmap(scene->lightmap, grid_x - step_x, grid_y)
+                        : sample_lightmap(scene->lightmap, grid_x, grid_y - step_y);
+    hits[hit_count++] = (Indexed_Ray_Hit){
+        .material = wall_id,
+        .distance = distance,
+        .wall_u   = wall_u - floorf(wall_u),
+        .light    = light,
+    };
+    if ((tile_map->material_flags[wall_id] & MATERIAL_FLAG_OPAQUE) ||
+        hit_count == MAX_RAY_HITS) {
+      is_wall_hit = true;
+    }
+  }
+
+  *out_is_wall_hit = is_wall_hit;
+  return hit_count;
+}
+
+// Fog and missing light both push towards the fog coloured colormaps
+static const uint8_t *get_colormap(const Indexed_Renderer *indexed_renderer,
+                                   const Fog *fog, Scalar distance,
+                                   uint8_t light) {
+  int level = (int)(get_fog_amount(fog, distance) * (COLORMAP_LEVELS - 1)) +
+              (LIGHT_LEVEL_MAX - light) * COLORMAP_LEVELS_PER_LIGHT_LEVEL;
+  level     = level < 0                     ? 0
+              : level >= COLORMAP_LEVELS ? COLORMAP_LEVELS - 1
+                                            : level;
+  return &indexed_renderer->colormaps[level * PALETTE_SIZE];
+}
+
+static void render_indexed_column(Indexed_Renderer   *indexed_renderer,
+                                  const Render_Scene *scene, Camera camera,
+                                  int x) {
+  float angle_offset =
+      ((float)x / indexed_renderer->w - 0.5f) * PLAYER_FOV_DEG;
+  Radians   ray_rads  = convert_deg_to_rads(camera.angle + angle_offset);
+  Vector_1D x_dir     = cosf(ray_rads);
+  Vector_1D y_dir     = sinf(ray_rads);
+  Scalar    cos_theta = cosf(convert_deg_to_rads(angle_offset));
+
+  // Along-ray distance (in cells) at which the ray reaches the view distance
+  Scalar max_ray_distance =
+      scene->fog.max_distance / (GRID_CELL_SIZE * cos_theta);
+
+  Indexed_Ray_Hit hits[MAX_RAY_HITS];
+  bool            is_wall_hit;
+  int hit_count = trace_indexed_ray(scene, camera.position, x_dir, y_dir,
+                                    max_ray_distance, hits, &is_wall_hit);
+
+  int    h             = indexed_renderer->h;
+  Scalar perp_distance = INFINITY;
+  int    floor_start_y = h / 2 + 1;
+  if (is_wall_hit) {
+    perp_distance = hits[hit_count - 1].distance * GRID_CELL_SIZE * cos_theta;
+    Scalar wall_strip_h = (GRID_CELL_SIZE * h) / perp_distance;
+    int    wall_bottom  = (int)((h + wall_strip_h) / 2);
+    floor_start_y = wall_bottom > floor_start_y ? wall_bottom : floor_start_y;
+  }
+  indexed_renderer->z_buffer[x] = perp_distance;
+
+  draw_indexed_floor(indexed_renderer, scene, camera, x, x_dir / cos_theta,
+                     y_dir / cos_theta, floor_start_y);
+
+  for (int i = hit_count - 1; i >= 0; i--) {
+    draw_indexed_wall(indexed_renderer, scene, x, &hits[i], cos_theta);
+  }
+}
+
+// One column of floor from start_y down, floor_*_dir being the ray over cos
+extern void draw_indexed_floor(Indexed_Renderer   *indexed_renderer,
+                               const Render_Scene *scene, Camera camera, int x,
+                               Vector_1D floor_x_dir, Vector_1D floor_y_dir,
+                               int start_y) {
+  const Tile_Map *tile_map = scene->tile_map;
+  int             w        = indexed_renderer->w;
+  int             h        = indexed_renderer->h;
+
+  // Rows above this are past the view distance and stay fog coloured
+  int fog_start_y = get_fog_floor_start_y(&scene->fog, h);
+  start_y         = start_y > fog_start_y ? start_y : fog_start_y;
+
+  for (int y = start_y; y < h; y++) {
+    Scalar   distance = ((h / 2.0f) / (y - h / 2.0f)) * GRID_CELL_SIZE;
+    Point_1D world_x  = camera.position.x + floor_x_dir * distance;
+    Point_1D world_y  = camera.position.y + floor_y_dir * distance;
+    if (world_x < 0 || world_y < 0) {
+      continue;
+    }
+
+    size_t grid_x = (size_t)(world_x / GRID_CELL_SIZE);
+    size_t grid_y = (size_t)(world_y / GRID_CELL_SIZE);
+    if (grid_x >= tile_map->width || grid_y >= tile_map->height) {
+      continue;
+    }
+
+    Material_Id floor_id = tile_map->floor_ids[grid_y * tile_map->width + grid_x];
+    if (floor_id == MATERIAL_ID_EMPTY) {
+      continue;
+    }
+
+    const Indexed_Texture *texture = get_material_texture(
+        indexed_renderer, scene->world_objects_container, floor_id);
+    uint8_t texel = sample_floor_texel(texture, world_x, world_y);
+
+    uint8_t light = sample_lightmap(scene->lightmap, grid_x, grid_y);
+    indexed_renderer->framebuffer[y * w + x] =
+        get_colormap(indexed_renderer, &scene->fog, distance, light)[texel];
+  }
+}
+
+static void draw_indexed_wall(Indexed_Renderer   *indexed_renderer,
+                              const Render_Scene *scene, int x,
+                              const Indexed_Ray_Hit *hit, Scalar cos_theta) {
+  int    w             = indexed_renderer->w;
+  int    h             = indexed_renderer->h;
+  Scalar perp_distance = hit->distance * GRID_CELL_SIZE * cos_theta;
+  Scalar wall_strip_h  = (GRID_CELL_SIZE * h) / perp_distance;
+  Scalar wall_top      = (h - wall_strip_h) / 2;
+
+  const Indexed_Texture *texture = get_material_texture(
+      indexed_renderer, scene->world_objects_container, hit->material);
+  int texture_x = (int)(hit->wall_u * texture->w);
+  texture_x     = texture_x >= texture->w ? texture->w - 1 : texture_x;
+
+  int start_y = wall_top < 0 ? 0 : (int)ceilf(wall_top);
+  int end_y   = (int)ceilf(wall_top + wall_strip_h);
+  end_y       = end_y > h ? h : end_y;
+
+  const uint8_t *colormap =
+      get_colormap(indexed_renderer, &scene->fog, perp_distance, hit->light);
+  Scalar step        = texture->h / wall_strip_h;
+  Scalar texture_pos = (start_y - wall_top) * step;
+  if (end_y > start_y) {
+    texture->draw_wall_column(
+        &indexed_renderer->framebuffer[start_y * w + x], w, end_y - start_y,
+        &texture->columns[texture_x * texture->h], texture->h,
+        (Fixed)(texture_pos * FIXED_ONE), (Fixed)(step * FIXED_ONE), colormap);
+  }
+}
+
+static void draw_indexed_sprites(Indexed_Renderer   *indexed_renderer,
+                                 const Render_Scene *scene, Camera camera) {
+  if (!scene->sprite_draw_list || !scene->sprite_entities) {
+    return;
+  }
+
+  int    w      = indexed_renderer->w;
+  int    h      = indexed_renderer->h;
+  size_t length = build_sprite_draw_list(
+      scene->sprite_draw_list, scene->sprite_entities, scene->spatial_hash,
+      scene->pvs, scene->fog.max_distance, camera.position, camera.angle);
+
+  for (size_t i = length; i-- > 0;) {
+    const Sprite_Projection *projection = &scene->sprite_draw_list->data[i];
+    if (projection->perp_distance >= scene->fog.max_distance) {
+      continue;
+    }
+    const Sprite_Entity *entity =
+        &scene->sprite_entities->data[projection->entity_index];
+    const Indexed_Texture *texture = get_material_texture(
+        indexed_renderer, scene->world_objects_container, entity->material);
+
+    Scalar   wall_strip_h = (GRID_CELL_SIZE * h) / projection->perp_distance;
+    Scalar   sprite_h     = wall_strip_h * entity->scale;
+    Scalar   sprite_w     = sprite_h * texture->w / texture->h;
+    Point_1D sprite_top   = (h + wall_strip_h) / 2 - sprite_h;
+    Point_1D sprite_left  = projection->view_x * w - sprite_w / 2;
+
+    int start_x = sprite_left < 0 ? 0 : (int)ceilf(sprite_left);
+    int end_x   = (int)ceilf(sprite_left + sprite_w);
+    end_x       = end_x > w ? w : end_x;
+    int start_y = sprite_top < 0 ? 0 : (int)ceilf(sprite_top);
+    int end_y   = (int)ceilf(sprite_top + sprite_h);
+    end_y       = end_y > h ? h : end_y;
+
+    uint8_t light = sample_lightmap(
+        scene->lightmap, floorf(entity->position.x / GRID_CELL_SIZE),
+        floorf(entity->position.y / GRID_CELL_SIZE));
+    const uint8_t *colormap =
+        get_colormap(indexed_renderer, &scene->fog,
+                     projection->perp_distance, light);
+    for (int x = start_x; x < end_x; x++) {
+      if (projection->perp_distance >= indexed_renderer->z_buffer[x]) {
+        continue;
+      }
+      int texture_x = (int)((x - sprite_left) / sprite_w * texture->w);
+      texture_x     = texture_x >= texture->w ? texture->w - 1 : texture_x;
+      for (int y = start_y; y < end_y; y++) {
+        int texture_y = (int)((y - sprite_top) / sprite_h * texture->h);
+        texture_y     = texture_y >= texture->h ? texture->h - 1 : texture_y;
+        uint8_t texel = texture->texels[texture_y * texture->w + texture_x];
+        if (texel != PALETTE_TRANSPARENT_INDEX) {
+          indexed_renderer->framebuffer[y * w + x] = colormap[texel];
+        }
+      }
+    }
+  }
+}
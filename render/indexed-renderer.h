@@ -0,0 +1,42 @@
+#ifndef INDEXED_RENDERER_H
+#define INDEXED_RENDERER_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL_render.h>
+
+#include "../assets/sprites/setup.h"
+#include "../assets/textures/constants.h"
+#include "../config/constants.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/lightmap.h"
+#include "../objects/player/constants.h"
+#include "./constants.h"
+#include "./fixed-caster.h"
+#include "./fog.h"
+#include "./kernels.h"
+#include "./palette.h"
+#include "./types.h"
+
+extern Indexed_Renderer *create_indexed_renderer(const World_Objects_Container *world_objects_container, int w, int h);
+extern void render_indexed_frame(Indexed_Renderer *indexed_renderer, const Render_Scene *scene, Camera camera);
+extern int trace_indexed_ray(const Render_Scene *scene, Point_2D eye, Vector_1D x_dir, Vector_1D y_dir, Scalar max_ray_distance, Indexed_Ray_Hit *hits, bool *out_is_wall_hit);
+extern void draw_indexed_floor(Indexed_Renderer *indexed_renderer, const Render_Scene *scene, Camera camera, int x, Vector_1D floor_x_dir, Vector_1D floor_y_dir, int start_y);
+extern void expand_indexed_frame(const Indexed_Renderer *indexed_renderer, void *pixels, int pitch);
+extern void free_indexed_renderer(Indexed_Renderer *indexed_renderer);
+
+// Current animation frame of a material
+static inline const Indexed_Texture *
+get_material_texture(const Indexed_Renderer        *indexed_renderer,
+                     const World_Objects_Container *world_objects_container,
+                     Material_Id                    material) {
+  const World_Object *world_object = world_objects_container->data[material];
+  return &indexed_renderer->textures[indexed_renderer->frame_offsets[material] +
+                                     world_object->animation_state
+                                         .current_frame_index];
+}
+
+#endif
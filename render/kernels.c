@@ -0,0 +1,68 @@
+#include "./kernels.h"
+
+/*
+ * One wall column kernel per kernel size and texel format. Opaque textures
+ * skip the colour key test, keyed ones leave transparent texels untouched.
+ */
+#define DEFINE_WALL_COLUMN_KERNEL(size, format, is_keyed)                      \
+  static void draw_wall_column_##size##_##format(                              \
+      uint8_t *dst, int dst_pitch, int length, const uint8_t *column,          \
+      int texture_h, Fixed texture_pos, Fixed step,                            \
+      const uint8_t *colormap) {                                               \
+    (void)texture_h;                                                           \
+    for (int i = 0; i < length; i++, texture_pos += step, dst += dst_pitch) {  \
+      uint8_t texel = column[(texture_pos >> FIXED_SHIFT) & ((size) - 1)];     \
+      if (!(is_keyed) || texel != PALETTE_TRANSPARENT_INDEX) {                 \
+        *dst = colormap[texel];                                                \
+      }                                                                        \
+    }                                                                          \
+  }
+
+#define DEFINE_WALL_COLUMN_KERNELS(size)                                       \
+  DEFINE_WALL_COLUMN_KERNEL(size, opaque, false)                               \
+  DEFINE_WALL_COLUMN_KERNEL(size, keyed, true)
+
+TEXTURE_KERNEL_SIZES(DEFINE_WALL_COLUMN_KERNELS)
+
+static void draw_wall_column_generic(uint8_t *dst, int dst_pitch, int length,
+                                     const uint8_t *column, int texture_h,
+                                     Fixed texture_pos, Fixed step,
+                                     const uint8_t *colormap) {
+  for (int i = 0; i < length; i++, texture_pos += step, dst += dst_pitch) {
+    int texture_y = texture_pos >> FIXED_SHIFT;
+    texture_y     = texture_y >= texture_h ? texture_h - 1 : texture_y;
+    uint8_t texel = column[texture_y];
+    if (texel != PALETTE_TRANSPARENT_INDEX) {
+      *dst = colormap[texel];
+    }
+  }
+}
+
+#define WALL_COLUMN_KERNEL_ENTRY(size)                                         \
+  [TEXTURE_SIZE_CLASS_##size] = {draw_wall_column_##size##_opaque,             \
+                                 draw_wall_column_##size##_keyed},
+
+static const Wall_Column_Kernel wall_column_kernels[TEXTURE_SIZE_CLASS_COUNT][2] = {
+    TEXTURE_KERNEL_SIZES(WALL_COLUMN_KERNEL_ENTRY)
+    [TEXTURE_SIZE_CLASS_GENERIC] = {draw_wall_column_generic,
+                                    draw_wall_column_generic},
+};
+
+#define TEXTURE_SIZE_CLASS_MATCH(size)                                         \
+  if (texture->w == (size) && texture->h == (size)) {                          \
+    return TEXTURE_SIZE_CLASS_##size;                                          \
+  }
+
+static Texture_Size_Class get_texture_size_class(const Indexed_Texture *texture) {
+  TEXTURE_KERNEL_SIZES(TEXTURE_SIZE_CLASS_MATCH)
+  return TEXTURE_SIZE_CLASS_GENERIC;
+}
+
+// Call once the texels are quantized, picks the kernels the texture draws with
+extern void assign_texture_kernels(Indexed_Texture *texture) {
+  texture->is_keyed = memchr(texture->texels, PALETTE_TRANSPARENT_INDEX,
+                             (size_t)texture->w * texture->h) != NULL;
+  texture->size_class = get_texture_size_class(texture);
+  texture->draw_wall_column =
+      wall_column_kernels[texture->size_class][texture->is_keyed];
+}
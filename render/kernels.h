@@ -0,0 +1,63 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../data/grid/constants.h"
+#include "../types/algebraic-types.h"
+#include "../utils/fixed-point.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern void assign_texture_kernels(Indexed_Texture *texture);
+
+/*
+ * Floor texel under a world position, with the texture tiled once per grid
+ * cell. Each kernel size compiles to constant multiplies, shifts and masks.
+ */
+#define SAMPLE_FLOOR_TEXEL_CASE(size)                                          \
+  case TEXTURE_SIZE_CLASS_##size:                                              \
+    return texture->texels[((int)(world_y * ((size) / GRID_CELL_SIZE)) &       \
+                            ((size) - 1)) * (size) +                           \
+                           ((int)(world_x * ((size) / GRID_CELL_SIZE)) &       \
+                            ((size) - 1))];
+
+static inline uint8_t sample_floor_texel(const Indexed_Texture *texture,
+                                         Point_1D world_x, Point_1D world_y) {
+  switch (texture->size_class) {
+    TEXTURE_KERNEL_SIZES(SAMPLE_FLOOR_TEXEL_CASE)
+  default:
+    return texture->texels[(int)(world_y * texture->h / GRID_CELL_SIZE) %
+                               texture->h * texture->w +
+                           (int)(world_x * texture->w / GRID_CELL_SIZE) %
+                               texture->w];
+  }
+}
+
+#undef SAMPLE_FLOOR_TEXEL_CASE
+
+// As sample_floor_texel, with the world position in 16.16 cells
+#define SAMPLE_FLOOR_TEXEL_FIXED_CASE(size)                                    \
+  case TEXTURE_SIZE_CLASS_##size:                                              \
+    return texture->texels[(((int64_t)world_y * (size) >> FIXED_SHIFT) &       \
+                            ((size) - 1)) * (size) +                           \
+                           (((int64_t)world_x * (size) >> FIXED_SHIFT) &       \
+                            ((size) - 1))];
+
+static inline uint8_t sample_floor_texel_fixed(const Indexed_Texture *texture,
+                                               Fixed world_x, Fixed world_y) {
+  switch (texture->size_class) {
+    TEXTURE_KERNEL_SIZES(SAMPLE_FLOOR_TEXEL_FIXED_CASE)
+  default:
+    return texture->texels[((int64_t)world_y * texture->h >> FIXED_SHIFT) %
+                               texture->h * texture->w +
+                           ((int64_t)world_x * texture->w >> FIXED_SHIFT) %
+                               texture->w];
+  }
+}
+
+#undef SAMPLE_FLOOR_TEXEL_FIXED_CASE
+
+#endif
@@ -0,0 +1,259 @@
+#include "./minimap.h"
+
+typedef enum Minimap_Cell_Kind {
+  MINIMAP_CELL_OPEN,
+  MINIMAP_CELL_TRANSLUCENT,
+  MINIMAP_CELL_SOLID,
+  MINIMAP_CELL_KIND_COUNT,
+} Minimap_Cell_Kind;
+
+static const SDL_Color MINIMAP_CELL_COLORS[MINIMAP_CELL_KIND_COUNT] = {
+    [MINIMAP_CELL_OPEN]        = {255, 255, 255, 255},
+    [MINIMAP_CELL_TRANSLUCENT] = {150, 150, 150, 255},
+    [MINIMAP_CELL_SOLID]       = {0, 0, 0, 255},
+};
+
+static const SDL_Color  MINIMAP_GAP_COLOR    = {60, 60, 60, 255};
+static const SDL_FColor MINIMAP_MARKER_COLOR = {100 / 255.0f, 0, 1.0f, 1.0f};
+
+static Minimap_Cell_Kind get_minimap_cell_kind(const Tile_Map *tile_map,
+                                               size_t            cell);
+static void fill_minimap_cells(SDL_Renderer *renderer, Minimap *minimap,
+                               Minimap_Cell_Kind kind);
+
+/*
+ * Every cell starts dirty, so the first update_minimap draws the whole map and
+ * later ones only what changed.
+ */
+extern Minimap *create_minimap(SDL_Renderer *renderer, const Tile_Map *tile_map) {
+  size_t cell_count = tile_map->width * tile_map->height;
+  if (cell_count == 0) {
+    return NULL;
+  }
+  size_t longest_side = tile_map->width > tile_map->height ? tile_map->width
+                                                            : tile_map->height;
+  int    cell_px      = MINIMAP_CELL_PX;
+  while (cell_px > 1 && (longest_side + 1) * cell_px > MINIMAP_MAX_TEXTURE_PX) {
+    cell_px--;
+  }
+  if ((longest_side + 1) * cell_px > MINIMAP_MAX_TEXTURE_PX) {
+    fprintf(stderr, "Map too large for the minimap: %zux%zu\n",
+            tile_map->width, tile_map->height);
+    return NULL;
+  }
+
+  Minimap *minimap = calloc(1, sizeof(Minimap));
+  if (!minimap) {
+    return NULL;
+  }
+  minimap->tile_map    = tile_map;
+  minimap->cell_px     = cell_px;
+  minimap->zoom        = MINIMAP_ZOOM_DEFAULT;
+  minimap->is_visible  = true;
+  minimap->dirty_cells = malloc(cell_count * sizeof(size_t));
+  minimap->rects       = malloc(cell_count * sizeof(SDL_FRect));
+  minimap->is_dirty    = calloc(cell_count, sizeof(uint8_t));
+  // One extra row of cells holds the white texel the marker samples
+  minimap->texture = SDL_CreateTexture(
+      renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+      (int)tile_map->width * cell_px, (int)(tile_map->height + 1) * cell_px);
+  if (!minimap->dirty_cells || !minimap->rects || !minimap->is_dirty ||
+      !minimap->texture) {
+    fprintf(stderr, "Failed to create minimap: %s\n", SDL_GetError());
+    free_minimap(minimap);
+    return NULL;
+  }
+  SDL_SetTextureScaleMode(minimap->texture, SDL_SCALEMODE_NEAREST);
+  SDL_SetTextureBlendMode(minimap->texture, SDL_BLENDMODE_NONE);
+  mark_minimap_dirty(minimap);
+  return minimap;
+}
+
+// Call whenever a wall cell changes: doors, edits, streamed chunks
+extern void mark_minimap_cell_dirty(Minimap *minimap, size_t x, size_t y) {
+  if (!minimap || x >= minimap->tile_map->width ||
+      y >= minimap->tile_map->height) {
+    return;
+  }
+  size_t cell = y * minimap->tile_map->width + x;
+  if (minimap->is_dirty[cell]) {
+    return;
+  }
+  minimap->is_dirty[cell]                       = 1;
+  minimap->dirty_cells[minimap->dirty_length++] = cell;
+}
+
+// Render targets are lost on SDL_EVENT_RENDER_TARGETS_RESET, redraw it all
+extern void mark_minimap_dirty(Minimap *minimap) {
+  if (!minimap) {
+    return;
+  }
+  for (size_t y = 0; y < minimap->tile_map->height; y++) {
+    for (size_t x = 0; x < minimap->tile_map->width; x++) {
+      mark_minimap_cell_dirty(minimap, x, y);
+    }
+  }
+}
+
+/*
+ * Redraws the queued cells into the texture, one fill call per cell colour. A
+ * no-op on frames where nothing changed.
+ */
+extern void update_minimap(SDL_Renderer *renderer, Minimap *minimap) {
+  if (!minimap || minimap->dirty_length == 0) {
+    return;
+  }
+  SDL_Texture *previous_target = SDL_GetRenderTarget(renderer);
+  SDL_SetRenderTarget(renderer, minimap->texture);
+
+  // A full redraw also clears the gaps between cells and the marker strip
+  size_t cell_count = minimap->tile_map->width * minimap->tile_map->height;
+  if (minimap->dirty_length == cell_count) {
+    SDL_Color gap = MINIMAP_GAP_COLOR;
+    SDL_SetRenderDrawColor(renderer, gap.r, gap.g, gap.b, gap.a);
+    SDL_RenderClear(renderer);
+    SDL_FRect marker_strip = {
+        .x = 0,
+        .y = (float)(minimap->tile_map->height * minimap->cell_px),
+        .w = (float)(minimap->tile_map->width * minimap->cell_px),
+        .h = (float)minimap->cell_px,
+    };
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
+    SDL_RenderFillRect(renderer, &marker_strip);
+  }
+  for (int kind = 0; kind < MINIMAP_CELL_KIND_COUNT; kind++) {
+    fill_minimap_cells(renderer, minimap, kind);
+  }
+
+  for (size_t i = 0; i < minimap->dirty_length; i++) {
+    minimap->is_dirty[minimap->dirty_cells[i]] = 0;
+  }
+  minimap->dirty_length = 0;
+  SDL_SetRenderTarget(renderer, previous_target);
+}
+
+extern void set_minimap_zoom(Minimap *minimap, float zoom) {
+  if (!minimap) {
+    return;
+  }
+  size_t longest_side = minimap->tile_map->width > minimap->tile_map->height
+                            ? minimap->tile_map->width
+                            : minimap->tile_map->height;
+  float  zoom_max     = fmaxf((float)longest_side, MINIMAP_ZOOM_MIN);
+  minimap->zoom       = fminf(fmaxf(zoom, MINIMAP_ZOOM_MIN), zoom_max);
+}
+
+/*
+ * Shows zoom cells across the view, scrolled to keep the player centred and
+ * clamped to the map edges. The map and the player marker are one geometry
+ * call: the marker samples the white strip under the map and is tinted by its
+ * vertex colour.
+ */
+extern void draw_minimap(SDL_Renderer *renderer, const Minimap *minimap,
+                         const SDL_FRect *view, Point_2D position,
+                         Degrees angle) {
+  if (!minimap || !minimap->is_visible) {
+    return;
+  }
+  float map_w        = (float)(minimap->tile_map->width * minimap->cell_px);
+  float map_h        = (float)(minimap->tile_map->height * minimap->cell_px);
+  float tex_h        = map_h + minimap->cell_px;
+  float px_per_world = minimap->cell_px / GRID_CELL_SIZE;
+  float scale        = view->w / (minimap->zoom * minimap->cell_px);
+
+  // Maps smaller than the view shrink the destination instead of stretching
+  float src_w = fminf(view->w / scale, map_w);
+  float src_h = fminf(view->h / scale, map_h);
+  float src_x = position.x * px_per_world - src_w / 2;
+  float src_y = position.y * px_per_world - src_h / 2;
+  src_x       = fminf(fmaxf(src_x, 0), map_w - src_w);
+  src_y       = fminf(fmaxf(src_y, 0), map_h - src_h);
+  float dst_w = src_w * scale;
+  float dst_h = src_h * scale;
+
+  SDL_FColor white = {1.0f, 1.0f, 1.0f, 1.0f};
+  SDL_Vertex vertices[7];
+  float      u0 = src_x / map_w;
+  float      u1 = (src_x + src_w) / map_w;
+  float      v0 = src_y / tex_h;
+  float      v1 = (src_y + src_h) / tex_h;
+  vertices[0] = (SDL_Vertex){{view->x, view->y}, white, {u0, v0}};
+  vertices[1] = (SDL_Vertex){{view->x + dst_w, view->y}, white, {u1, v0}};
+  vertices[2] = (SDL_Vertex){{view->x + dst_w, view->y + dst_h}, white, {u1, v1}};
+  vertices[3] = (SDL_Vertex){{view->x, view->y + dst_h}, white, {u0, v1}};
+
+  // Arrow pointing along the view angle
+  SDL_FPoint marker_uv = {0.5f, (map_h + minimap->cell_px / 2.0f) / tex_h};
+  float      marker_x  = view->x + (position.x * px_per_world - src_x) * scale;
+  float      marker_y  = view->y + (position.y * px_per_world - src_y) * scale;
+  Radians    radians   = convert_deg_to_rads(angle);
+  float      dir_x     = cosf(radians);
+  float      dir_y     = sinf(radians);
+  float      size      = MINIMAP_MARKER_SIZE;
+  vertices[4] = (SDL_Vertex){
+      {marker_x + dir_x * size, marker_y + dir_y * size},
+      MINIMAP_MARKER_COLOR, marker_uv};
+  vertices[5] = (SDL_Vertex){
+      {marker_x - dir_x * size / 2 - dir_y * size / 2,
+       marker_y - dir_y * size / 2 + dir_x * size / 2},
+      MINIMAP_MARKER_COLOR, marker_uv};
+  vertices[6] = (SDL_Vertex){
+      {marker_x - dir_x * size / 2 + dir_y * size / 2,
+       marker_y - dir_y * size / 2 - dir_x * size / 2},
+      MINIMAP_MARKER_COLOR, marker_uv};
+
+  static const int indices[9] = {0, 1, 2, 0, 2, 3, 4, 5, 6};
+  SDL_RenderGeometry(renderer, minimap->texture, vertices, 7, indices, 9);
+}
+
+extern void free_minimap(Minimap *minimap) {
+  if (!minimap) {
+    return;
+  }
+  if (minimap->texture) {
+    SDL_DestroyTexture(minimap->texture);
+  }
+  free(minimap->dirty_cells);
+  free(minimap->rects);
+  free(minimap->is_dirty);
+  free(minimap);
+}
+
+static Minimap_Cell_Kind get_minimap_cell_kind(const Tile_Map *tile_map,
+                                               size_t            cell) {
+  Material_Id wall_id = tile_map->wall_ids[cell];
+  if (wall_id == MATERIAL_ID_EMPTY) {
+    return MINIMAP_CELL_OPEN;
+  }
+  return (tile_map->material_flags[wall_id] & MATERIAL_FLAG_OPAQUE)
+             ? MINIMAP_CELL_SOLID
+             : MINIMAP_CELL_TRANSLUCENT;
+}
+
+static void fill_minimap_cells(SDL_Renderer *renderer, Minimap *minimap,
+                               Minimap_Cell_Kind kind) {
+  const Tile_Map *tile_map   = minimap->tile_map;
+  float           cell_px    = (float)minimap->cell_px;
+  float           gap        = minimap->cell_px > MINIMAP_CELL_GAP * 2
+                                   ? MINIMAP_CELL_GAP
+                                   : 0;
+  int             rect_count = 0;
+  for (size_t i = 0; i < minimap->dirty_length; i++) {
+    size_t cell = minimap->dirty_cells[i];
+    if (get_minimap_cell_kind(tile_map, cell) != kind) {
+      continue;
+    }
+    minimap->rects[rect_count++] = (SDL_FRect){
+        .x = (cell % tile_map->width) * cell_px + gap,
+        .y = (cell / tile_map->width) * cell_px + gap,
+        .w = cell_px - gap * 2,
+        .h = cell_px - gap * 2,
+    };
+  }
+  if (rect_count == 0) {
+    return;
+  }
+  SDL_Color color = MINIMAP_CELL_COLORS[kind];
+  SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+  SDL_RenderFillRects(renderer, minimap->rects, rect_count);
+}
@@ -0,0 +1,25 @@
+#ifndef MINIMAP_H
+#define MINIMAP_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_render.h>
+
+#include "../data/grid/constants.h"
+#include "../utils/math-utils.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Minimap *create_minimap(SDL_Renderer *renderer, const Tile_Map *tile_map);
+extern void mark_minimap_cell_dirty(Minimap *minimap, size_t x, size_t y);
+extern void mark_minimap_dirty(Minimap *minimap);
+extern void update_minimap(SDL_Renderer *renderer, Minimap *minimap);
+extern void set_minimap_zoom(Minimap *minimap, float zoom);
+extern void draw_minimap(SDL_Renderer *renderer, const Minimap *minimap, const SDL_FRect *view, Point_2D position, Degrees angle);
+extern void free_minimap(Minimap *minimap);
+
+#endif
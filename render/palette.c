@@ -0,0 +1,285 @@
+#include "./palette.h"
+
+typedef struct Histogram_Color {
+  uint16_t rgb555;
+  uint32_t count;
+} Histogram_Color;
+
+typedef struct Color_Box {
+  size_t start;
+  size_t end;
+} Color_Box;
+
+static int get_channel(uint16_t rgb555, int channel);
+static int get_box_split_channel(const Histogram_Color *colors, Color_Box box,
+                                 int *out_range);
+static void sort_box(Histogram_Color *colors, Color_Box box, int channel);
+static uint16_t pack_rgb555(Uint8 r, Uint8 g, Uint8 b);
+
+/*
+ * Median cut over a 15-bit histogram of every opaque texel in the manifest,
+ * producing one palette shared by all materials. Index 0 is kept for
+ * transparent texels.
+ */
+extern Palette *
+create_shared_palette(const World_Objects_Container *world_objects_container) {
+  uint32_t *histogram = calloc(RGB555_SIZE, sizeof(uint32_t));
+  Palette  *palette   = calloc(1, sizeof(Palette));
+  if (!histogram || !palette) {
+    free(histogram);
+    free(palette);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < world_objects_container->length; i++) {
+    const Surface_Src_Container *surfaces =
+        &world_objects_container->data[i]->surfaces;
+    for (size_t j = 0; j < surfaces->length; j++) {
+      SDL_Surface *surface = surfaces->data[j];
+      for (int y = 0; y < surface->h; y++) {
+        const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+        for (int x = 0; x < surface->w; x++) {
+          const Uint8 *texel = &row[x * 4];
+          if (texel[3] >= PALETTE_ALPHA_THRESHOLD) {
+            histogram[pack_rgb555(texel[0], texel[1], texel[2])]++;
+          }
+        }
+      }
+    }
+  }
+
+  size_t color_count = 0;
+  for (size_t i = 0; i < RGB555_SIZE; i++) {
+    color_count += histogram[i] > 0;
+  }
+
+  Histogram_Color *colors = malloc((color_count + 1) * sizeof(Histogram_Color));
+  Color_Box       *boxes  = malloc(PALETTE_SIZE * sizeof(Color_Box));
+  if (!colors || !boxes) {
+    free(histogram);
+    free(palette);
+    free(colors);
+    free(boxes);
+    return NULL;
+  }
+
+  size_t color_index = 0;
+  for (size_t i = 0; i < RGB555_SIZE; i++) {
+    if (histogram[i] > 0) {
+      colors[color_index++] = (Histogram_Color){(uint16_t)i, histogram[i]};
+    }
+  }
+  free(histogram);
+
+  // Split the box with the widest channel range until the palette is full
+  int box_count = 0;
+  if (color_count > 0) {
+    boxes[box_count++] = (Color_Box){0, color_count};
+  }
+  while (box_count < PALETTE_SIZE - 1) {
+    int widest_box     = -1;
+    int widest_range   = 0;
+    int widest_channel = 0;
+    for (int i = 0; i < box_count; i++) {
+      int range;
+      int channel = get_box_split_channel(colors, boxes[i], &range);
+      if (boxes[i].end - boxes[i].start > 1 && range > widest_range) {
+        widest_box     = i;
+        widest_range   = range;
+        widest_channel = channel;
+      }
+    }
+    if (widest_box < 0) {
+      break;
+    }
+
+    Color_Box box = boxes[widest_box];
+    sort_box(colors, box, widest_channel);
+
+    uint64_t total = 0;
+    for (size_t i = box.start; i < box.end; i++) {
+      total += colors[i].count;
+    }
+    uint64_t running = 0;
+    size_t   split   = box.start + 1;
+    for (size_t i = box.start; i < box.end - 1; i++) {
+      running += colors[i].count;
+      split = i + 1;
+      if (running * 2 >= total) {
+        break;
+      }
+    }
+
+    boxes[widest_box]  = (Color_Box){box.start, split};
+    boxes[box_count++] = (Color_Box){split, box.end};
+  }
+
+  palette->colors[PALETTE_TRANSPARENT_INDEX] = (SDL_Color){0, 0, 0, 0};
+  for (int i = 0; i < box_count; i++) {
+    uint64_t r = 0, g = 0, b = 0, total = 0;
+    for (size_t j = boxes[i].start; j < boxes[i].end; j++) {
+      r += (uint64_t)get_channel(colors[j].rgb555, 0) * colors[j].count;
+      g += (uint64_t)get_channel(colors[j].rgb555, 1) * colors[j].count;
+      b += (uint64_t)get_channel(colors[j].rgb555, 2) * colors[j].count;
+      total += colors[j].count;
+    }
+    palette->colors[i + 1] = (SDL_Color){
+        .r = (Uint8)((r * 255) / (total * 31)),
+        .g = (Uint8)((g * 255) / (total * 31)),
+        .b = (Uint8)((b * 255) / (total * 31)),
+        .a = 255,
+    };
+  }
+  palette->length = box_count + 1;
+  free(colors);
+  free(boxes);
+
+  // Inverse colour map, nearest opaque entry for every 15-bit colour
+  for (int i = 0; i < RGB555_SIZE; i++) {
+    int r = (get_channel(i, 0) * 255) / 31;
+    int g = (get_channel(i, 1) * 255) / 31;
+    int b = (get_channel(i, 2) * 255) / 31;
+
+    int best_index    = 1;
+    int best_distance = 0x7FFFFFFF;
+    for (int j = 1; j < palette->length; j++) {
+      int dr       = r - palette->colors[j].r;
+      int dg       = g - palette->colors[j].g;
+      int db       = b - palette->colors[j].b;
+      int distance = dr * dr + dg * dg + db * db;
+      if (distance < best_distance) {
+        best_distance = distance;
+        best_index    = j;
+      }
+    }
+    palette->rgb555_to_index[i] = (uint8_t)best_index;
+  }
+
+  return palette;
+}
+
+extern uint8_t find_palette_index(const Palette *palette, Uint8 r, Uint8 g,
+                                  Uint8 b) {
+  if (palette->length <= 1) {
+    return PALETTE_TRANSPARENT_INDEX;
+  }
+  return palette->rgb555_to_index[pack_rgb555(r, g, b)];
+}
+
+extern bool quantize_surface(const Palette *palette, SDL_Surface *surface,
+                             Indexed_Texture *out_texture) {
+  out_texture->w      = surface->w;
+  out_texture->h      = surface->h;
+  out_texture->texels  = malloc((size_t)surface->w * surface->h);
+  out_texture->columns = malloc((size_t)surface->w * surface->h);
+  if (!out_texture->texels || !out_texture->columns) {
+    return false;
+  }
+
+  for (int y = 0; y < surface->h; y++) {
+    const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+    for (int x = 0; x < surface->w; x++) {
+      const Uint8 *texel = &row[x * 4];
+      out_texture->texels[y * surface->w + x] =
+          texel[3] < PALETTE_ALPHA_THRESHOLD
+              ? PALETTE_TRANSPARENT_INDEX
+              : find_palette_index(palette, texel[0], texel[1], texel[2]);
+    }
+  }
+
+  for (int x = 0; x < surface->w; x++) {
+    for (int y = 0; y < surface->h; y++) {
+      out_texture->columns[x * surface->h + y] =
+          out_texture->texels[y * surface->w + x];
+    }
+  }
+
+  return true;
+}
+
+/*
+ * COLORMAP_LEVELS tables of PALETTE_SIZE entries. Level n maps each palette
+ * entry to the entry closest to it faded towards tint, so shading a texel is a
+ * single lookup.
+ */
+extern uint8_t *create_colormaps(const Palette *palette, SDL_Color tint) {
+  uint8_t *colormaps = malloc(COLORMAP_LEVELS * PALETTE_SIZE);
+  if (!colormaps) {
+    return NULL;
+  }
+
+  for (int level = 0; level < COLORMAP_LEVELS; level++) {
+    float    fade  = (float)level / (COLORMAP_LEVELS - 1) * COLORMAP_MAX_DIMMING;
+    uint8_t *table = &colormaps[level * PALETTE_SIZE];
+    for (int i = 0; i < PALETTE_SIZE; i++) {
+      if (i == PALETTE_TRANSPARENT_INDEX || i >= palette->length) {
+        table[i] = PALETTE_TRANSPARENT_INDEX;
+        continue;
+      }
+      SDL_Color color = palette->colors[i];
+      table[i]        = find_palette_index(
+          palette, (Uint8)(color.r + (tint.r - color.r) * fade),
+          (Uint8)(color.g + (tint.g - color.g) * fade),
+          (Uint8)(color.b + (tint.b - color.b) * fade));
+    }
+  }
+
+  return colormaps;
+}
+
+static uint16_t pack_rgb555(Uint8 r, Uint8 g, Uint8 b) {
+  return (uint16_t)(((r >> 3) << 10) | ((g >> 3) << 5) | (b >> 3));
+}
+
+// 0 = red, 1 = green, 2 = blue, each 0..31
+static int get_channel(uint16_t rgb555, int channel) {
+  return (rgb555 >> (10 - channel * 5)) & 31;
+}
+
+static int get_box_split_channel(const Histogram_Color *colors, Color_Box box,
+                                 int *out_range) {
+  int min[3] = {31, 31, 31};
+  int max[3] = {0, 0, 0};
+  for (size_t i = box.start; i < box.end; i++) {
+    for (int channel = 0; channel < 3; channel++) {
+      int value = get_channel(colors[i].rgb555, channel);
+      min[channel] = value < min[channel] ? value : min[channel];
+      max[channel] = value > max[channel] ? value : max[channel];
+    }
+  }
+
+  int best_channel = 0;
+  for (int channel = 1; channel < 3; channel++) {
+    if (max[channel] - min[channel] > max[best_channel] - min[best_channel]) {
+      best_channel = channel;
+    }
+  }
+  *out_range = max[best_channel] - min[best_channel];
+  return best_channel;
+}
+
+// Stable counting sort of a box on one 5-bit channel
+static void sort_box(Histogram_Color *colors, Color_Box box, int channel) {
+  size_t           length = box.end - box.start;
+  Histogram_Color *sorted = malloc(length * sizeof(Histogram_Color));
+  if (!sorted) {
+    return;
+  }
+
+  size_t offsets[32] = {0};
+  for (size_t i = box.start; i < box.end; i++) {
+    offsets[get_channel(colors[i].rgb555, channel)]++;
+  }
+  size_t total = 0;
+  for (int i = 0; i < 32; i++) {
+    size_t count = offsets[i];
+    offsets[i]   = total;
+    total += count;
+  }
+  for (size_t i = box.start; i < box.end; i++) {
+    sorted[offsets[get_channel(colors[i].rgb555, channel)]++] = colors[i];
+  }
+
+  memcpy(&colors[box.start], sorted, length * sizeof(Histogram_Color));
+  free(sorted);
+}
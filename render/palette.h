@@ -0,0 +1,19 @@
+#ifndef RENDER_PALETTE_H
+#define RENDER_PALETTE_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL_surface.h>
+
+#include "../data/grid/constants.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Palette *create_shared_palette(const World_Objects_Container *world_objects_container);
+extern uint8_t find_palette_index(const Palette *palette, Uint8 r, Uint8 g, Uint8 b);
+extern bool quantize_surface(const Palette *palette, SDL_Surface *surface, Indexed_Texture *out_texture);
+extern uint8_t *create_colormaps(const Palette *palette, SDL_Color tint);
+
+#endif
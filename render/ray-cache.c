@@ -0,0 +1,47 @@
+#include "./ray-cache.h"
+
+extern Ray_Cache *create_ray_cache(size_t length) {
+  Ray_Cache *ray_cache = calloc(1, sizeof(Ray_Cache));
+  if (!ray_cache) {
+    return NULL;
+  }
+  ray_cache->rays = calloc(length, sizeof(Cached_Ray));
+  if (!ray_cache->rays) {
+    free(ray_cache);
+    return NULL;
+  }
+  ray_cache->length     = length;
+  ray_cache->generation = 1; // zeroed rays start out stale
+  return ray_cache;
+}
+
+/*
+ * Called once per frame before any lookups. Moving the eye or changing how far
+ * rays travel makes every cached traversal stale, pure rotation keeps them.
+ */
+extern void prepare_ray_cache(Ray_Cache *ray_cache, Point_2D eye,
+                              Scalar max_ray_length) {
+  if (ray_cache->eye.x != eye.x || ray_cache->eye.y != eye.y ||
+      ray_cache->max_ray_length != max_ray_length) {
+    ray_cache->eye            = eye;
+    ray_cache->max_ray_length = max_ray_length;
+    invalidate_ray_cache(ray_cache);
+  }
+}
+
+// For anything else a traversal depends on, like edits to the tile map
+extern void invalidate_ray_cache(Ray_Cache *ray_cache) {
+  ray_cache->generation++;
+  if (ray_cache->generation == 0) {
+    memset(ray_cache->rays, 0, ray_cache->length * sizeof(Cached_Ray));
+    ray_cache->generation = 1;
+  }
+}
+
+extern void free_ray_cache(Ray_Cache *ray_cache) {
+  if (!ray_cache) {
+    return;
+  }
+  free(ray_cache->rays);
+  free(ray_cache);
+}
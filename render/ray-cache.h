@@ -0,0 +1,31 @@
+#ifndef RAY_CACHE_H
+#define RAY_CACHE_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./types.h"
+
+extern Ray_Cache *create_ray_cache(size_t length);
+extern void prepare_ray_cache(Ray_Cache *ray_cache, Point_2D eye, Scalar max_ray_length);
+extern void invalidate_ray_cache(Ray_Cache *ray_cache);
+extern void free_ray_cache(Ray_Cache *ray_cache);
+
+// The cached ray at index, NULL when it has to be cast again
+static inline Cached_Ray *get_cached_ray(Ray_Cache *ray_cache, size_t index) {
+  Cached_Ray *ray = &ray_cache->rays[index];
+  if (ray->generation != ray_cache->generation) {
+    ray_cache->cast_count++;
+    return NULL;
+  }
+  ray_cache->reused_count++;
+  return ray;
+}
+
+// Marks a freshly cast ray as valid for the current generation
+static inline void store_cached_ray(Ray_Cache *ray_cache, Cached_Ray *ray) {
+  ray->generation = ray_cache->generation;
+}
+
+#endif
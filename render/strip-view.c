@@ -0,0 +1,626 @@
+#include "./strip-view.h"
+
+static float cos_lut[STRIP_VIEW_LUT_ANGLES];
+static float sin_lut[STRIP_VIEW_LUT_ANGLES];
+
+static void       init_strip_view_luts(void);
+static int        get_angle_index(float angle_deg);
+static Column_Hit project_ray_hit(const Strip_View *strip_view,
+                                  const Ray_Hit *hit, Point_2D ray_start,
+                                  int theta_lut_index);
+static void       cast_ray(const Tile_Map *tile_map, Point_2D ray_start,
+                           int lut_index, Scalar max_ray_length,
+                           Cached_Ray *out_ray);
+static void       trace_strip_rays(Strip_View         *strip_view,
+                                   const Render_Scene *scene, Camera camera);
+static void       draw_floor_pass(Strip_View         *strip_view,
+                                  const Render_Scene *scene, Camera camera);
+static void       draw_column_hit(const Strip_View   *strip_view,
+                                  const Render_Scene *scene, size_t column,
+                                  const Column_Hit *hit);
+static void       draw_opaque_wall_pass(const Strip_View   *strip_view,
+                                        const Render_Scene *scene);
+static void       draw_fog_pass(const Strip_View   *strip_view,
+                                const Render_Scene *scene);
+static void       draw_translucent_wall_pass(const Strip_View   *strip_view,
+                                             const Render_Scene *scene);
+static void       draw_sprite_pass(const Strip_View   *strip_view,
+                                   const Render_Scene *scene, Camera camera);
+
+/*
+ * Rays are cached by trig table index, so turning in place reuses them. Every
+ * view shares the one trig table, filled by the first create.
+ */
+extern Strip_View *create_strip_view(SDL_Renderer *renderer, SDL_FRect rect,
+                                     size_t ray_count) {
+  if (!renderer || ray_count < 2 || rect.h < 1) {
+    return NULL;
+  }
+  init_strip_view_luts();
+
+  Strip_View *strip_view = calloc(1, sizeof(Strip_View));
+  if (!strip_view) {
+    return NULL;
+  }
+  size_t row_count                  = (size_t)rect.h;
+  strip_view->renderer              = renderer;
+  strip_view->rect                  = rect;
+  strip_view->strip_w               = rect.w / (ray_count - 1);
+  strip_view->angle_step            = (float)PLAYER_FOV_DEG / (ray_count - 1);
+  strip_view->g_buffer              = create_column_g_buffer(ray_count);
+  strip_view->ray_cache             = create_ray_cache(STRIP_VIEW_LUT_ANGLES);
+  strip_view->floor_fog_spans       = malloc(row_count * ray_count *
+                                             sizeof(SDL_FRect));
+  strip_view->floor_fog_span_counts = calloc(row_count, sizeof(int));
+  if (!strip_view->g_buffer || !strip_view->ray_cache ||
+      !strip_view->floor_fog_spans || !strip_view->floor_fog_span_counts) {
+    free_strip_view(strip_view);
+    return NULL;
+  }
+  return strip_view;
+}
+
+/*
+ * The frame as separate stages over one G-buffer, each timed into
+ * stage_timings. Draws over whatever is in rect, which should be cleared to
+ * the fog colour.
+ */
+extern void render_strip_view(Strip_View *strip_view, const Render_Scene *scene,
+                              Camera camera) {
+  Render_Stage_Timings *timings     = &strip_view->stage_timings;
+  Uint64                stage_start = SDL_GetPerformanceCounter();
+  trace_strip_rays(strip_view, scene, camera);
+  add_render_stage_time(timings, RENDER_STAGE_TRAVERSAL, stage_start);
+
+  stage_start = SDL_GetPerformanceCounter();
+  draw_floor_pass(strip_view, scene, camera);
+  add_render_stage_time(timings, RENDER_STAGE_FLOORS, stage_start);
+
+  stage_start = SDL_GetPerformanceCounter();
+  draw_opaque_wall_pass(strip_view, scene);
+  add_render_stage_time(timings, RENDER_STAGE_WALLS, stage_start);
+
+  stage_start = SDL_GetPerformanceCounter();
+  draw_fog_pass(strip_view, scene);
+  add_render_stage_time(timings, RENDER_STAGE_FOG, stage_start);
+
+  stage_start = SDL_GetPerformanceCounter();
+  draw_translucent_wall_pass(strip_view, scene);
+  add_render_stage_time(timings, RENDER_STAGE_WALLS, stage_start);
+
+  stage_start = SDL_GetPerformanceCounter();
+  draw_sprite_pass(strip_view, scene, camera);
+  add_render_stage_time(timings, RENDER_STAGE_SPRITES, stage_start);
+
+  timings->frame_count++;
+}
+
+extern void free_strip_view(Strip_View *strip_view) {
+  if (!strip_view) {
+    return;
+  }
+  free_column_g_buffer(strip_view->g_buffer);
+  free_ray_cache(strip_view->ray_cache);
+  free(strip_view->floor_fog_spans);
+  free(strip_view->floor_fog_span_counts);
+  free(strip_view);
+}
+
+static void init_strip_view_luts(void) {
+  for (int i = 0; i < STRIP_VIEW_LUT_ANGLES; i++) {
+    float angle_rad = (i * STRIP_VIEW_LUT_STEP_DEG) * (M_PI / 180.0f);
+    cos_lut[i]      = cosf(angle_rad);
+    sin_lut[i]      = sinf(angle_rad);
+  }
+}
+
+static int get_angle_index(float angle_deg) {
+  int index = (int)(angle_deg * (1.0f / STRIP_VIEW_LUT_STEP_DEG)) %
+              STRIP_VIEW_LUT_ANGLES;
+  return (index < 0) ? index + STRIP_VIEW_LUT_ANGLES : index;
+}
+
+// Texture colour mod for a light level, faded out by the fog amount
+static Uint8 get_shade_color_mod(uint8_t light_level, float fog_amount) {
+  return (255 * light_level / LIGHT_LEVEL_MAX) * (1.0f - fog_amount);
+}
+
+/*
+ * Additive colour that, over a rect drawn with get_shade_color_mod, blends the
+ * rect towards the fog
+ */
+static void set_fog_overlay_color(SDL_Renderer *renderer, float fog_amount) {
+  SDL_SetRenderDrawColor(renderer, FOG_COLOR_R * fog_amount,
+                         FOG_COLOR_G * fog_amount, FOG_COLOR_B * fog_amount,
+                         255);
+}
+
+static Point_1D get_column_screen_x(const Strip_View *strip_view,
+                                    size_t            column) {
+  return strip_view->rect.x + column * strip_view->strip_w;
+}
+
+static SDL_Texture *get_current_texture(const Render_Scene *scene,
+                                        Material_Id         material) {
+  World_Object *world_object = scene->world_objects_container->data[material];
+  return world_object->textures
+      .data[world_object->animation_state.current_frame_index];
+}
+
+static bool is_translucent_hit(const Render_Scene *scene,
+                               const Column_Hit   *hit) {
+  return scene->world_objects_container->data[hit->material]->is_translucent;
+}
+
+static Column_Hit project_ray_hit(const Strip_View *strip_view,
+                                  const Ray_Hit *hit, Point_2D ray_start,
+                                  int theta_lut_index) {
+  int    view_h        = strip_view->rect.h;
+  Scalar ray_length    = sqrt(pow(ray_start.x - hit->intersection.x, 2) +
+                              pow(ray_start.y - hit->intersection.y, 2));
+  Scalar perp_distance = ray_length * cos_lut[theta_lut_index];
+  Scalar wall_strip_h  = (GRID_CELL_SIZE * view_h) / perp_distance;
+
+  Point_1D wall_x            = (hit->surface == WS_VERTICAL)
+                                   ? hit->intersection.y
+                                   : hit->intersection.x;
+  Point_1D wall_x_normalized = wall_x / GRID_CELL_SIZE;
+
+  return (Column_Hit){
+      .grid          = hit->grid,
+      .material      = hit->material,
+      .surface       = hit->surface,
+      .perp_distance = perp_distance,
+      .wall_u        = wall_x_normalized - floorf(wall_x_normalized),
+      .wall_top      = (view_h - wall_strip_h) / 2,
+      .wall_bottom   = (view_h + wall_strip_h) / 2,
+  };
+}
+
+/*
+ * DDA along one absolute ray direction. Translucent cells are stacked and the
+ * ray carries on, the first opaque cell (or a full stack) terminates it. Rays
+ * stop after max_ray_length, the view distance at the edge of the FOV, so the
+ * result can be reused by any column that looks the same way.
+ */
+static void cast_ray(const Tile_Map *tile_map, Point_2D ray_start,
+                     int lut_index, Scalar max_ray_length,
+                     Cached_Ray *out_ray) {
+  IPoint_1D  grid_x = floorf(ray_start.x / GRID_CELL_SIZE);
+  Point_1D   norm_x = ray_start.x / GRID_CELL_SIZE;
+  Vector_1D  x_dir  = cos_lut[lut_index];
+  IVector_1D step_x = (x_dir >= 0) ? 1 : -1;
+  Vector_1D  delta_x               = fabs(1.0f / x_dir);
+  Vector_1D  norm_x_dist_cell_edge = (x_dir < 0)
+                                         ? (norm_x - grid_x) * delta_x
+                                         : (grid_x + 1 - norm_x) * delta_x;
+
+  IPoint_1D  grid_y = floorf(ray_start.y / GRID_CELL_SIZE);
+  Point_1D   norm_y = ray_start.y / GRID_CELL_SIZE;
+  Vector_1D  y_dir  = sin_lut[lut_index];
+  IVector_1D step_y = (y_dir >= 0) ? 1 : -1;
+  Vector_1D  delta_y               = fabs(1.0f / y_dir);
+  Vector_1D  norm_y_dist_cell_edge = (y_dir < 0)
+                                         ? (norm_y - grid_y) * delta_y
+                                         : (grid_y + 1 - norm_y) * delta_y;
+
+  Point_2D     intersection;
+  Wall_Surface surface_hit;
+
+  out_ray->hit_count   = 0;
+  out_ray->is_wall_hit = false;
+  while (!out_ray->is_wall_hit) {
+    Scalar next_edge_distance =
+        fminf(norm_x_dist_cell_edge, norm_y_dist_cell_edge) * GRID_CELL_SIZE;
+    if (next_edge_distance > max_ray_length) {
+      break;
+    }
+
+    if (norm_x_dist_cell_edge < norm_y_dist_cell_edge) {
+      intersection.x = (x_dir < 0) ? grid_x * GRID_CELL_SIZE
+                                   : (grid_x + 1) * GRID_CELL_SIZE;
+      intersection.y =
+          ray_start.y + (intersection.x - ray_start.x) * y_dir / x_dir;
+      norm_x_dist_cell_edge += delta_x;
+      grid_x                += step_x;
+      surface_hit            = WS_VERTICAL;
+    } else {
+      intersection.y = (y_dir < 0) ? grid_y * GRID_CELL_SIZE
+                                   : (grid_y + 1) * GRID_CELL_SIZE;
+      intersection.x =
+          ray_start.x + (intersection.y - ray_start.y) * x_dir / y_dir;
+      norm_y_dist_cell_edge += delta_y;
+      grid_y                += step_y;
+      surface_hit            = WS_HORIZONTAL;
+    }
+
+    // Rays leaving the map are not drawn
+    if (grid_x < 0 || grid_y < 0 || (size_t)grid_x >= tile_map->width ||
+        (size_t)grid_y >= tile_map->height) {
+      break;
+    }
+
+    Material_Id wall_id =
+        tile_map->wall_ids[(size_t)grid_y * tile_map->width + grid_x];
+    if (wall_id == MATERIAL_ID_EMPTY) {
+      continue;
+    }
+
+    out_ray->hits[out_ray->hit_count++] = (Ray_Hit){
+        .grid.x       = grid_x,
+        .grid.y       = grid_y,
+        .material     = wall_id,
+        .surface      = surface_hit,
+        .intersection = intersection,
+    };
+    if ((tile_map->material_flags[wall_id] & MATERIAL_FLAG_OPAQUE) ||
+        out_ray->hit_count == MAX_RAY_HITS) {
+      out_ray->is_wall_hit = true;
+    }
+  }
+}
+
+/*
+ * Traversal stage, fills the G-buffer without drawing anything. Rays come
+ * from the cache when last frame already cast the same absolute direction
+ * from the same eye, so turning in place only casts the newly exposed edge.
+ * Texture animation is resolved by the shading passes and needs no recast.
+ */
+static void trace_strip_rays(Strip_View *strip_view, const Render_Scene *scene,
+                             Camera camera) {
+  Column_G_Buffer *g_buffer        = strip_view->g_buffer;
+  Ray_Cache       *ray_cache       = strip_view->ray_cache;
+  Degrees          start_angle_deg = camera.angle - PLAYER_FOV_DEG / 2;
+  Point_2D         ray_start       = camera.position;
+  Scalar           max_distance    = scene->fog.max_distance;
+  prepare_ray_cache(
+      ray_cache, ray_start,
+      max_distance / cos_lut[get_angle_index(PLAYER_FOV_DEG / 2)]);
+
+  for (size_t column = 0; column < g_buffer->length; column++) {
+    Degrees curr_angle_deg =
+        start_angle_deg + column * strip_view->angle_step;
+    int curr_lut_index  = get_angle_index(curr_angle_deg);
+    int theta_lut_index = get_angle_index(curr_angle_deg - camera.angle);
+
+    Cached_Ray *ray = get_cached_ray(ray_cache, curr_lut_index);
+    if (!ray) {
+      ray = &ray_cache->rays[curr_lut_index];
+      cast_ray(scene->tile_map, ray_start, curr_lut_index,
+               ray_cache->max_ray_length, ray);
+      store_cached_ray(ray_cache, ray);
+    }
+
+    // Hits past this column's view distance are dropped, as if never reached
+    Column_Hit *hits        = get_column_hits(g_buffer, column);
+    int         hit_count   = 0;
+    bool        is_wall_hit = ray->is_wall_hit;
+    for (int i = 0; i < ray->hit_count; i++) {
+      hits[hit_count] = project_ray_hit(strip_view, &ray->hits[i], ray_start,
+                                        theta_lut_index);
+      if (hits[hit_count].perp_distance > max_distance) {
+        is_wall_hit = false;
+        break;
+      }
+      hit_count++;
+    }
+
+    // Floors start at the horizon when the ray escaped the map
+    g_buffer->ray_dirs_x[column]     = cos_lut[curr_lut_index];
+    g_buffer->ray_dirs_y[column]     = sin_lut[curr_lut_index];
+    g_buffer->inv_cos_thetas[column] = 1.0f / cos_lut[theta_lut_index];
+    g_buffer->hit_counts[column]     = hit_count;
+    g_buffer->perp_distances[column] =
+        is_wall_hit ? hits[hit_count - 1].perp_distance : INFINITY;
+    g_buffer->floor_start_ys[column] =
+        is_wall_hit ? hits[hit_count - 1].wall_bottom
+                    : (int)strip_view->rect.h / 2;
+  }
+}
+
+/*
+ * Floor stage. Scanlines past the view distance are left as the fog coloured
+ * clear, without sampling. Fogged texels are queued as per row spans for the
+ * fog stage, merged across neighbouring columns. Floors are anchored at the
+ * player's corner rather than the eye.
+ */
+static void draw_floor_pass(Strip_View *strip_view, const Render_Scene *scene,
+                            Camera camera) {
+  const Column_G_Buffer *g_buffer     = strip_view->g_buffer;
+  const Tile_Map        *tile_map     = scene->tile_map;
+  size_t                 ray_count    = g_buffer->length;
+  int                    view_h       = strip_view->rect.h;
+  int                    fog_start_y  = get_fog_floor_start_y(&scene->fog, view_h);
+  Point_2D               floor_origin = {
+      .x = camera.position.x - (PLAYER_W / 2),
+      .y = camera.position.y - (PLAYER_H / 2),
+  };
+  memset(strip_view->floor_fog_span_counts, 0, view_h * sizeof(int));
+
+  for (size_t column = 0; column < ray_count; column++) {
+    Point_1D  scr_x = get_column_screen_x(strip_view, column);
+    Vector_1D x_step =
+        g_buffer->ray_dirs_x[column] * g_buffer->inv_cos_thetas[column];
+    Vector_1D y_step =
+        g_buffer->ray_dirs_y[column] * g_buffer->inv_cos_thetas[column];
+    int first_floor_y = fmaxf(g_buffer->floor_start_ys[column], fog_start_y);
+
+    for (int scr_y = first_floor_y; scr_y < view_h; scr_y++) {
+      Scalar distance =
+          ((view_h / 2.0f) / (scr_y - view_h / 2.0f)) * GRID_CELL_SIZE;
+      Point_1D floor_world_x = floor_origin.x + x_step * distance;
+      Point_1D floor_world_y = floor_origin.y + y_step * distance;
+
+      IPoint_1D floor_grid_y = floorf(floor_world_y / GRID_CELL_SIZE);
+      IPoint_1D floor_grid_x = floorf(floor_world_x / GRID_CELL_SIZE);
+      if (floor_grid_x < 0 || floor_grid_y < 0 ||
+          (size_t)floor_grid_x >= tile_map->width ||
+          (size_t)floor_grid_y >= tile_map->height) {
+        continue;
+      }
+
+      Material_Id floor_id =
+          tile_map->floor_ids[(size_t)floor_grid_y * tile_map->width +
+                              floor_grid_x];
+      if (floor_id == MATERIAL_ID_EMPTY) {
+        continue;
+      }
+
+      SDL_Texture *texture    = get_current_texture(scene, floor_id);
+      float        fog_amount = get_fog_amount(&scene->fog, distance);
+      Uint8        shade      = get_shade_color_mod(
+          sample_lightmap(scene->lightmap, floor_grid_x, floor_grid_y),
+          fog_amount);
+
+      SDL_FRect floor_src_rect = {
+          .x = (int)(floor_world_x * texture->w / GRID_CELL_SIZE) % texture->w,
+          .y = (int)(floor_world_y * texture->h / GRID_CELL_SIZE) % texture->h,
+          .w = 1,
+          .h = 1,
+      };
+      SDL_FRect floor_dst_rect = {
+          .x = scr_x,
+          .y = strip_view->rect.y + scr_y,
+          .w = strip_view->strip_w,
+          .h = 1,
+      };
+      SDL_SetTextureColorMod(texture, shade, shade, shade);
+      SDL_RenderTexture(strip_view->renderer, texture, &floor_src_rect,
+                        &floor_dst_rect);
+
+      if (fog_amount <= 0.0f) {
+        continue;
+      }
+      SDL_FRect *row_spans  = &strip_view->floor_fog_spans[scr_y * ray_count];
+      int       *span_count = &strip_view->floor_fog_span_counts[scr_y];
+      if (*span_count > 0) {
+        SDL_FRect *last_span = &row_spans[*span_count - 1];
+        if (last_span->x + last_span->w + 0.5f >= scr_x) {
+          last_span->w = scr_x + strip_view->strip_w - last_span->x;
+          continue;
+        }
+      }
+      row_spans[(*span_count)++] = floor_dst_rect;
+    }
+  }
+}
+
+// Draws one projected hit as a textured strip, shaded by the cell it faces
+static void draw_column_hit(const Strip_View   *strip_view,
+                            const Render_Scene *scene, size_t column,
+                            const Column_Hit *hit) {
+  const Column_G_Buffer *g_buffer = strip_view->g_buffer;
+  SDL_Texture           *texture  = get_current_texture(scene, hit->material);
+  Point_1D               texture_x =
+      fminf(floorf(hit->wall_u * texture->w), texture->w - 1);
+
+  SDL_FRect wall_src_rect = {
+      .x = texture_x,
+      .y = 0,
+      .w = 1,
+      .h = texture->h,
+  };
+  SDL_FRect wall_dst_rect = {
+      .x = get_column_screen_x(strip_view, column),
+      .y = strip_view->rect.y + hit->wall_top,
+      .w = strip_view->strip_w,
+      .h = hit->wall_bottom - hit->wall_top,
+  };
+
+  // Faces are lit by the open cell they look into, not the wall cell itself
+  IPoint_2D facing_cell = hit->grid;
+  if (hit->surface == WS_VERTICAL) {
+    facing_cell.x += (g_buffer->ray_dirs_x[column] > 0) ? -1 : 1;
+  } else {
+    facing_cell.y += (g_buffer->ray_dirs_y[column] > 0) ? -1 : 1;
+  }
+  uint8_t light =
+      sample_lightmap(scene->lightmap, facing_cell.x, facing_cell.y);
+  float fog_amount = get_fog_amount(&scene->fog, hit->perp_distance);
+
+  // Translucent walls fade into what is behind them, which is already fogged
+  if (is_translucent_hit(scene, hit)) {
+    Uint8 shade = get_shade_color_mod(light, 0.0f);
+    SDL_SetTextureColorMod(texture, shade, shade, shade);
+    SDL_SetTextureAlphaMod(texture, 255 * (1.0f - fog_amount));
+    SDL_RenderTexture(strip_view->renderer, texture, &wall_src_rect,
+                      &wall_dst_rect);
+    SDL_SetTextureAlphaMod(texture, 255);
+    return;
+  }
+
+  Uint8 shade = get_shade_color_mod(light, fog_amount);
+  SDL_SetTextureColorMod(texture, shade, shade, shade);
+  SDL_RenderTexture(strip_view->renderer, texture, &wall_src_rect,
+                    &wall_dst_rect);
+}
+
+// Opaque wall stage, only the farthest hit of a column can be opaque
+static void draw_opaque_wall_pass(const Strip_View   *strip_view,
+                                  const Render_Scene *scene) {
+  const Column_G_Buffer *g_buffer = strip_view->g_buffer;
+  for (size_t column = 0; column < g_buffer->length; column++) {
+    int hit_count = g_buffer->hit_counts[column];
+    if (hit_count == 0) {
+      continue;
+    }
+    const Column_Hit *hit = &get_column_hits(g_buffer, column)[hit_count - 1];
+    if (!is_translucent_hit(scene, hit)) {
+      draw_column_hit(strip_view, scene, column, hit);
+    }
+  }
+}
+
+/*
+ * Fog stage, adds the fog colour over the floors and opaque walls. Runs before
+ * translucent walls and sprites, which fade themselves with alpha.
+ */
+static void draw_fog_pass(const Strip_View   *strip_view,
+                          const Render_Scene *scene) {
+  const Column_G_Buffer *g_buffer  = strip_view->g_buffer;
+  SDL_Renderer          *renderer  = strip_view->renderer;
+  size_t                 ray_count = g_buffer->length;
+  int                    view_h    = strip_view->rect.h;
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_ADD);
+
+  int fog_start_y = get_fog_floor_start_y(&scene->fog, view_h);
+  for (int scr_y = fog_start_y; scr_y < view_h; scr_y++) {
+    int span_count = strip_view->floor_fog_span_counts[scr_y];
+    if (span_count == 0) {
+      continue;
+    }
+    Scalar distance =
+        ((view_h / 2.0f) / (scr_y - view_h / 2.0f)) * GRID_CELL_SIZE;
+    set_fog_overlay_color(renderer, get_fog_amount(&scene->fog, distance));
+    SDL_RenderFillRects(renderer,
+                        &strip_view->floor_fog_spans[scr_y * ray_count],
+                        span_count);
+  }
+
+  for (size_t column = 0; column < ray_count; column++) {
+    int hit_count = g_buffer->hit_counts[column];
+    if (hit_count == 0) {
+      continue;
+    }
+    const Column_Hit *hit = &get_column_hits(g_buffer, column)[hit_count - 1];
+    if (is_translucent_hit(scene, hit)) {
+      continue;
+    }
+    float fog_amount = get_fog_amount(&scene->fog, hit->perp_distance);
+    if (fog_amount <= 0.0f) {
+      continue;
+    }
+    SDL_FRect wall_dst_rect = {
+        .x = get_column_screen_x(strip_view, column),
+        .y = strip_view->rect.y + hit->wall_top,
+        .w = strip_view->strip_w,
+        .h = hit->wall_bottom - hit->wall_top,
+    };
+    set_fog_overlay_color(renderer, fog_amount);
+    SDL_RenderFillRect(renderer, &wall_dst_rect);
+  }
+
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+// Translucent wall stage, back to front so each composites over the last
+static void draw_translucent_wall_pass(const Strip_View   *strip_view,
+                                       const Render_Scene *scene) {
+  const Column_G_Buffer *g_buffer = strip_view->g_buffer;
+  for (size_t column = 0; column < g_buffer->length; column++) {
+    const Column_Hit *hits = get_column_hits(g_buffer, column);
+    for (int i = g_buffer->hit_counts[column] - 1; i >= 0; i--) {
+      if (is_translucent_hit(scene, &hits[i])) {
+        draw_column_hit(strip_view, scene, column, &hits[i]);
+      }
+    }
+  }
+}
+
+/*
+ * Sprite stage. Billboards are drawn far to near after the walls. Each sprite
+ * is split into runs of ray columns where it is closer than the G-buffer's
+ * wall distance, and every run is a single textured draw.
+ */
+static void draw_sprite_pass(const Strip_View   *strip_view,
+                             const Render_Scene *scene, Camera camera) {
+  const Column_G_Buffer *g_buffer = strip_view->g_buffer;
+  SDL_FRect              rect     = strip_view->rect;
+  float                  strip_w  = strip_view->strip_w;
+  size_t                 length   = build_sprite_draw_list(
+      scene->sprite_draw_list, scene->sprite_entities, scene->spatial_hash,
+      scene->pvs, scene->fog.max_distance, camera.position, camera.angle);
+
+  for (size_t i = length; i-- > 0;) {
+    Sprite_Projection *projection = &scene->sprite_draw_list->data[i];
+    if (projection->perp_distance >= scene->fog.max_distance) {
+      continue;
+    }
+    const Sprite_Entity *entity =
+        &scene->sprite_entities->data[projection->entity_index];
+    SDL_Texture *texture = get_current_texture(scene, entity->material);
+    if (!texture) {
+      continue;
+    }
+    Uint8 shade = get_shade_color_mod(
+        sample_lightmap(scene->lightmap,
+                        floorf(entity->position.x / GRID_CELL_SIZE),
+                        floorf(entity->position.y / GRID_CELL_SIZE)),
+        0.0f);
+    float fog_amount =
+        get_fog_amount(&scene->fog, projection->perp_distance);
+    SDL_SetTextureColorMod(texture, shade, shade, shade);
+    SDL_SetTextureAlphaMod(texture, 255 * (1.0f - fog_amount));
+
+    int      view_h       = rect.h;
+    Scalar   wall_strip_h = (GRID_CELL_SIZE * view_h) / projection->perp_distance;
+    Scalar   sprite_h     = wall_strip_h * entity->scale;
+    Point_1D sprite_top   = (view_h + wall_strip_h) / 2 - sprite_h;
+    Scalar   sprite_w     = sprite_h * texture->w / texture->h;
+    Point_1D sprite_left =
+        rect.x + projection->view_x * rect.w - sprite_w / 2;
+    int first_column = floorf((sprite_left - rect.x) / strip_w);
+    int last_column  = floorf((sprite_left + sprite_w - rect.x) / strip_w);
+    first_column     = first_column < 0 ? 0 : first_column;
+    last_column      = last_column >= (int)g_buffer->length
+                           ? (int)g_buffer->length - 1
+                           : last_column;
+
+    int column = first_column;
+    while (column <= last_column) {
+      if (projection->perp_distance >= g_buffer->perp_distances[column]) {
+        column++;
+        continue;
+      }
+
+      int run_start = column;
+      while (column <= last_column &&
+             projection->perp_distance < g_buffer->perp_distances[column]) {
+        column++;
+      }
+
+      Point_1D run_left  = rect.x + run_start * strip_w;
+      Point_1D run_right = rect.x + column * strip_w;
+      run_left           = fmaxf(run_left, sprite_left);
+      run_right          = fminf(run_right, sprite_left + sprite_w);
+      if (run_right <= run_left) {
+        continue;
+      }
+
+      SDL_FRect src_rect = {
+          .x = (run_left - sprite_left) / sprite_w * texture->w,
+          .y = 0,
+          .w = (run_right - run_left) / sprite_w * texture->w,
+          .h = texture->h,
+      };
+      SDL_FRect dst_rect = {
+          .x = run_left,
+          .y = rect.y + sprite_top,
+          .w = run_right - run_left,
+          .h = sprite_h,
+      };
+      SDL_RenderTexture(strip_view->renderer, texture, &src_rect, &dst_rect);
+    }
+    SDL_SetTextureAlphaMod(texture, 255);
+  }
+}
@@ -0,0 +1,27 @@
+#ifndef STRIP_VIEW_H
+#define STRIP_VIEW_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_render.h>
+
+#include "../assets/sprites/setup.h"
+#include "../assets/textures/types.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/lightmap.h"
+#include "../objects/player/constants.h"
+#include "./constants.h"
+#include "./fog.h"
+#include "./g-buffer.h"
+#include "./ray-cache.h"
+#include "./types.h"
+
+extern Strip_View *create_strip_view(SDL_Renderer *renderer, SDL_FRect rect, size_t ray_count);
+extern void render_strip_view(Strip_View *strip_view, const Render_Scene *scene, Camera camera);
+extern void free_strip_view(Strip_View *strip_view);
+
+#endif
@@ -0,0 +1,214 @@
+#include "./text.h"
+
+static SDL_Texture *create_atlas_texture(SDL_Renderer *renderer, TTF_Font *font,
+                                         Glyph *out_glyphs);
+static bool reserve_text_quads(Glyph_Atlas *glyph_atlas, size_t quad_count);
+
+/*
+ * Rasterizes every printable ASCII glyph once, white, packed in rows into a
+ * single texture. Colour comes from the vertices, so one atlas serves every
+ * text colour.
+ */
+extern Glyph_Atlas *create_glyph_atlas(SDL_Renderer *renderer,
+                                       const char *font_path,
+                                       float point_size) {
+  if (!TTF_Init()) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't initialize TTF: %s",
+                 SDL_GetError());
+    return NULL;
+  }
+  TTF_Font *font = TTF_OpenFont(font_path, point_size);
+  if (!font) {
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't open font %s: %s",
+                 font_path, SDL_GetError());
+    TTF_Quit();
+    return NULL;
+  }
+
+  Glyph_Atlas *glyph_atlas = calloc(1, sizeof(Glyph_Atlas));
+  if (glyph_atlas) {
+    glyph_atlas->line_height = TTF_GetFontHeight(font);
+    glyph_atlas->texture = create_atlas_texture(renderer, font, glyph_atlas->glyphs);
+    if (!glyph_atlas->texture) {
+      free_glyph_atlas(glyph_atlas);
+      glyph_atlas = NULL;
+    }
+  }
+
+  // The atlas is all that is kept of the font
+  TTF_CloseFont(font);
+  TTF_Quit();
+  return glyph_atlas;
+}
+
+/*
+ * Appends a quad per glyph, nothing is drawn until flush_text. Characters
+ * outside printable ASCII are skipped. Returns the pen position after the
+ * string.
+ */
+extern float queue_text(Glyph_Atlas *glyph_atlas, float x, float y,
+                        const char *text, SDL_Color color) {
+  size_t length = strlen(text);
+  if (!glyph_atlas || !reserve_text_quads(glyph_atlas, length)) {
+    return x;
+  }
+
+  float      atlas_w = glyph_atlas->texture->w;
+  float      atlas_h = glyph_atlas->texture->h;
+  SDL_FColor fcolor  = {color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
+                        color.a / 255.0f};
+  for (size_t i = 0; i < length; i++) {
+    unsigned char c = text[i];
+    if (c < GLYPH_FIRST || c > GLYPH_LAST) {
+      continue;
+    }
+    const Glyph *glyph = &glyph_atlas->glyphs[c - GLYPH_FIRST];
+    if (glyph->src.w > 0) {
+      float u0 = glyph->src.x / atlas_w;
+      float v0 = glyph->src.y / atlas_h;
+      float u1 = (glyph->src.x + glyph->src.w) / atlas_w;
+      float v1 = (glyph->src.y + glyph->src.h) / atlas_h;
+
+      SDL_Vertex *quad = &glyph_atlas->vertices[glyph_atlas->vertex_length];
+      quad[0] = (SDL_Vertex){{x, y}, fcolor, {u0, v0}};
+      quad[1] = (SDL_Vertex){{x + glyph->src.w, y}, fcolor, {u1, v0}};
+      quad[2] = (SDL_Vertex){{x + glyph->src.w, y + glyph->src.h}, fcolor, {u1, v1}};
+      quad[3] = (SDL_Vertex){{x, y + glyph->src.h}, fcolor, {u0, v1}};
+      glyph_atlas->vertex_length += 4;
+    }
+    x += glyph->advance;
+  }
+  return x;
+}
+
+extern float measure_text(const Glyph_Atlas *glyph_atlas, const char *text) {
+  float width = 0;
+  for (const unsigned char *c = (const unsigned char *)text; *c; c++) {
+    if (*c >= GLYPH_FIRST && *c <= GLYPH_LAST) {
+      width += glyph_atlas->glyphs[*c - GLYPH_FIRST].advance;
+    }
+  }
+  return width;
+}
+
+// Every queued string in one draw call
+extern void flush_text(SDL_Renderer *renderer, Glyph_Atlas *glyph_atlas) {
+  if (!glyph_atlas || glyph_atlas->vertex_length == 0) {
+    return;
+  }
+  int quad_count = glyph_atlas->vertex_length / 4;
+  SDL_RenderGeometry(renderer, glyph_atlas->texture, glyph_atlas->vertices,
+                     glyph_atlas->vertex_length, glyph_atlas->indices,
+                     quad_count * 6);
+  glyph_atlas->vertex_length = 0;
+}
+
+extern void free_glyph_atlas(Glyph_Atlas *glyph_atlas) {
+  if (!glyph_atlas) {
+    return;
+  }
+  if (glyph_atlas->texture) {
+    SDL_DestroyTexture(glyph_atlas->texture);
+  }
+  free(glyph_atlas->vertices);
+  free(glyph_atlas->indices);
+  free(glyph_atlas);
+}
+
+/*
+ * Grows the vertex buffer for quad_count more quads. Indices are the same two
+ * triangles per quad every frame, so they are only written when growing.
+ */
+static bool reserve_text_quads(Glyph_Atlas *glyph_atlas, size_t quad_count) {
+  size_t vertex_length = glyph_atlas->vertex_length + quad_count * 4;
+  if (vertex_length <= glyph_atlas->vertex_capacity) {
+    return true;
+  }
+
+  size_t capacity = glyph_atlas->vertex_capacity ? glyph_atlas->vertex_capacity
+                                                 : 256;
+  while (capacity < vertex_length) {
+    capacity *= 2;
+  }
+  SDL_Vertex *vertices =
+      realloc(glyph_atlas->vertices, capacity * sizeof(SDL_Vertex));
+  if (!vertices) {
+    return false;
+  }
+  glyph_atlas->vertices = vertices;
+  int *indices = realloc(glyph_atlas->indices, capacity / 4 * 6 * sizeof(int));
+  if (!indices) {
+    return false;
+  }
+  glyph_atlas->indices = indices;
+
+  for (size_t quad = glyph_atlas->index_capacity / 6; quad < capacity / 4;
+       quad++) {
+    int  first = quad * 4;
+    int *index = &indices[quad * 6];
+    index[0] = first;
+    index[1] = first + 1;
+    index[2] = first + 2;
+    index[3] = first;
+    index[4] = first + 2;
+    index[5] = first + 3;
+  }
+  glyph_atlas->vertex_capacity = capacity;
+  glyph_atlas->index_capacity  = capacity / 4 * 6;
+  return true;
+}
+
+// Shelf packing, a new row whenever the current one is full
+static SDL_Texture *create_atlas_texture(SDL_Renderer *renderer, TTF_Font *font,
+                                         Glyph *out_glyphs) {
+  SDL_Surface *glyph_surfaces[GLYPH_COUNT];
+  SDL_Color    white = {255, 255, 255, 255};
+  int          x = 0, y = 0, row_h = 0;
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    Uint32 codepoint = GLYPH_FIRST + i;
+    int    advance   = 0;
+    TTF_GetGlyphMetrics(font, codepoint, NULL, NULL, NULL, NULL, &advance);
+    out_glyphs[i].advance = advance;
+
+    glyph_surfaces[i] = TTF_RenderGlyph_Blended(font, codepoint, white);
+    if (!glyph_surfaces[i]) {
+      continue; // spaces and missing glyphs only advance
+    }
+    int w = glyph_surfaces[i]->w, h = glyph_surfaces[i]->h;
+    if (x + w > GLYPH_ATLAS_W) {
+      x = 0;
+      y += row_h + GLYPH_PADDING;
+      row_h = 0;
+    }
+    out_glyphs[i].src = (SDL_FRect){x, y, w, h};
+    x += w + GLYPH_PADDING;
+    row_h = h > row_h ? h : row_h;
+  }
+
+  SDL_Texture *texture = NULL;
+  SDL_Surface *atlas_surface =
+      SDL_CreateSurface(GLYPH_ATLAS_W, y + row_h, SDL_PIXELFORMAT_RGBA32);
+  if (atlas_surface) {
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+      if (!glyph_surfaces[i]) {
+        continue;
+      }
+      const SDL_FRect *src = &out_glyphs[i].src;
+      SDL_Rect dst = {(int)src->x, (int)src->y, (int)src->w, (int)src->h};
+      // Copy coverage as alpha instead of blending it over transparent black
+      SDL_SetSurfaceBlendMode(glyph_surfaces[i], SDL_BLENDMODE_NONE);
+      SDL_BlitSurface(glyph_surfaces[i], NULL, atlas_surface, &dst);
+    }
+    texture = SDL_CreateTextureFromSurface(renderer, atlas_surface);
+    SDL_DestroySurface(atlas_surface);
+  }
+  if (texture) {
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    SDL_SetTextureScaleMode(texture, SDL_SCALEMODE_NEAREST);
+  }
+
+  for (int i = 0; i < GLYPH_COUNT; i++) {
+    SDL_DestroySurface(glyph_surfaces[i]);
+  }
+  return texture;
+}
@@ -0,0 +1,21 @@
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_render.h>
+#include <SDL3_ttf/SDL_ttf.h>
+
+#include "./constants.h"
+#include "./types.h"
+
+extern Glyph_Atlas *create_glyph_atlas(SDL_Renderer *renderer, const char *font_path, float point_size);
+extern float queue_text(Glyph_Atlas *glyph_atlas, float x, float y, const char *text, SDL_Color color);
+extern float measure_text(const Glyph_Atlas *glyph_atlas, const char *text);
+extern void flush_text(SDL_Renderer *renderer, Glyph_Atlas *glyph_atlas);
+extern void free_glyph_atlas(Glyph_Atlas *glyph_atlas);
+
+#endif
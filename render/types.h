@@ -0,0 +1,252 @@
+#ifndef RENDER_TYPES_H
+#define RENDER_TYPES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <SDL3/SDL_pixels.h>
+#include <SDL3/SDL_render.h>
+
+#include "../assets/sprites/types.h"
+#include "../assets/textures/types.h"
+#include "../data/grid/constants.h"
+#include "../data/grid/types.h"
+#include "../data/spatial/types.h"
+#include "../types/algebraic-types.h"
+#include "../utils/fixed-point.h"
+#include "../utils/math-utils.h"
+#include "./constants.h"
+
+typedef enum Render_Mode {
+  RENDER_MODE_SDL,     // SDL_Renderer strips, the reference path
+  RENDER_MODE_INDEXED, // 8-bit palette framebuffer
+  RENDER_MODE_FIXED,   // 8-bit palette framebuffer, 16.16 traversal
+  RENDER_MODE_COUNT,
+} Render_Mode;
+
+typedef struct Camera {
+  Point_2D position; // eye, the centre of the player
+  Degrees  angle;
+} Camera;
+
+// Distances are perpendicular to the view plane, in world units
+typedef struct Fog {
+  Scalar start_distance;
+  Scalar max_distance; // view distance, rays stop here
+} Fog;
+
+// Everything a frame reads from the world
+typedef struct Render_Scene {
+  const Tile_Map                  *tile_map;
+  const World_Objects_Container   *world_objects_container;
+  const Sprite_Entities_Container *sprite_entities;
+  const Spatial_Hash              *spatial_hash;
+  const Potentially_Visible_Set   *pvs;
+  const Lightmap                  *lightmap; // NULL draws at full brightness
+  Sprite_Draw_List                *sprite_draw_list;
+  Fog                              fog;
+} Render_Scene;
+
+// One wall hit of a column, already projected to the screen
+typedef struct Column_Hit {
+  IPoint_2D    grid;
+  Material_Id  material;
+  Wall_Surface surface;
+  Scalar       perp_distance;
+  Scalar       wall_u;      // 0 to 1 across the face
+  Point_1D     wall_top;    // screen rows
+  Point_1D     wall_bottom;
+} Column_Hit;
+
+/*
+ * Per column output of ray traversal, read by the shading passes. Arrays are
+ * indexed by column, hits are stored near to far MAX_RAY_HITS per column.
+ */
+typedef struct Column_G_Buffer {
+  size_t      length;
+  Vector_1D  *ray_dirs_x;
+  Vector_1D  *ray_dirs_y;
+  Scalar     *inv_cos_thetas; // 1 / cos of the offset from the view angle
+  Scalar     *perp_distances; // nearest opaque wall, INFINITY when none
+  Point_1D   *floor_start_ys; // first floor row
+  uint8_t    *hit_counts;
+  Column_Hit *hits;
+} Column_G_Buffer;
+
+// One wall face a software caster ray crossed, before projection
+typedef struct Indexed_Ray_Hit {
+  Material_Id material;
+  Scalar      distance; // along the ray, in cells
+  Scalar      wall_u;   // 0..1 across the wall face
+  uint8_t     light;    // of the open cell the face looks into
+} Indexed_Ray_Hit;
+
+// Traversal of one absolute ray direction, before projection
+typedef struct Cached_Ray {
+  uint32_t generation; // valid while it matches the cache's
+  uint8_t  hit_count;
+  bool     is_wall_hit; // stopped by an opaque wall or a full stack
+  Ray_Hit  hits[MAX_RAY_HITS];
+} Cached_Ray;
+
+/*
+ * Last frames' traversals keyed by absolute ray angle, so rotating in place
+ * only casts the newly exposed directions. Everything cached belongs to one
+ * eye position and view distance.
+ */
+typedef struct Ray_Cache {
+  Cached_Ray *rays;
+  size_t      length;
+  uint32_t    generation;
+  Point_2D    eye;
+  Scalar      max_ray_length;
+  uint32_t    reused_count; // since the last reset, for profiling
+  uint32_t    cast_count;
+} Ray_Cache;
+
+typedef enum Render_Stage {
+  RENDER_STAGE_TRAVERSAL,
+  RENDER_STAGE_FLOORS,
+  RENDER_STAGE_WALLS,
+  RENDER_STAGE_FOG,
+  RENDER_STAGE_SPRITES,
+  RENDER_STAGE_COUNT,
+} Render_Stage;
+
+// Seconds spent in each stage, summed until reset
+typedef struct Render_Stage_Timings {
+  double   seconds[RENDER_STAGE_COUNT];
+  uint32_t frame_count;
+} Render_Stage_Timings;
+
+/*
+ * The SDL_Renderer view, one textured strip per ray drawn in stages over a
+ * G-buffer. Rays are spread evenly over the FOV, the first strip starts at
+ * rect.x and the last one overhangs the right edge by a strip.
+ */
+typedef struct Strip_View {
+  SDL_Renderer        *renderer;
+  SDL_FRect            rect;
+  float                strip_w;    // rect.w / (ray_count - 1)
+  Degrees              angle_step; // between neighbouring rays
+  Column_G_Buffer     *g_buffer;
+  Ray_Cache           *ray_cache;
+  SDL_FRect           *floor_fog_spans; // ray_count per row, batched for fog
+  int                 *floor_fog_span_counts; // per row
+  Render_Stage_Timings stage_timings;
+} Strip_View;
+
+typedef struct Glyph {
+  SDL_FRect src; // in the atlas
+  float     advance;
+} Glyph;
+
+// Printable ASCII rasterized once, strings are drawn as batched textured quads
+typedef struct Glyph_Atlas {
+  SDL_Texture *texture;
+  Glyph        glyphs[GLYPH_COUNT];
+  float        line_height;
+  SDL_Vertex  *vertices; // quads queued since the last flush
+  size_t       vertex_length;
+  size_t       vertex_capacity;
+  int         *indices;
+  size_t       index_capacity;
+} Glyph_Atlas;
+
+typedef struct Debug_Overlay {
+  Glyph_Atlas *glyph_atlas;
+  float        frame_ms[OVERLAY_GRAPH_SAMPLES]; // ring
+  int          frame_index;
+  char         lines[OVERLAY_MAX_LINES][OVERLAY_LINE_LENGTH];
+  int          line_count;
+  bool         is_visible;
+} Debug_Overlay;
+
+typedef struct Palette {
+  SDL_Color colors[PALETTE_SIZE];
+  int       length;
+  uint8_t   rgb555_to_index[RGB555_SIZE]; // nearest colour lookup
+} Palette;
+
+#define TEXTURE_SIZE_CLASS_ENTRY(size) TEXTURE_SIZE_CLASS_##size,
+typedef enum Texture_Size_Class {
+  TEXTURE_KERNEL_SIZES(TEXTURE_SIZE_CLASS_ENTRY)
+  TEXTURE_SIZE_CLASS_GENERIC,
+  TEXTURE_SIZE_CLASS_COUNT,
+} Texture_Size_Class;
+#undef TEXTURE_SIZE_CLASS_ENTRY
+
+// Shades length texels of a wall column into dst, stepping down the screen
+typedef void (*Wall_Column_Kernel)(uint8_t *dst, int dst_pitch, int length,
+                                   const uint8_t *column, int texture_h,
+                                   Fixed texture_pos, Fixed step,
+                                   const uint8_t *colormap);
+
+typedef struct Indexed_Texture {
+  int                w;
+  int                h;
+  uint8_t           *texels;  // row major, for floor spans and sprites
+  uint8_t           *columns; // column major copy, a wall column is one sequential read
+  bool               is_keyed; // has transparent texels
+  Texture_Size_Class size_class;
+  Wall_Column_Kernel draw_wall_column;
+} Indexed_Texture;
+
+// Fixed point caster lookups, they only depend on the framebuffer size
+typedef struct Fixed_Caster_Tables {
+  Fixed_Angle *column_angles;  // offset of each column from the view angle
+  Fixed       *column_cos;     // cos of that offset
+  Fixed       *column_inv_cos; // 1 / cos of that offset
+  Fixed       *row_distances;  // floor distance in cells, 0 above the horizon
+} Fixed_Caster_Tables;
+
+typedef struct Fixed_Ray_Hit {
+  Material_Id material;
+  Fixed       distance; // along the ray, in cells
+  Fixed       wall_u;   // 0..1 across the wall face
+  uint8_t     light;
+} Fixed_Ray_Hit;
+
+// Per frame inputs, converted from the float camera and fog exactly once
+typedef struct Fixed_View {
+  Fixed_Angle angle;
+  Fixed       eye_x; // in cells
+  Fixed       eye_y;
+  Fixed       fog_start; // in cells
+  Fixed       fog_max;
+} Fixed_View;
+
+typedef struct Indexed_Renderer {
+  int              w;
+  int              h;
+  uint8_t         *framebuffer;
+  Scalar          *z_buffer; // per column
+  Palette         *palette;
+  uint8_t         *colormaps; // COLORMAP_LEVELS * PALETTE_SIZE
+  uint8_t          background_index;
+  Indexed_Texture *textures; // every frame of every material
+  size_t           texture_count;
+  size_t          *frame_offsets; // first texture of each material
+  size_t           material_count;
+  bool             use_fixed_point; // walls and floors via the 16.16 caster
+  Fixed_Caster_Tables fixed_tables;
+} Indexed_Renderer;
+
+/*
+ * The tile map drawn once into a target texture at MINIMAP_CELL_PX per cell.
+ * Changed cells are queued and redrawn on the next update, never the whole map.
+ * A white strip below the map lets the player marker share the draw call.
+ */
+typedef struct Minimap {
+  SDL_Texture    *texture;
+  const Tile_Map *tile_map;
+  int             cell_px;
+  size_t         *dirty_cells;
+  size_t          dirty_length;
+  SDL_FRect      *rects; // per dirty cell, grouped by colour before drawing
+  uint8_t        *is_dirty; // per cell
+  float           zoom;     // cells across the view
+  bool            is_visible;
+} Minimap;
+
+#endif
@@ -0,0 +1,201 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "../assets/textures/animation.h"
+#include "../engine/engine.h"
+#include "../utils/worker-pool.h"
+#include "./camera-path.h"
+#include "./constants.h"
+#include "./frame-queue.h"
+#include "./frame-writer.h"
+#include "./types.h"
+
+/*
+ * Renders a camera path headlessly and writes it as PNG frames or one Y4M
+ * stream. Every worker drives its own engine, so a batch of frames renders in
+ * parallel while the writer thread encodes the previous batch.
+ *
+ *   ./tools/batch-render --path flythrough.txt [--out dir or file]
+ *                        [--format png|y4m] [--width n] [--height n]
+ *                        [--fps n] [--level dir] [--manifest file]
+ *                        [--threads n] [--fixed]
+ */
+
+typedef struct Batch_Options {
+  Engine_Config engine_config;
+  const char   *camera_path_file;
+  const char   *out_path;
+  Frame_Format  format;
+  int           fps;
+  size_t        thread_count;
+} Batch_Options;
+
+typedef struct Batch_Render_Job {
+  Engine_Context   **engines; // one per job index
+  Frame_Slot       **slots;
+  const Camera_Path *camera_path;
+  int                fps;
+} Batch_Render_Job;
+
+static bool parse_batch_options(int argc, char **argv,
+                                Batch_Options *out_options);
+static void render_frame_job(void *context, size_t index);
+
+int main(int argc, char **argv) {
+  Batch_Options options;
+  if (!parse_batch_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+
+  Camera_Path *camera_path = read_camera_path_file(options.camera_path_file);
+  Worker_Pool *pool        = create_worker_pool(options.thread_count);
+  if (!camera_path || !pool) {
+    free_camera_path(camera_path);
+    free_worker_pool(pool);
+    return EXIT_FAILURE;
+  }
+
+  // The calling thread renders too, so there is one engine more than threads
+  size_t           engine_count = pool->thread_count + 1;
+  Engine_Context **engines = calloc(engine_count, sizeof(Engine_Context *));
+  Frame_Slot     **slots   = calloc(engine_count, sizeof(Frame_Slot *));
+  bool             is_ok   = engines && slots;
+  for (size_t i = 0; is_ok && i < engine_count; i++) {
+    engines[i] = create_engine(&options.engine_config);
+    is_ok      = engines[i] != NULL;
+  }
+
+  Frame_Queue *queue =
+      is_ok ? create_frame_queue(engine_count * BATCH_QUEUE_SLOTS_PER_ENGINE,
+                                 options.engine_config.view_w,
+                                 options.engine_config.view_h)
+            : NULL;
+  Frame_Writer *writer =
+      queue ? start_frame_writer(queue, options.format, options.out_path,
+                                 options.fps)
+            : NULL;
+  is_ok = writer != NULL;
+
+  Batch_Render_Job job = {
+      .engines     = engines,
+      .slots       = slots,
+      .camera_path = camera_path,
+      .fps         = options.fps,
+  };
+  double start_seconds = SDL_GetTicksNS() / 1e9;
+  for (size_t first_frame = 0;
+       is_ok && first_frame < camera_path->frame_count;
+       first_frame += engine_count) {
+    size_t batch_length = camera_path->frame_count - first_frame;
+    batch_length = batch_length < engine_count ? batch_length : engine_count;
+    for (size_t i = 0; i < batch_length; i++) {
+      slots[i]              = acquire_frame_slot(queue);
+      slots[i]->frame_index = first_frame + i;
+    }
+    run_worker_pool(pool, render_frame_job, &job, batch_length);
+    for (size_t i = 0; i < batch_length; i++) {
+      submit_frame_slot(queue);
+    }
+  }
+
+  if (writer) {
+    close_frame_queue(queue);
+    size_t written_count;
+    is_ok          = finish_frame_writer(writer, &written_count) && is_ok;
+    double seconds = SDL_GetTicksNS() / 1e9 - start_seconds;
+    printf("%zu of %zu frames at %dx%d on %zu engines in %.2f s, %.1f fps\n",
+           written_count, camera_path->frame_count,
+           options.engine_config.view_w, options.engine_config.view_h,
+           engine_count, seconds, seconds > 0 ? written_count / seconds : 0);
+  }
+
+  free_frame_queue(queue);
+  for (size_t i = 0; engines && i < engine_count; i++) {
+    free_engine(engines[i]);
+  }
+  free(slots);
+  free(engines);
+  free_worker_pool(pool);
+  free_camera_path(camera_path);
+  SDL_Quit();
+  return is_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool parse_batch_options(int argc, char **argv,
+                                Batch_Options *out_options) {
+  *out_options = (Batch_Options){
+      .engine_config = get_default_engine_config(),
+      .out_path      = BATCH_OUT_PATH_DEFAULT,
+      .format        = FRAME_FORMAT_PNG,
+      .fps           = BATCH_FPS_DEFAULT,
+      .thread_count  = get_default_worker_count(),
+  };
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--fixed") == 0) {
+      out_options->engine_config.use_fixed_point = true;
+      continue;
+    }
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return false;
+    }
+    if (strcmp(argv[i], "--path") == 0) {
+      out_options->camera_path_file = value;
+    } else if (strcmp(argv[i], "--out") == 0) {
+      out_options->out_path = value;
+    } else if (strcmp(argv[i], "--format") == 0) {
+      out_options->format =
+          strcmp(value, "y4m") == 0 ? FRAME_FORMAT_Y4M : FRAME_FORMAT_PNG;
+    } else if (strcmp(argv[i], "--width") == 0) {
+      out_options->engine_config.view_w = atoi(value);
+    } else if (strcmp(argv[i], "--height") == 0) {
+      out_options->engine_config.view_h = atoi(value);
+    } else if (strcmp(argv[i], "--fps") == 0) {
+      out_options->fps = atoi(value);
+    } else if (strcmp(argv[i], "--level") == 0) {
+      out_options->engine_config.level_directory = value;
+    } else if (strcmp(argv[i], "--manifest") == 0) {
+      out_options->engine_config.manifest_path = value;
+    } else if (strcmp(argv[i], "--threads") == 0) {
+      out_options->thread_count = strtoull(value, NULL, 10);
+    } else {
+      fprintf(stderr,
+              "Usage: %s --path file [--out dir or file] [--format png|y4m] "
+              "[--width n] [--height n] [--fps n] [--level dir] "
+              "[--manifest file] [--threads n] [--fixed]\n",
+              argv[0]);
+      return false;
+    }
+    i++;
+  }
+
+  if (!out_options->camera_path_file) {
+    fprintf(stderr, "A camera path is required, see --path\n");
+    return false;
+  }
+  return out_options->engine_config.view_w > 0 &&
+         out_options->engine_config.view_h > 0 && out_options->fps > 0;
+}
+
+/*
+ * Index i of a batch always renders with engine i, which is therefore only
+ * ever used by one thread at a time. Animations are set from the frame's
+ * absolute time, so the result does not depend on which engine drew it.
+ */
+static void render_frame_job(void *context, size_t index) {
+  Batch_Render_Job *job    = context;
+  Engine_Context   *engine = job->engines[index];
+  Frame_Slot       *slot   = job->slots[index];
+
+  set_engine_camera(engine,
+                    get_camera_path_frame(job->camera_path, slot->frame_index));
+  double frame_time = (double)slot->frame_index / job->fps;
+  advance_animation_clocks(engine->animation_clocks,
+                           frame_time - engine->animation_clocks->elapsed_time);
+  slot->is_rendered = render_engine_frame(engine, &slot->framebuffer);
+}
@@ -0,0 +1,133 @@
+#include "./camera-path.h"
+
+static bool add_camera_keyframe(Camera_Path    *camera_path,
+                                size_t         *capacity,
+                                Camera_Keyframe keyframe);
+
+/*
+ * One keyframe per line, blank lines and lines starting with # are skipped:
+ *
+ *   x y angle [frames]
+ *
+ * x and y are in cells (so 1.5 is the middle of the second cell), angle is in
+ * degrees and frames, 1 by default, is how long the camera takes to reach the
+ * next keyframe. The last keyframe is held for its frames.
+ */
+extern Camera_Path *read_camera_path_file(const char *path) {
+  FILE *file = fopen(path, "r");
+  if (!file) {
+    fprintf(stderr, "Could not open file %s\n", path);
+    return NULL;
+  }
+
+  Camera_Path *camera_path = calloc(1, sizeof(Camera_Path));
+  if (!camera_path) {
+    fclose(file);
+    return NULL;
+  }
+
+  char   line[CAMERA_PATH_MAX_LINE];
+  size_t capacity    = 0;
+  size_t line_number = 0;
+  while (fgets(line, sizeof(line), file)) {
+    line_number++;
+    char *start = line + strspn(line, " \t\r\n");
+    if (*start == '\0' || *start == '#') {
+      continue;
+    }
+
+    float  x, y, angle;
+    size_t frame_count = 1;
+    int    field_count =
+        sscanf(start, "%f %f %f %zu", &x, &y, &angle, &frame_count);
+    if (field_count < 3 || frame_count == 0) {
+      fprintf(stderr, "%s:%zu: expected x y angle [frames]\n", path,
+              line_number);
+      free_camera_path(camera_path);
+      fclose(file);
+      return NULL;
+    }
+
+    Camera_Keyframe keyframe = {
+        .camera =
+            {
+                .position = {.x = x * GRID_CELL_SIZE, .y = y * GRID_CELL_SIZE},
+                .angle    = angle,
+            },
+        .frame_count = frame_count,
+    };
+    if (!add_camera_keyframe(camera_path, &capacity, keyframe)) {
+      free_camera_path(camera_path);
+      fclose(file);
+      return NULL;
+    }
+  }
+  fclose(file);
+
+  if (camera_path->length == 0) {
+    fprintf(stderr, "%s has no keyframes\n", path);
+    free_camera_path(camera_path);
+    return NULL;
+  }
+  return camera_path;
+}
+
+// Position is linear between keyframes, angle turns the short way round
+extern Camera get_camera_path_frame(const Camera_Path *camera_path,
+                                    size_t             frame_index) {
+  size_t i = 0;
+  while (i + 1 < camera_path->length &&
+         frame_index >= camera_path->keyframes[i].frame_count) {
+    frame_index -= camera_path->keyframes[i].frame_count;
+    i++;
+  }
+
+  const Camera_Keyframe *from = &camera_path->keyframes[i];
+  if (i + 1 == camera_path->length) {
+    return from->camera;
+  }
+
+  const Camera_Keyframe *to = &camera_path->keyframes[i + 1];
+  float t          = (float)frame_index / from->frame_count;
+  float angle_step = fmodf(to->camera.angle - from->camera.angle, 360.0f);
+  angle_step       = angle_step > 180.0f    ? angle_step - 360.0f
+                     : angle_step < -180.0f ? angle_step + 360.0f
+                                            : angle_step;
+  float angle      = fmodf(from->camera.angle + angle_step * t, 360.0f);
+  return (Camera){
+      .position =
+          {
+              .x = from->camera.position.x +
+                   (to->camera.position.x - from->camera.position.x) * t,
+              .y = from->camera.position.y +
+                   (to->camera.position.y - from->camera.position.y) * t,
+          },
+      .angle = angle < 0 ? angle + 360.0f : angle,
+  };
+}
+
+extern void free_camera_path(Camera_Path *camera_path) {
+  if (!camera_path) {
+    return;
+  }
+  free(camera_path->keyframes);
+  free(camera_path);
+}
+
+static bool add_camera_keyframe(Camera_Path    *camera_path,
+                                size_t         *capacity,
+                                Camera_Keyframe keyframe) {
+  if (camera_path->length == *capacity) {
+    size_t           new_capacity = *capacity ? *capacity * 2 : 16;
+    Camera_Keyframe *keyframes    = realloc(
+        camera_path->keyframes, new_capacity * sizeof(Camera_Keyframe));
+    if (!keyframes) {
+      return false;
+    }
+    camera_path->keyframes = keyframes;
+    *capacity              = new_capacity;
+  }
+  camera_path->keyframes[camera_path->length++] = keyframe;
+  camera_path->frame_count += keyframe.frame_count;
+  return true;
+}
@@ -0,0 +1,18 @@
+#ifndef CAMERA_PATH_H
+#define CAMERA_PATH_H
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../data/grid/constants.h"
+#include "./constants.h"
+#include "./types.h"
+
+extern Camera_Path *read_camera_path_file(const char *path);
+extern Camera get_camera_path_frame(const Camera_Path *camera_path, size_t frame_index);
+extern void free_camera_path(Camera_Path *camera_path);
+
+#endif
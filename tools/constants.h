@@ -0,0 +1,24 @@
+#ifndef TOOLS_CONSTANTS_H
+#define TOOLS_CONSTANTS_H
+
+#include "../render/constants.h"
+
+// Queued frames per engine, one batch being encoded while the next renders
+#define BATCH_QUEUE_SLOTS_PER_ENGINE 2
+#define BATCH_FPS_DEFAULT 30
+#define BATCH_OUT_PATH_DEFAULT "./frames"
+
+#define CAMERA_PATH_MAX_LINE 256
+
+#define GOLDEN_DIRECTORY_DEFAULT "./tools/goldens"
+#define GOLDEN_DIFF_DIRECTORY_DEFAULT "./golden-diff"
+
+// Greyed reference under the red pixels that failed, in a diff image
+#define FRAME_DIFF_BACKGROUND_SHIFT 2
+
+// The fixed path held to the float one, derived with GOLDEN_RENDER_PATHS
+#define FIXED_PATH_CHANNEL_TOLERANCE (2 * 255 / (COLORMAP_LEVELS - 1))
+#define FIXED_PATH_MATCH_RADIUS 1
+#define FIXED_PATH_MAX_FAILED_FRACTION 0.01
+
+#endif
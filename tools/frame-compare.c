@@ -0,0 +1,76 @@
+#include "./frame-compare.h"
+
+#include "./constants.h"
+
+static int get_pixel_difference(const uint8_t *pixel, const uint8_t *other);
+
+/*
+ * A pixel passes when a reference pixel within match_radius is no further than
+ * channel_tolerance on any channel. Both frames must be the same size. Without
+ * diff_pixels only the counts are taken, otherwise diff pixels are red where a
+ * pixel failed and the darkened reference elsewhere, laid out like the
+ * framebuffer. max_channel_difference is against the pixel itself.
+ */
+extern Frame_Comparison compare_framebuffers(
+    const Engine_Framebuffer *framebuffer,
+    const Engine_Framebuffer *reference, int channel_tolerance,
+    int match_radius, uint8_t *diff_pixels) {
+  Frame_Comparison comparison = {0};
+  for (int y = 0; y < framebuffer->h; y++) {
+    const uint8_t *frame_row =
+        (const uint8_t *)framebuffer->pixels + (size_t)y * framebuffer->pitch;
+    const uint8_t *reference_row =
+        (const uint8_t *)reference->pixels + (size_t)y * reference->pitch;
+    for (int x = 0; x < framebuffer->w; x++) {
+      const uint8_t *pixel = frame_row + (size_t)x * 4;
+      int pixel_difference = get_pixel_difference(pixel, reference_row + x * 4);
+      if (pixel_difference > comparison.max_channel_difference) {
+        comparison.max_channel_difference = pixel_difference;
+      }
+
+      bool is_failed = pixel_difference > channel_tolerance;
+      for (int ny = y - match_radius; is_failed && ny <= y + match_radius;
+           ny++) {
+        for (int nx = x - match_radius; is_failed && nx <= x + match_radius;
+             nx++) {
+          if (ny < 0 || nx < 0 || ny >= reference->h || nx >= reference->w) {
+            continue;
+          }
+          const uint8_t *neighbour = (const uint8_t *)reference->pixels +
+                                     (size_t)ny * reference->pitch +
+                                     (size_t)nx * 4;
+          is_failed =
+              get_pixel_difference(pixel, neighbour) > channel_tolerance;
+        }
+      }
+      comparison.failed_pixel_count += is_failed;
+      if (!diff_pixels) {
+        continue;
+      }
+
+      uint8_t *diff_pixel =
+          diff_pixels + (size_t)y * framebuffer->pitch + (size_t)x * 4;
+      for (int c = 0; c < 3; c++) {
+        diff_pixel[c] = reference_row[x * 4 + c] >> FRAME_DIFF_BACKGROUND_SHIFT;
+      }
+      if (is_failed) {
+        diff_pixel[0] = 255;
+        diff_pixel[1] = 0;
+        diff_pixel[2] = 0;
+      }
+      diff_pixel[3] = 255;
+    }
+  }
+  return comparison;
+}
+
+// Largest difference over the four channels
+static int get_pixel_difference(const uint8_t *pixel, const uint8_t *other) {
+  int pixel_difference = 0;
+  for (int c = 0; c < 4; c++) {
+    int difference = abs(pixel[c] - other[c]);
+    pixel_difference =
+        difference > pixel_difference ? difference : pixel_difference;
+  }
+  return pixel_difference;
+}
@@ -0,0 +1,15 @@
+#ifndef FRAME_COMPARE_H
+#define FRAME_COMPARE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "./types.h"
+
+extern Frame_Comparison compare_framebuffers(
+    const Engine_Framebuffer *framebuffer,
+    const Engine_Framebuffer *reference, int channel_tolerance,
+    int match_radius, uint8_t *diff_pixels);
+
+#endif
@@ -0,0 +1,105 @@
+#include "./frame-queue.h"
+
+// Every slot owns a w by h RGBA32 framebuffer for the whole run
+extern Frame_Queue *create_frame_queue(size_t capacity, int w, int h) {
+  Frame_Queue *queue = calloc(1, sizeof(Frame_Queue));
+  if (!queue) {
+    return NULL;
+  }
+
+  queue->capacity   = capacity;
+  queue->slots      = calloc(capacity, sizeof(Frame_Slot));
+  queue->mutex      = SDL_CreateMutex();
+  queue->slot_free  = SDL_CreateCondition();
+  queue->slot_ready = SDL_CreateCondition();
+  if (!queue->slots || !queue->mutex || !queue->slot_free ||
+      !queue->slot_ready) {
+    free_frame_queue(queue);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < capacity; i++) {
+    queue->slots[i].framebuffer = (Engine_Framebuffer){
+        .pixels = malloc((size_t)w * h * sizeof(uint32_t)),
+        .w      = w,
+        .h      = h,
+        .pitch  = w * (int)sizeof(uint32_t),
+    };
+    if (!queue->slots[i].framebuffer.pixels) {
+      free_frame_queue(queue);
+      return NULL;
+    }
+  }
+  return queue;
+}
+
+// Producer side, blocks while every slot is still waiting on the writer
+extern Frame_Slot *acquire_frame_slot(Frame_Queue *queue) {
+  SDL_LockMutex(queue->mutex);
+  while (queue->acquired_count - queue->released_count == queue->capacity) {
+    SDL_WaitCondition(queue->slot_free, queue->mutex);
+  }
+  Frame_Slot *slot = &queue->slots[queue->acquired_count % queue->capacity];
+  queue->acquired_count++;
+  SDL_UnlockMutex(queue->mutex);
+  return slot;
+}
+
+// Hands the oldest acquired slot to the writer
+extern void submit_frame_slot(Frame_Queue *queue) {
+  SDL_LockMutex(queue->mutex);
+  queue->submitted_count++;
+  SDL_SignalCondition(queue->slot_ready);
+  SDL_UnlockMutex(queue->mutex);
+}
+
+// Writer side, NULL once the queue is closed and drained
+extern Frame_Slot *take_frame_slot(Frame_Queue *queue) {
+  SDL_LockMutex(queue->mutex);
+  while (queue->taken_count == queue->submitted_count && !queue->is_closed) {
+    SDL_WaitCondition(queue->slot_ready, queue->mutex);
+  }
+  Frame_Slot *slot = NULL;
+  if (queue->taken_count < queue->submitted_count) {
+    slot = &queue->slots[queue->taken_count % queue->capacity];
+    queue->taken_count++;
+  }
+  SDL_UnlockMutex(queue->mutex);
+  return slot;
+}
+
+// Returns the oldest taken slot to the producer
+extern void release_frame_slot(Frame_Queue *queue) {
+  SDL_LockMutex(queue->mutex);
+  queue->released_count++;
+  SDL_SignalCondition(queue->slot_free);
+  SDL_UnlockMutex(queue->mutex);
+}
+
+// No more frames will be submitted
+extern void close_frame_queue(Frame_Queue *queue) {
+  SDL_LockMutex(queue->mutex);
+  queue->is_closed = true;
+  SDL_BroadcastCondition(queue->slot_ready);
+  SDL_UnlockMutex(queue->mutex);
+}
+
+extern void free_frame_queue(Frame_Queue *queue) {
+  if (!queue) {
+    return;
+  }
+  for (size_t i = 0; queue->slots && i < queue->capacity; i++) {
+    free(queue->slots[i].framebuffer.pixels);
+  }
+  if (queue->slot_ready) {
+    SDL_DestroyCondition(queue->slot_ready);
+  }
+  if (queue->slot_free) {
+    SDL_DestroyCondition(queue->slot_free);
+  }
+  if (queue->mutex) {
+    SDL_DestroyMutex(queue->mutex);
+  }
+  free(queue->slots);
+  free(queue);
+}
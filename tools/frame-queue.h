@@ -0,0 +1,19 @@
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL.h>
+
+#include "./types.h"
+
+extern Frame_Queue *create_frame_queue(size_t capacity, int w, int h);
+extern Frame_Slot *acquire_frame_slot(Frame_Queue *queue);
+extern void submit_frame_slot(Frame_Queue *queue);
+extern Frame_Slot *take_frame_slot(Frame_Queue *queue);
+extern void release_frame_slot(Frame_Queue *queue);
+extern void close_frame_queue(Frame_Queue *queue);
+extern void free_frame_queue(Frame_Queue *queue);
+
+#endif
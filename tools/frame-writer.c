@@ -0,0 +1,174 @@
+#include "./frame-writer.h"
+
+static int  run_frame_writer(void *data);
+static bool write_png_frame(Frame_Writer *writer, const Frame_Slot *slot);
+static bool write_y4m_frame(Frame_Writer *writer, const Frame_Slot *slot);
+static void convert_rgba_to_yuv420(const Engine_Framebuffer *framebuffer,
+                                   uint8_t                  *yuv_planes);
+
+/*
+ * Encodes frames on its own thread as they come off the queue, so disk and
+ * encoding time overlap rendering. The Y4M stream is opened up front, PNGs go
+ * into out_path/frame_000000.png and on, the directory must exist.
+ */
+extern Frame_Writer *start_frame_writer(Frame_Queue *queue,
+                                        Frame_Format format,
+                                        const char *out_path, int fps) {
+  Frame_Writer *writer = calloc(1, sizeof(Frame_Writer));
+  if (!writer) {
+    return NULL;
+  }
+  writer->queue    = queue;
+  writer->format   = format;
+  writer->out_path = out_path;
+  writer->fps      = fps;
+  writer->is_ok    = true;
+
+  if (format == FRAME_FORMAT_Y4M) {
+    const Engine_Framebuffer *framebuffer = &queue->slots[0].framebuffer;
+    size_t chroma_size = (size_t)((framebuffer->w + 1) / 2) *
+                         ((framebuffer->h + 1) / 2);
+    writer->yuv_planes =
+        malloc((size_t)framebuffer->w * framebuffer->h + chroma_size * 2);
+    writer->y4m_file = fopen(out_path, "wb");
+    if (!writer->yuv_planes || !writer->y4m_file) {
+      fprintf(stderr, "Could not open %s\n", out_path);
+      finish_frame_writer(writer, NULL);
+      return NULL;
+    }
+    fprintf(writer->y4m_file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+            framebuffer->w, framebuffer->h, fps);
+  }
+
+  writer->thread = SDL_CreateThread(run_frame_writer, "frame writer", writer);
+  if (!writer->thread) {
+    fprintf(stderr, "Failed to start the frame writer: %s\n", SDL_GetError());
+    finish_frame_writer(writer, NULL);
+    return NULL;
+  }
+  return writer;
+}
+
+/*
+ * Waits for the closed queue to drain, true when every frame was written.
+ * out_written_count may be NULL.
+ */
+extern bool finish_frame_writer(Frame_Writer *writer,
+                                size_t       *out_written_count) {
+  if (!writer) {
+    return false;
+  }
+  if (writer->thread) {
+    SDL_WaitThread(writer->thread, NULL);
+  }
+  if (out_written_count) {
+    *out_written_count = writer->written_count;
+  }
+  if (writer->y4m_file && fclose(writer->y4m_file) != 0) {
+    writer->is_ok = false;
+  }
+  bool is_ok = writer->is_ok;
+  free(writer->yuv_planes);
+  free(writer);
+  return is_ok;
+}
+
+// Keeps draining after a failed write so the renderer never blocks forever
+static int run_frame_writer(void *data) {
+  Frame_Writer *writer = data;
+  Frame_Slot   *slot;
+  while ((slot = take_frame_slot(writer->queue))) {
+    if (writer->is_ok && slot->is_rendered) {
+      writer->is_ok = writer->format == FRAME_FORMAT_PNG
+                          ? write_png_frame(writer, slot)
+                          : write_y4m_frame(writer, slot);
+      writer->written_count += writer->is_ok;
+    }
+    release_frame_slot(writer->queue);
+  }
+  return 0;
+}
+
+static bool write_png_frame(Frame_Writer *writer, const Frame_Slot *slot) {
+  char path[MAX_PATH_LENGTH];
+  snprintf(path, sizeof(path), "%s/frame_%06zu.png", writer->out_path,
+           slot->frame_index);
+
+  const Engine_Framebuffer *framebuffer = &slot->framebuffer;
+  SDL_Surface *surface = SDL_CreateSurfaceFrom(
+      framebuffer->w, framebuffer->h, SDL_PIXELFORMAT_RGBA32,
+      framebuffer->pixels, framebuffer->pitch);
+  bool is_ok = surface && IMG_SavePNG(surface, path);
+  if (!is_ok) {
+    fprintf(stderr, "Failed to write %s: %s\n", path, SDL_GetError());
+  }
+  if (surface) {
+    SDL_DestroySurface(surface);
+  }
+  return is_ok;
+}
+
+static bool write_y4m_frame(Frame_Writer *writer, const Frame_Slot *slot) {
+  const Engine_Framebuffer *framebuffer = &slot->framebuffer;
+  size_t chroma_size = (size_t)((framebuffer->w + 1) / 2) *
+                       ((framebuffer->h + 1) / 2);
+  size_t frame_size  = (size_t)framebuffer->w * framebuffer->h +
+                       chroma_size * 2;
+
+  convert_rgba_to_yuv420(framebuffer, writer->yuv_planes);
+  bool is_ok = fputs("FRAME\n", writer->y4m_file) >= 0 &&
+               fwrite(writer->yuv_planes, 1, frame_size, writer->y4m_file) ==
+                   frame_size;
+  if (!is_ok) {
+    fprintf(stderr, "Failed to write frame %zu to %s\n", slot->frame_index,
+            writer->out_path);
+  }
+  return is_ok;
+}
+
+/*
+ * BT.601 studio range. Chroma is taken from the average of each 2x2 block,
+ * edge blocks of odd sizes average what they have.
+ */
+static void convert_rgba_to_yuv420(const Engine_Framebuffer *framebuffer,
+                                   uint8_t                  *yuv_planes) {
+  int      w        = framebuffer->w;
+  int      h        = framebuffer->h;
+  int      chroma_w = (w + 1) / 2;
+  int      chroma_h = (h + 1) / 2;
+  uint8_t *y_plane  = yuv_planes;
+  uint8_t *u_plane  = y_plane + (size_t)w * h;
+  uint8_t *v_plane  = u_plane + (size_t)chroma_w * chroma_h;
+
+  for (int y = 0; y < h; y++) {
+    const uint8_t *row =
+        (const uint8_t *)framebuffer->pixels + (size_t)y * framebuffer->pitch;
+    for (int x = 0; x < w; x++) {
+      const uint8_t *rgba = &row[x * 4];
+      y_plane[(size_t)y * w + x] =
+          ((66 * rgba[0] + 129 * rgba[1] + 25 * rgba[2] + 128) >> 8) + 16;
+    }
+  }
+
+  for (int chroma_y = 0; chroma_y < chroma_h; chroma_y++) {
+    for (int chroma_x = 0; chroma_x < chroma_w; chroma_x++) {
+      int r = 0, g = 0, b = 0, count = 0;
+      for (int y = chroma_y * 2; y < chroma_y * 2 + 2 && y < h; y++) {
+        const uint8_t *row = (const uint8_t *)framebuffer->pixels +
+                             (size_t)y * framebuffer->pitch;
+        for (int x = chroma_x * 2; x < chroma_x * 2 + 2 && x < w; x++) {
+          r += row[x * 4];
+          g += row[x * 4 + 1];
+          b += row[x * 4 + 2];
+          count++;
+        }
+      }
+      r /= count;
+      g /= count;
+      b /= count;
+      size_t i   = (size_t)chroma_y * chroma_w + chroma_x;
+      u_plane[i] = ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+      v_plane[i] = ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+    }
+  }
+}
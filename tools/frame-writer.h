@@ -0,0 +1,18 @@
+#ifndef FRAME_WRITER_H
+#define FRAME_WRITER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include "../assets/textures/constants.h"
+#include "./frame-queue.h"
+#include "./types.h"
+
+extern Frame_Writer *start_frame_writer(Frame_Queue *queue, Frame_Format format, const char *out_path, int fps);
+extern bool finish_frame_writer(Frame_Writer *writer, size_t *out_written_count);
+
+#endif
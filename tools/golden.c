@@ -0,0 +1,414 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3_image/SDL_image.h>
+
+#include "../assets/textures/constants.h"
+#include "../assets/textures/setup.h"
+#include "../data/grid/constants.h"
+#include "../data/procgen/procgen.h"
+#include "../engine/engine.h"
+#include "../objects/player/constants.h"
+#include "../render/strip-view.h"
+#include "./constants.h"
+#include "./frame-compare.h"
+#include "./types.h"
+
+/*
+ * Renders a fixed set of camera poses on every level, at several resolutions,
+ * through each render path and compares the frames against stored golden PNGs.
+ * The float indexed path and the SDL front end's strip view are references
+ * with goldens of their own, the strips drawn by SDL's software renderer into
+ * a surface so no window or GPU is involved. The fixed path is held to the
+ * indexed goldens. Failing frames leave a diff image with the failed pixels
+ * in red.
+ *
+ *   ./tools/golden [--update] [--goldens dir] [--diffs dir] [--manifest file]
+ *
+ * Exits non-zero when any frame fails or its golden is missing.
+ */
+
+static const Golden_Level GOLDEN_LEVELS[] = {
+    {"1", "./assets/levels/1", "level-1-walls.csv", "level-1-floors.csv"},
+    {"2", "./assets/levels/2", "walls.csv", "floors.csv"},
+    {"3", "./assets/levels/3", "w.csv", "f.csv"}, // pose 0 sees through grate-a
+    {"4", "./assets/levels/4", "w.csv", "f.csv"},
+};
+
+/*
+ * Tolerances follow from how far each path can drift from its goldens, not
+ * from what was last measured.
+ *
+ * Between compilers and -march targets only float rounding changes. It can
+ * move an edge, a fog band or a texel boundary by a pixel but never makes a
+ * colour, so the references match exactly within a radius of one. Where texels
+ * are narrower than a pixel a rounding flip picks a texel no neighbour shows,
+ * one pixel in a thousand covers those.
+ *
+ * The fixed path turns in 1/16384ths of a turn and walks 16.16 cells. Its rays
+ * are within two angle steps of the float ones, under a column at any width
+ * below 1365 pixels, so where texels are at least a pixel wide each fixed
+ * pixel matches a float one within a radius of one. Its fog and light can
+ * round a colormap level apart, FIXED_PATH_CHANNEL_TOLERANCE allows one level
+ * plus as much again for the palette's nearest colour. Far walls and walls
+ * seen nearly edge on have texels narrower than a pixel, there the fixed ray
+ * can land on a texel neither float neighbour shows and no radius bounds it,
+ * so one pixel in a hundred is left for them.
+ *
+ * SDL's software renderer snaps float rects to whole pixels and its blitters
+ * round colour and alpha mods one apart from each other, so the strips also
+ * allow a channel step.
+ */
+static const Golden_Render_Path GOLDEN_RENDER_PATHS[] = {
+    {"indexed", "indexed", GOLDEN_RENDERER_INDEXED, 0, 1, 0.001},
+    {"fixed", "indexed", GOLDEN_RENDERER_FIXED, FIXED_PATH_CHANNEL_TOLERANCE,
+     FIXED_PATH_MATCH_RADIUS, FIXED_PATH_MAX_FAILED_FRACTION},
+    {"strips", "strips", GOLDEN_RENDERER_STRIPS, 1, 1, 0.001},
+};
+
+static const Golden_Resolution GOLDEN_RESOLUTIONS[] = {
+    {320, 200},
+    {800, 800},
+    {1280, 720},
+};
+
+// Off the axes, so edges and floor rows land between texels
+static const Degrees GOLDEN_POSE_ANGLES[] = {20.0f, 75.0f, 160.0f, 250.0f};
+
+#define ARRAY_LENGTH(array) (sizeof(array) / sizeof((array)[0]))
+
+typedef struct Golden_Options {
+  Engine_Config engine_config;
+  const char   *golden_directory;
+  const char   *diff_directory;
+  bool          is_updating;
+} Golden_Options;
+
+static bool parse_golden_options(int argc, char **argv,
+                                 Golden_Options *out_options);
+static bool is_reference_path(const Golden_Render_Path *render_path);
+static size_t get_path_frame_count(bool is_updating);
+static size_t run_golden_level(const Golden_Options *options,
+                               const Golden_Level   *level,
+                               Golden_Resolution     resolution);
+static bool create_golden_scene(const Engine_Config *config,
+                                Golden_Scene        *out_scene);
+static Engine_Framebuffer render_golden_frame(
+    Golden_Scene *scene, const Golden_Render_Path *render_path);
+static void free_golden_scene(Golden_Scene *scene);
+static SDL_Surface *read_golden_image(const char *path, int w, int h);
+static bool write_framebuffer_png(const Engine_Framebuffer *framebuffer,
+                                  const char               *path);
+
+int main(int argc, char **argv) {
+  Golden_Options options;
+  if (!parse_golden_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+
+  const char *directory =
+      options.is_updating ? options.golden_directory : options.diff_directory;
+  SDL_CreateDirectory(directory);
+
+  size_t failed_count  = 0;
+  double start_seconds = SDL_GetTicksNS() / 1e9;
+  for (size_t i = 0; i < ARRAY_LENGTH(GOLDEN_LEVELS); i++) {
+    for (size_t j = 0; j < ARRAY_LENGTH(GOLDEN_RESOLUTIONS); j++) {
+      failed_count += run_golden_level(&options, &GOLDEN_LEVELS[i],
+                                       GOLDEN_RESOLUTIONS[j]);
+    }
+  }
+  double seconds = SDL_GetTicksNS() / 1e9 - start_seconds;
+
+  size_t frame_count = ARRAY_LENGTH(GOLDEN_LEVELS) *
+                       ARRAY_LENGTH(GOLDEN_RESOLUTIONS) *
+                       ARRAY_LENGTH(GOLDEN_POSE_ANGLES) *
+                       get_path_frame_count(options.is_updating);
+  if (options.is_updating) {
+    printf("Wrote %zu goldens to %s in %.3f s\n", frame_count - failed_count,
+           options.golden_directory, seconds);
+  } else {
+    printf("%zu of %zu frames failed in %.3f s", failed_count, frame_count,
+           seconds);
+    if (failed_count > 0) {
+      printf(", diffs are in %s", options.diff_directory);
+    }
+    printf("\n");
+  }
+
+  SDL_Quit();
+  return failed_count == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static bool is_reference_path(const Golden_Render_Path *render_path) {
+  return strcmp(render_path->name, render_path->golden_name) == 0;
+}
+
+// Frames per pose, every path when checking and only references when updating
+static size_t get_path_frame_count(bool is_updating) {
+  size_t frame_count = 0;
+  for (size_t i = 0; i < ARRAY_LENGTH(GOLDEN_RENDER_PATHS); i++) {
+    frame_count += !is_updating || is_reference_path(&GOLDEN_RENDER_PATHS[i]);
+  }
+  return frame_count;
+}
+
+// Returns how many frames failed, or could not be rendered or written
+static size_t run_golden_level(const Golden_Options *options,
+                               const Golden_Level   *level,
+                               Golden_Resolution     resolution) {
+  Engine_Config config   = options->engine_config;
+  config.level_directory = level->directory;
+  config.wall_file_name  = level->wall_file_name;
+  config.floor_file_name = level->floor_file_name;
+  config.view_w          = resolution.w;
+  config.view_h          = resolution.h;
+
+  Golden_Scene scene;
+  size_t       frame_size  = (size_t)resolution.w * resolution.h * 4;
+  uint8_t     *diff_pixels = malloc(frame_size);
+  IPoint_2D    spawn_cell;
+  if (!create_golden_scene(&config, &scene) || !diff_pixels ||
+      !find_procgen_spawn(scene.engine->tile_map, &spawn_cell)) {
+    fprintf(stderr, "Could not set up level %s at %dx%d\n", level->name,
+            resolution.w, resolution.h);
+    free(diff_pixels);
+    free_golden_scene(&scene);
+    return ARRAY_LENGTH(GOLDEN_POSE_ANGLES) *
+           get_path_frame_count(options->is_updating);
+  }
+
+  size_t failed_count = 0;
+  for (size_t i = 0; i < ARRAY_LENGTH(GOLDEN_POSE_ANGLES); i++) {
+    set_engine_camera(
+        scene.engine, (Camera){
+                          .position =
+                              {
+                                  .x = (spawn_cell.x + 0.5f) * GRID_CELL_SIZE,
+                                  .y = (spawn_cell.y + 0.5f) * GRID_CELL_SIZE,
+                              },
+                          .angle = GOLDEN_POSE_ANGLES[i],
+                      });
+
+    char frame_name[MAX_PATH_LENGTH];
+    snprintf(frame_name, sizeof(frame_name), "level-%s-%dx%d-pose-%zu.png",
+             level->name, resolution.w, resolution.h, i);
+    for (size_t j = 0; j < ARRAY_LENGTH(GOLDEN_RENDER_PATHS); j++) {
+      const Golden_Render_Path *render_path = &GOLDEN_RENDER_PATHS[j];
+      if (options->is_updating && !is_reference_path(render_path)) {
+        continue;
+      }
+
+      char golden_path[MAX_PATH_LENGTH];
+      snprintf(golden_path, sizeof(golden_path), "%s/%s-%s",
+               options->golden_directory, render_path->golden_name,
+               frame_name);
+      Engine_Framebuffer framebuffer =
+          render_golden_frame(&scene, render_path);
+      if (!framebuffer.pixels) {
+        fprintf(stderr, "Could not render %s %s\n", render_path->name,
+                frame_name);
+        failed_count++;
+        continue;
+      }
+      if (options->is_updating) {
+        failed_count += !write_framebuffer_png(&framebuffer, golden_path);
+        continue;
+      }
+
+      SDL_Surface *golden =
+          read_golden_image(golden_path, resolution.w, resolution.h);
+      if (!golden) {
+        failed_count++;
+        continue;
+      }
+      Engine_Framebuffer reference = {
+          .pixels = golden->pixels,
+          .w      = golden->w,
+          .h      = golden->h,
+          .pitch  = golden->pitch,
+      };
+      Frame_Comparison comparison = compare_framebuffers(
+          &framebuffer, &reference, render_path->channel_tolerance,
+          render_path->match_radius, diff_pixels);
+      SDL_DestroySurface(golden);
+
+      size_t max_failed_count = (size_t)(render_path->max_failed_fraction *
+                                         resolution.w * resolution.h);
+      bool   is_failed = comparison.failed_pixel_count > max_failed_count;
+      printf("%-8s %-38s %s, %zu pixels over, max channel difference %d\n",
+             render_path->name, frame_name, is_failed ? "FAIL" : "ok",
+             comparison.failed_pixel_count, comparison.max_channel_difference);
+      if (!is_failed) {
+        continue;
+      }
+
+      failed_count++;
+      char diff_path[MAX_PATH_LENGTH];
+      snprintf(diff_path, sizeof(diff_path), "%s/%s-%s",
+               options->diff_directory, render_path->name, frame_name);
+      Engine_Framebuffer diff = {
+          .pixels = diff_pixels,
+          .w      = resolution.w,
+          .h      = resolution.h,
+          .pitch  = resolution.w * 4,
+      };
+      write_framebuffer_png(&diff, diff_path);
+    }
+  }
+
+  free(diff_pixels);
+  free_golden_scene(&scene);
+  return failed_count;
+}
+
+/*
+ * The engine, its framebuffer and the strip view's software renderer. The
+ * surface is the strips' render target, so nothing needs a window.
+ */
+static bool create_golden_scene(const Engine_Config *config,
+                                Golden_Scene        *out_scene) {
+  int w      = config->view_w;
+  int h      = config->view_h;
+  *out_scene = (Golden_Scene){
+      .engine      = create_engine(config),
+      .framebuffer = {.w = w, .h = h, .pitch = w * (int)sizeof(uint32_t)},
+  };
+  out_scene->framebuffer.pixels =
+      malloc((size_t)out_scene->framebuffer.pitch * h);
+  out_scene->strip_surface = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGBA32);
+  if (out_scene->strip_surface) {
+    out_scene->strip_renderer =
+        SDL_CreateSoftwareRenderer(out_scene->strip_surface);
+  }
+  if (!out_scene->engine || !out_scene->framebuffer.pixels ||
+      !out_scene->strip_renderer ||
+      !create_world_object_textures(
+          out_scene->strip_renderer,
+          out_scene->engine->world_objects_container)) {
+    return false;
+  }
+  out_scene->strip_view =
+      create_strip_view(out_scene->strip_renderer,
+                        (SDL_FRect){.x = 0, .y = 0, .w = w, .h = h},
+                        PLAYER_RAY_COUNT);
+  return out_scene->strip_view != NULL;
+}
+
+// The frame a path draws at the engine's camera, pixels are NULL on failure
+static Engine_Framebuffer render_golden_frame(
+    Golden_Scene *scene, const Golden_Render_Path *render_path) {
+  Engine_Context *engine = scene->engine;
+  if (render_path->renderer != GOLDEN_RENDERER_STRIPS) {
+    engine->indexed_renderer->use_fixed_point =
+        render_path->renderer == GOLDEN_RENDERER_FIXED;
+    return render_engine_frame(engine, &scene->framebuffer)
+               ? scene->framebuffer
+               : (Engine_Framebuffer){0};
+  }
+
+  // Cleared to the fog like the front end's window, then drawn to the surface
+  SDL_Renderer *renderer = scene->strip_renderer;
+  SDL_Surface  *surface  = scene->strip_surface;
+  SDL_SetRenderDrawColor(renderer, FOG_COLOR_R, FOG_COLOR_G, FOG_COLOR_B, 255);
+  SDL_RenderClear(renderer);
+  render_strip_view(scene->strip_view, &engine->render_scene,
+                    get_engine_camera(engine));
+  if (!SDL_FlushRenderer(renderer)) {
+    return (Engine_Framebuffer){0};
+  }
+  return (Engine_Framebuffer){
+      .pixels = surface->pixels,
+      .w      = surface->w,
+      .h      = surface->h,
+      .pitch  = surface->pitch,
+  };
+}
+
+// Textures belong to the strip renderer, so the engine goes before it
+static void free_golden_scene(Golden_Scene *scene) {
+  free_strip_view(scene->strip_view);
+  free_engine(scene->engine);
+  if (scene->strip_renderer) {
+    SDL_DestroyRenderer(scene->strip_renderer);
+  }
+  if (scene->strip_surface) {
+    SDL_DestroySurface(scene->strip_surface);
+  }
+  free(scene->framebuffer.pixels);
+  *scene = (Golden_Scene){0};
+}
+
+// The golden as RGBA32, so it compares byte for byte with a framebuffer
+static SDL_Surface *read_golden_image(const char *path, int w, int h) {
+  SDL_Surface *image = IMG_Load(path);
+  if (!image) {
+    fprintf(stderr, "Missing golden %s, run make golden-update: %s\n", path,
+            SDL_GetError());
+    return NULL;
+  }
+  SDL_Surface *golden = SDL_ConvertSurface(image, SDL_PIXELFORMAT_RGBA32);
+  SDL_DestroySurface(image);
+  if (!golden || golden->w != w || golden->h != h) {
+    fprintf(stderr, "Golden %s is not a %dx%d image\n", path, w, h);
+    if (golden) {
+      SDL_DestroySurface(golden);
+    }
+    return NULL;
+  }
+  return golden;
+}
+
+static bool write_framebuffer_png(const Engine_Framebuffer *framebuffer,
+                                  const char               *path) {
+  SDL_Surface *surface = SDL_CreateSurfaceFrom(
+      framebuffer->w, framebuffer->h, SDL_PIXELFORMAT_RGBA32,
+      framebuffer->pixels, framebuffer->pitch);
+  bool is_ok = surface && IMG_SavePNG(surface, path);
+  if (!is_ok) {
+    fprintf(stderr, "Failed to write %s: %s\n", path, SDL_GetError());
+  }
+  if (surface) {
+    SDL_DestroySurface(surface);
+  }
+  return is_ok;
+}
+
+static bool parse_golden_options(int argc, char **argv,
+                                 Golden_Options *out_options) {
+  *out_options = (Golden_Options){
+      .engine_config    = get_default_engine_config(),
+      .golden_directory = GOLDEN_DIRECTORY_DEFAULT,
+      .diff_directory   = GOLDEN_DIFF_DIRECTORY_DEFAULT,
+  };
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--update") == 0) {
+      out_options->is_updating = true;
+      continue;
+    }
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return false;
+    }
+    if (strcmp(argv[i], "--goldens") == 0) {
+      out_options->golden_directory = value;
+    } else if (strcmp(argv[i], "--diffs") == 0) {
+      out_options->diff_directory = value;
+    } else if (strcmp(argv[i], "--manifest") == 0) {
+      out_options->engine_config.manifest_path = value;
+    } else {
+      fprintf(stderr,
+              "Usage: %s [--update] [--goldens dir] [--diffs dir] "
+              "[--manifest file]\n",
+              argv[0]);
+      return false;
+    }
+    i++;
+  }
+  return true;
+}
@@ -0,0 +1,238 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <SDL3/SDL.h>
+
+#include "../engine/engine.h"
+#include "../engine/input-log.h"
+#include "./constants.h"
+#include "./frame-compare.h"
+
+/*
+ * Re-runs a log recorded with ./main --record through a headless engine as
+ * fast as it will go. Every tick's state hash is checked against the one
+ * recorded live. With --frames each tick is also rendered and its frame
+ * hashed, so --verify can hold a later build to hashes an earlier one wrote on
+ * the same render path:
+ *
+ *   ./tools/replay --log session.ilog --frames --hashes reference.txt
+ *   ./tools/replay --log session.ilog --frames --verify reference.txt
+ *
+ * Hash files hold one "tick state_hash frame_hash" line per tick, frame_hash
+ * is 0 without --frames. The float and fixed paths round texels apart and
+ * never hash alike, so --compare renders every tick on both and holds the
+ * fixed frame to the float one within the fixed path's golden tolerances:
+ *
+ *   ./tools/replay --log session.ilog --compare
+ */
+
+typedef struct Replay_Options {
+  Engine_Config engine_config;
+  const char   *log_path;
+  const char   *hashes_path;
+  const char   *verify_path;
+  bool          is_rendering;
+  bool          is_comparing; // renders the other path too, implies rendering
+} Replay_Options;
+
+static bool parse_replay_options(int argc, char **argv,
+                                 Replay_Options *out_options);
+
+int main(int argc, char **argv) {
+  Replay_Options options;
+  if (!parse_replay_options(argc, argv, &options)) {
+    return EXIT_FAILURE;
+  }
+
+  Input_Log *input_log = read_input_log_file(options.log_path);
+  if (!input_log) {
+    return EXIT_FAILURE;
+  }
+  options.engine_config.level_directory = input_log->level_directory;
+
+  Engine_Context    *engine      = create_engine(&options.engine_config);
+  Engine_Framebuffer framebuffer = {
+      .w     = options.engine_config.view_w,
+      .h     = options.engine_config.view_h,
+      .pitch = options.engine_config.view_w * (int)sizeof(uint32_t),
+  };
+  Engine_Framebuffer other_framebuffer = framebuffer;
+  size_t             frame_size = (size_t)framebuffer.pitch * framebuffer.h;
+  if (options.is_rendering) {
+    framebuffer.pixels = malloc(frame_size);
+  }
+  if (options.is_comparing) {
+    other_framebuffer.pixels = malloc(frame_size);
+  }
+  FILE *hashes_file =
+      options.hashes_path ? fopen(options.hashes_path, "w") : NULL;
+  FILE *verify_file =
+      options.verify_path ? fopen(options.verify_path, "r") : NULL;
+  bool is_ok = engine && (!options.is_rendering || framebuffer.pixels) &&
+               (!options.is_comparing || other_framebuffer.pixels) &&
+               (!options.hashes_path || hashes_file) &&
+               (!options.verify_path || verify_file);
+  if (!is_ok) {
+    fprintf(stderr, "Could not set up the replay\n");
+  }
+
+  size_t state_mismatch_count  = 0;
+  size_t verify_mismatch_count = 0;
+  size_t path_mismatch_count   = 0;
+  size_t first_mismatch_tick   = SIZE_MAX;
+  size_t max_failed_count      = 0;
+  size_t max_path_failed_count =
+      (size_t)(FIXED_PATH_MAX_FAILED_FRACTION * framebuffer.w * framebuffer.h);
+  double render_seconds        = 0;
+  double start_seconds         = SDL_GetTicksNS() / 1e9;
+  for (size_t i = 0; is_ok && i < input_log->length; i++) {
+    const Input_Log_Tick *tick = &input_log->ticks[i];
+    step_engine(engine, tick->input, tick->delta_time);
+    uint64_t state_hash = hash_engine_state(engine);
+    if (state_hash != tick->state_hash) {
+      state_mismatch_count++;
+      first_mismatch_tick =
+          i < first_mismatch_tick ? i : first_mismatch_tick;
+    }
+
+    uint64_t frame_hash = 0;
+    if (options.is_rendering) {
+      double render_start = SDL_GetTicksNS() / 1e9;
+      render_engine_frame(engine, &framebuffer);
+      render_seconds += SDL_GetTicksNS() / 1e9 - render_start;
+      frame_hash = hash_engine_framebuffer(&framebuffer);
+    }
+
+    if (options.is_comparing) {
+      bool use_fixed_point = engine->indexed_renderer->use_fixed_point;
+      engine->indexed_renderer->use_fixed_point = !use_fixed_point;
+      render_engine_frame(engine, &other_framebuffer);
+      engine->indexed_renderer->use_fixed_point = use_fixed_point;
+
+      Frame_Comparison comparison = compare_framebuffers(
+          use_fixed_point ? &framebuffer : &other_framebuffer,
+          use_fixed_point ? &other_framebuffer : &framebuffer,
+          FIXED_PATH_CHANNEL_TOLERANCE, FIXED_PATH_MATCH_RADIUS, NULL);
+      if (comparison.failed_pixel_count > max_failed_count) {
+        max_failed_count = comparison.failed_pixel_count;
+      }
+      if (comparison.failed_pixel_count > max_path_failed_count) {
+        path_mismatch_count++;
+        first_mismatch_tick =
+            i < first_mismatch_tick ? i : first_mismatch_tick;
+      }
+    }
+
+    if (hashes_file) {
+      fprintf(hashes_file, "%zu %016" PRIx64 " %016" PRIx64 "\n", i,
+              state_hash, frame_hash);
+    }
+    size_t   expected_tick;
+    uint64_t expected_state_hash, expected_frame_hash;
+    if (verify_file &&
+        (fscanf(verify_file, "%zu %" SCNx64 " %" SCNx64, &expected_tick,
+                &expected_state_hash, &expected_frame_hash) != 3 ||
+         expected_tick != i || expected_state_hash != state_hash ||
+         expected_frame_hash != frame_hash)) {
+      verify_mismatch_count++;
+      first_mismatch_tick =
+          i < first_mismatch_tick ? i : first_mismatch_tick;
+    }
+  }
+  double seconds = SDL_GetTicksNS() / 1e9 - start_seconds;
+
+  if (is_ok) {
+    printf("%zu ticks in %.3f s, %.0f ticks/s", input_log->length, seconds,
+           seconds > 0 ? input_log->length / seconds : 0);
+    if (options.is_rendering && input_log->length > 0) {
+      printf(", %.3f ms per frame", render_seconds * 1000 / input_log->length);
+    }
+    printf("\n%zu state mismatches against the log", state_mismatch_count);
+    if (verify_file) {
+      printf(", %zu against %s", verify_mismatch_count, options.verify_path);
+    }
+    if (options.is_comparing) {
+      printf(", %zu fixed frames over tolerance, worst %zu of %d pixels",
+             path_mismatch_count, max_failed_count,
+             framebuffer.w * framebuffer.h);
+    }
+    if (first_mismatch_tick != SIZE_MAX) {
+      printf(", first at tick %zu", first_mismatch_tick);
+    }
+    printf("\n");
+  }
+
+  if (verify_file) {
+    fclose(verify_file);
+  }
+  if (hashes_file && fclose(hashes_file) != 0) {
+    is_ok = false;
+  }
+  free(framebuffer.pixels);
+  free(other_framebuffer.pixels);
+  free_engine(engine);
+  free_input_log(input_log);
+  SDL_Quit();
+  return is_ok && state_mismatch_count == 0 && verify_mismatch_count == 0 &&
+                 path_mismatch_count == 0
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
+
+static bool parse_replay_options(int argc, char **argv,
+                                 Replay_Options *out_options) {
+  *out_options = (Replay_Options){
+      .engine_config = get_default_engine_config(),
+  };
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--frames") == 0) {
+      out_options->is_rendering = true;
+      continue;
+    }
+    if (strcmp(argv[i], "--compare") == 0) {
+      out_options->is_rendering = true;
+      out_options->is_comparing = true;
+      continue;
+    }
+    if (strcmp(argv[i], "--fixed") == 0) {
+      out_options->engine_config.use_fixed_point = true;
+      continue;
+    }
+    const char *value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (!value) {
+      fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return false;
+    }
+    if (strcmp(argv[i], "--log") == 0) {
+      out_options->log_path = value;
+    } else if (strcmp(argv[i], "--hashes") == 0) {
+      out_options->hashes_path = value;
+    } else if (strcmp(argv[i], "--verify") == 0) {
+      out_options->verify_path = value;
+    } else if (strcmp(argv[i], "--width") == 0) {
+      out_options->engine_config.view_w = atoi(value);
+    } else if (strcmp(argv[i], "--height") == 0) {
+      out_options->engine_config.view_h = atoi(value);
+    } else if (strcmp(argv[i], "--manifest") == 0) {
+      out_options->engine_config.manifest_path = value;
+    } else {
+      fprintf(stderr,
+              "Usage: %s --log file [--frames] [--fixed] [--compare] "
+              "[--hashes file] [--verify file] [--width n] [--height n] "
+              "[--manifest file]\n",
+              argv[0]);
+      return false;
+    }
+    i++;
+  }
+
+  if (!out_options->log_path) {
+    fprintf(stderr, "An input log is required, see --log\n");
+    return false;
+  }
+  return out_options->engine_config.view_w > 0 &&
+         out_options->engine_config.view_h > 0;
+}
@@ -0,0 +1,116 @@
+#ifndef TOOLS_TYPES_H
+#define TOOLS_TYPES_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <SDL3/SDL.h>
+
+#include "../engine/types.h"
+#include "../render/types.h"
+
+// The camera frame_count frames before it heads for the next keyframe
+typedef struct Camera_Keyframe {
+  Camera camera;
+  size_t frame_count;
+} Camera_Keyframe;
+
+typedef struct Camera_Path {
+  Camera_Keyframe *keyframes;
+  size_t           length;
+  size_t           frame_count; // every keyframe's frames, summed
+} Camera_Path;
+
+typedef enum Frame_Format {
+  FRAME_FORMAT_PNG, // one numbered file per frame
+  FRAME_FORMAT_Y4M, // one raw 4:2:0 stream
+} Frame_Format;
+
+typedef struct Frame_Slot {
+  size_t             frame_index;
+  Engine_Framebuffer framebuffer;
+  bool               is_rendered;
+} Frame_Slot;
+
+/*
+ * Ring of preallocated frames between the renderer and the writer. Slots are
+ * acquired, submitted, taken and released strictly in order, so frames reach
+ * the writer in the order they were acquired whatever order they render in.
+ * Counters only grow and are guarded by the mutex.
+ */
+typedef struct Frame_Queue {
+  Frame_Slot    *slots;
+  size_t         capacity;
+  size_t         acquired_count;
+  size_t         submitted_count;
+  size_t         taken_count;
+  size_t         released_count;
+  bool           is_closed;
+  SDL_Mutex     *mutex;
+  SDL_Condition *slot_free;
+  SDL_Condition *slot_ready;
+} Frame_Queue;
+
+typedef struct Frame_Writer {
+  SDL_Thread  *thread;
+  Frame_Queue *queue;
+  Frame_Format format;
+  const char  *out_path; // directory for PNG, file for Y4M
+  int          fps;
+  FILE        *y4m_file;
+  uint8_t     *yuv_planes; // Y then U then V, one frame
+  size_t       written_count;
+  bool         is_ok;
+} Frame_Writer;
+
+typedef struct Frame_Comparison {
+  size_t failed_pixel_count;
+  int    max_channel_difference;
+} Frame_Comparison;
+
+// Levels predate the w.csv and f.csv names, so each names its own grids
+typedef struct Golden_Level {
+  const char *name;
+  const char *directory;
+  const char *wall_file_name;
+  const char *floor_file_name;
+} Golden_Level;
+
+typedef enum Golden_Renderer {
+  GOLDEN_RENDERER_INDEXED, // render_engine_frame, float traversal
+  GOLDEN_RENDERER_FIXED,   // render_engine_frame, 16.16 traversal
+  GOLDEN_RENDERER_STRIPS,  // the SDL front end's strip view, software renderer
+} Golden_Renderer;
+
+/*
+ * A pixel passes when a golden pixel within match_radius is no further than
+ * channel_tolerance on any channel, a frame fails when more than
+ * max_failed_fraction of its pixels do not. Paths are held to golden_name's
+ * goldens, and a path whose golden_name is its own name writes them.
+ */
+typedef struct Golden_Render_Path {
+  const char     *name;
+  const char     *golden_name;
+  Golden_Renderer renderer;
+  int             channel_tolerance;
+  int             match_radius;
+  double          max_failed_fraction;
+} Golden_Render_Path;
+
+typedef struct Golden_Resolution {
+  int w;
+  int h;
+} Golden_Resolution;
+
+// One level at one resolution, with a software SDL_Renderer for the strips
+typedef struct Golden_Scene {
+  Engine_Context    *engine;
+  Engine_Framebuffer framebuffer;
+  SDL_Surface       *strip_surface;
+  SDL_Renderer      *strip_renderer;
+  Strip_View        *strip_view;
+} Golden_Scene;
+
+#endif
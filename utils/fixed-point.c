@@ -0,0 +1,67 @@
+#include "fixed-point.h"
+
+#define TRIG_SHIFT 30
+#define TRIG_HALF_PI 1686629713LL // pi / 2 in 2.30
+
+Fixed fixed_sin_lut[FIXED_ANGLE_STEPS];
+
+static SDL_InitState fixed_trig_lut_init_state;
+
+static void fill_fixed_trig_lut(void);
+static int64_t trig_mul(int64_t a, int64_t b);
+
+/*
+ * Safe to call from every engine on any thread: the table is filled by the
+ * first caller only, the others wait for it and return.
+ */
+extern void init_fixed_trig_lut(void)
+{
+  if (!SDL_ShouldInit(&fixed_trig_lut_init_state))
+  {
+    return;
+  }
+  fill_fixed_trig_lut();
+  SDL_SetInitialized(&fixed_trig_lut_init_state, true);
+}
+
+/*
+ * Fills the sine table from a Taylor series evaluated in 2.30 integers
+ * rather than libm, whose last bits differ between platforms. Accurate to
+ * the last 16.16 bit over the first quadrant, mirrored for the rest.
+ */
+static void fill_fixed_trig_lut(void)
+{
+  int quarter = FIXED_ANGLE_STEPS / 4;
+
+  for (int i = 0; i <= quarter; i++)
+  {
+    int64_t x = TRIG_HALF_PI * i / quarter;
+    int64_t x_squared = trig_mul(x, x);
+    int64_t term = x;
+    int64_t sum = x;
+    // term(n) = -term(n - 1) * x^2 / ((2n)(2n + 1)), up to x^11 / 11!
+    for (int n = 1; n <= 5; n++)
+    {
+      term = -trig_mul(term, x_squared) / ((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    Fixed value = (Fixed)((sum + (1 << (TRIG_SHIFT - FIXED_SHIFT - 1))) >>
+                          (TRIG_SHIFT - FIXED_SHIFT));
+
+    fixed_sin_lut[i] = value;
+    fixed_sin_lut[(2 * quarter - i) & FIXED_ANGLE_MASK] = value;
+    fixed_sin_lut[(2 * quarter + i) & FIXED_ANGLE_MASK] = -value;
+    fixed_sin_lut[(4 * quarter - i) & FIXED_ANGLE_MASK] = -value;
+  }
+}
+
+extern Fixed_Angle convert_deg_to_fixed_angle(Degrees degrees)
+{
+  return (Fixed_Angle)floor(degrees * FIXED_ANGLE_STEPS / 360.0) &
+         FIXED_ANGLE_MASK;
+}
+
+static int64_t trig_mul(int64_t a, int64_t b)
+{
+  return (a * b) >> TRIG_SHIFT;
+}
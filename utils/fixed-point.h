@@ -0,0 +1,47 @@
+#ifndef FIXED_POINT_H
+#define FIXED_POINT_H
+
+#include <stdint.h>
+
+#include <SDL3/SDL.h>
+
+#include "./math-utils.h"
+
+/*
+ * 16.16 fixed point and binary angles. Everything here is integer math (or
+ * exact float scaling), so results are identical on every compiler/target.
+ */
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+#define FIXED_ANGLE_STEPS 16384 // per full turn
+#define FIXED_ANGLE_MASK (FIXED_ANGLE_STEPS - 1)
+
+typedef int32_t Fixed;
+typedef int32_t Fixed_Angle;
+
+extern Fixed fixed_sin_lut[FIXED_ANGLE_STEPS];
+
+extern void init_fixed_trig_lut(void);
+extern Fixed_Angle convert_deg_to_fixed_angle(Degrees degrees);
+
+static inline Fixed fixed_mul(Fixed a, Fixed b)
+{
+  return (Fixed)(((int64_t)a * b) >> FIXED_SHIFT);
+}
+
+static inline Fixed fixed_div(Fixed a, Fixed b)
+{
+  return (Fixed)(((int64_t)a << FIXED_SHIFT) / b);
+}
+
+static inline Fixed fixed_sin(Fixed_Angle angle)
+{
+  return fixed_sin_lut[angle & FIXED_ANGLE_MASK];
+}
+
+static inline Fixed fixed_cos(Fixed_Angle angle)
+{
+  return fixed_sin_lut[(angle + FIXED_ANGLE_STEPS / 4) & FIXED_ANGLE_MASK];
+}
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef FNV_HASH_H
+#define FNV_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * 64 bit FNV-1a, for cheap fingerprints of state and frames, not for security.
+ * Start from FNV_OFFSET_BASIS and feed buffers in a fixed order.
+ */
+#define FNV_OFFSET_BASIS 0xcbf29ce484222325ull
+#define FNV_PRIME 0x100000001b3ull
+
+static inline uint64_t hash_fnv1a(uint64_t hash, const void *data,
+                                  size_t length)
+{
+  const uint8_t *bytes = data;
+  for (size_t i = 0; i < length; i++)
+  {
+    hash ^= bytes[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+#endif
@@ -0,0 +1,65 @@
+#include "radix-sort.h"
+
+#define RADIX_BITS 8
+#define RADIX_BUCKETS (1 << RADIX_BITS)
+#define RADIX_PASSES (32 / RADIX_BITS)
+
+/*
+ * Maps a float to a uint32_t with the same ordering, so floats can be radix
+ * sorted as integers. Negative values have all bits flipped, positive values
+ * only the sign bit.
+ */
+extern uint32_t convert_float_to_sort_key(float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+/*
+ * Stable ascending LSD radix sort of keys, carrying values along.
+ * The tmp arrays must hold length elements. Results end up in keys/values.
+ */
+extern void radix_sort_by_key(uint32_t *keys, uint32_t *values,
+                              uint32_t *tmp_keys, uint32_t *tmp_values,
+                              size_t length)
+{
+  uint32_t *src_keys = keys;
+  uint32_t *src_values = values;
+  uint32_t *dst_keys = tmp_keys;
+  uint32_t *dst_values = tmp_values;
+
+  for (int pass = 0; pass < RADIX_PASSES; pass++)
+  {
+    int shift = pass * RADIX_BITS;
+    size_t offsets[RADIX_BUCKETS] = {0};
+
+    for (size_t i = 0; i < length; i++)
+    {
+      offsets[(src_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+    }
+
+    size_t total = 0;
+    for (int bucket = 0; bucket < RADIX_BUCKETS; bucket++)
+    {
+      size_t count = offsets[bucket];
+      offsets[bucket] = total;
+      total += count;
+    }
+
+    for (size_t i = 0; i < length; i++)
+    {
+      size_t index = offsets[(src_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+      dst_keys[index] = src_keys[i];
+      dst_values[index] = src_values[i];
+    }
+
+    uint32_t *swap_keys = src_keys;
+    uint32_t *swap_values = src_values;
+    src_keys = dst_keys;
+    src_values = dst_values;
+    dst_keys = swap_keys;
+    dst_values = swap_values;
+  }
+  // An even number of passes leaves the sorted data back in keys/values
+}
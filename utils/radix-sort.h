@@ -0,0 +1,11 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+extern uint32_t convert_float_to_sort_key(float value);
+extern void radix_sort_by_key(uint32_t *keys, uint32_t *values, uint32_t *tmp_keys, uint32_t *tmp_values, size_t length);
+
+#endif
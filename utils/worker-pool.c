@@ -0,0 +1,168 @@
+#include "worker-pool.h"
+
+static int SDLCALL run_worker_thread(void *data);
+static void run_worker_jobs(Worker_Pool *pool, Worker_Job job, void *context,
+                            size_t job_count);
+
+extern Worker_Pool *create_worker_pool(size_t thread_count)
+{
+  Worker_Pool *pool = calloc(1, sizeof(Worker_Pool));
+  if (!pool)
+  {
+    return NULL;
+  }
+  pool->mutex = SDL_CreateMutex();
+  pool->work_ready = SDL_CreateCondition();
+  pool->work_done = SDL_CreateCondition();
+  pool->threads = calloc(thread_count ? thread_count : 1, sizeof(SDL_Thread *));
+  if (!pool->mutex || !pool->work_ready || !pool->work_done || !pool->threads)
+  {
+    free_worker_pool(pool);
+    return NULL;
+  }
+
+  for (size_t i = 0; i < thread_count; i++)
+  {
+    pool->threads[i] = SDL_CreateThread(run_worker_thread, "worker", pool);
+    if (!pool->threads[i])
+    {
+      fprintf(stderr, "Failed to create worker thread: %s\n", SDL_GetError());
+      break;
+    }
+    pool->thread_count++;
+  }
+  return pool;
+}
+
+// One thread per logical core, less the caller which also runs jobs
+extern size_t get_default_worker_count(void)
+{
+  int core_count = SDL_GetNumLogicalCPUCores();
+  return core_count > 1 ? (size_t)core_count - 1 : 0;
+}
+
+/*
+ * Runs job(context, i) for every i below job_count across the pool and the
+ * calling thread, and returns once all of them have finished. Indexes are
+ * handed out one at a time, so uneven jobs still balance. job_count must fit
+ * in an int, the index counter is an SDL_AtomicInt.
+ */
+extern void run_worker_pool(Worker_Pool *pool, Worker_Job job, void *context,
+                            size_t job_count)
+{
+  if (job_count == 0)
+  {
+    return;
+  }
+  if (!pool || pool->thread_count == 0 || job_count == 1)
+  {
+    for (size_t i = 0; i < job_count; i++)
+    {
+      job(context, i);
+    }
+    return;
+  }
+
+  SDL_LockMutex(pool->mutex);
+  pool->job = job;
+  pool->context = context;
+  pool->job_count = job_count;
+  SDL_SetAtomicInt(&pool->next_job, 0);
+  pool->busy_threads = pool->thread_count;
+  pool->batch++;
+  SDL_BroadcastCondition(pool->work_ready);
+  SDL_UnlockMutex(pool->mutex);
+
+  run_worker_jobs(pool, job, context, job_count);
+
+  SDL_LockMutex(pool->mutex);
+  while (pool->busy_threads > 0)
+  {
+    SDL_WaitCondition(pool->work_done, pool->mutex);
+  }
+  SDL_UnlockMutex(pool->mutex);
+}
+
+extern void free_worker_pool(Worker_Pool *pool)
+{
+  if (!pool)
+  {
+    return;
+  }
+  if (pool->mutex)
+  {
+    SDL_LockMutex(pool->mutex);
+    pool->is_stopping = true;
+    if (pool->work_ready)
+    {
+      SDL_BroadcastCondition(pool->work_ready);
+    }
+    SDL_UnlockMutex(pool->mutex);
+  }
+  for (size_t i = 0; i < pool->thread_count; i++)
+  {
+    SDL_WaitThread(pool->threads[i], NULL);
+  }
+  if (pool->work_done)
+  {
+    SDL_DestroyCondition(pool->work_done);
+  }
+  if (pool->work_ready)
+  {
+    SDL_DestroyCondition(pool->work_ready);
+  }
+  if (pool->mutex)
+  {
+    SDL_DestroyMutex(pool->mutex);
+  }
+  free(pool->threads);
+  free(pool);
+}
+
+static int SDLCALL run_worker_thread(void *data)
+{
+  Worker_Pool *pool = data;
+  uint64_t seen_batch = 0;
+
+  SDL_LockMutex(pool->mutex);
+  while (true)
+  {
+    while (!pool->is_stopping && pool->batch == seen_batch)
+    {
+      SDL_WaitCondition(pool->work_ready, pool->mutex);
+    }
+    if (pool->is_stopping)
+    {
+      break;
+    }
+    seen_batch = pool->batch;
+    Worker_Job job = pool->job;
+    void *context = pool->context;
+    size_t job_count = pool->job_count;
+    SDL_UnlockMutex(pool->mutex);
+
+    run_worker_jobs(pool, job, context, job_count);
+
+    SDL_LockMutex(pool->mutex);
+    if (--pool->busy_threads == 0)
+    {
+      SDL_SignalCondition(pool->work_done);
+    }
+  }
+  SDL_UnlockMutex(pool->mutex);
+  return 0;
+}
+
+static void run_worker_jobs(Worker_Pool *pool, Worker_Job job, void *context,
+                            size_t job_count)
+{
+  while (true)
+  {
+    size_t index = (size_t)SDL_AddAtomicInt(&pool->next_job, 1);
+    if (index >= job_count)
+    {
+      return;
+    }
+    job(context, index);
+  }
+}
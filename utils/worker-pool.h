@@ -0,0 +1,39 @@
+#ifndef WORKER_POOL_H
+#define WORKER_POOL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <SDL3/SDL.h>
+
+// Called once per index, from any thread, in no particular order
+typedef void (*Worker_Job)(void *context, size_t index);
+
+/*
+ * Fixed set of SDL threads that run batches of indexed jobs. The calling
+ * thread works on the batch too, so a pool with no threads runs it inline.
+ */
+typedef struct Worker_Pool {
+  SDL_Thread   **threads;
+  size_t         thread_count;
+  SDL_Mutex     *mutex;
+  SDL_Condition *work_ready;
+  SDL_Condition *work_done;
+  Worker_Job     job;
+  void          *context;
+  size_t         job_count;
+  SDL_AtomicInt  next_job;
+  size_t         busy_threads; // guarded by mutex, like everything below
+  uint64_t       batch;
+  bool           is_stopping;
+} Worker_Pool;
+
+extern Worker_Pool *create_worker_pool(size_t thread_count);
+extern size_t get_default_worker_count(void);
+extern void run_worker_pool(Worker_Pool *pool, Worker_Job job, void *context, size_t job_count);
+extern void free_worker_pool(Worker_Pool *pool);
+
+#endif